@@ -1,12 +1,16 @@
+#include <algorithm>
+#include <charconv>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <vector>
 #include <orderedgoalsplanner/types/domain.hpp>
 #include <orderedgoalsplanner/types/problem.hpp>
 #include <orderedgoalsplanner/util/serializer/deserializefrompddl.hpp>
 #include <orderedgoalsplanner/util/serializer/serializeinpddl.hpp>
 #include <orderedgoalsplanner/orderedgoalsplanner.hpp>
+#include "plannerserver.hpp"
 
 using namespace ogp;
 
@@ -34,6 +38,78 @@ void printUsage() {
   std::cout << "Usage: orderedgoalsplanner <domain_file> <problem_file> [--verbose] [-o <output_plan_file>]" << std::endl;
   std::cout << "or" << std::endl;
   std::cout << "Usage: orderedgoalsplanner --dp <directory_with_domain_pddl_and_problem_pddl_files_in_it> [--verbose] [-o <output_plan_file>]" << std::endl;
+  std::cout << "or" << std::endl;
+  std::cout << "Usage: orderedgoalsplanner --batch <directory_with_domain_pddl_and_problem_files_in_it> [--threads <max_number_of_threads>]" << std::endl;
+  std::cout << "  Plan concurrently all the other \".pddl\" files of the directory, and print the latency of each problem and the throughput." << std::endl;
+  std::cout << "or" << std::endl;
+  std::cout << "Usage: orderedgoalsplanner -d <domain_file> --serve" << std::endl;
+  std::cout << "  Answer to the frames \"<request> <payload size>\\n<payload>\" read from the standard input (requests: problem, init, goal, plan, quit)." << std::endl;
+}
+
+
+bool _parseNbOfThreads(std::size_t& pRes,
+                       const std::string& pStr)
+{
+  auto* endPtr = pStr.data() + pStr.size();
+  auto parsingRes = std::from_chars(pStr.data(), endPtr, pRes);
+  return parsingRes.ec == std::errc() && parsingRes.ptr == endPtr;
+}
+
+
+int _planBatchDirectory(const std::string& pDirectory,
+                        const std::string& pDomainFile,
+                        const std::map<std::string, ogp::Domain>& pLoadedDomains,
+                        std::size_t pMaxNbOfThreads)
+{
+  std::vector<std::filesystem::path> problemFiles;
+  for (const auto& currEntry : std::filesystem::directory_iterator(pDirectory))
+    if (currEntry.is_regular_file() && currEntry.path().extension() == ".pddl" &&
+        !std::filesystem::equivalent(currEntry.path(), pDomainFile))
+      problemFiles.emplace_back(currEntry.path());
+  std::sort(problemFiles.begin(), problemFiles.end());
+
+  // The problems are filled in place against the loaded domain, so neither the domain nor the problems are copied
+  const auto& domain = pLoadedDomains.begin()->second;
+  std::vector<ogp::Problem> problems;
+  problems.reserve(problemFiles.size());
+  for (const auto& currProblemFile : problemFiles)
+  {
+    std::ifstream problemFile(currProblemFile);
+    if (!problemFile.is_open())
+      throw std::runtime_error("Error: Could not open file " + currProblemFile.string());
+    auto& problem = problems.emplace_back(&domain.getTimelessFacts().setOfFacts());
+    ogp::pddlToProblem(problem, problemFile, domain);
+  }
+
+  ogp::PlanBatchOptions options;
+  options.maxNbOfThreads = pMaxNbOfThreads;
+  auto batchResult = ogp::planBatch(domain, problems, options);
+
+  int res = 0;
+  for (std::size_t i = 0; i < problemFiles.size(); ++i)
+  {
+    const auto& problemResult = batchResult.problemResults[i];
+    std::cout << "; Problem file: " << problemFiles[i].filename().string() << "\n";
+    std::cout << "; Latency: " << problemResult.duration.count() / 1000.0 << " ms\n";
+    if (!problemResult.errorMessage.empty())
+    {
+      std::cout << "; Error: " << problemResult.errorMessage << "\n";
+      res = 1;
+    }
+    else if (problemResult.plan.empty())
+    {
+      std::cout << "; No plan found.\n";
+      res = 1;
+    }
+    else
+    {
+      ogp::planToPddl(std::cout, problemResult.plan, domain);
+    }
+    std::cout << "\n";
+  }
+  std::cout << "; " << problems.size() << " problems planned in " << batchResult.duration.count() / 1000.0
+            << " ms: " << batchResult.throughput() << " problems/s" << std::endl;
+  return res;
 }
 
 }
@@ -45,7 +121,10 @@ int main(int argc, char* argv[])
   std::string problem_file;
   std::string domain_and_problem_directory;
   std::string output_plan_file;
+  std::string batch_directory;
+  std::size_t max_nb_of_threads = 0;
   bool verbose = false;
+  bool serve = false;
 
   for (int i = 1; i < argc; ++i) {
     std::string arg = argv[i];
@@ -58,8 +137,18 @@ int main(int argc, char* argv[])
       domain_and_problem_directory = argv[++i];
     } else if (arg == "-o" && i + 1 < argc) {
       output_plan_file = argv[++i];
+    } else if (arg == "--batch" && i + 1 < argc) {
+      batch_directory = argv[++i];
+    } else if (arg == "--threads" && i + 1 < argc) {
+      if (!_parseNbOfThreads(max_nb_of_threads, argv[++i])) {
+        std::cerr << "Error: Invalid number of threads \"" << argv[i] << "\".\n";
+        printUsage();
+        return 1;
+      }
     } else if (arg == "--verbose") {
       verbose = true;
+    } else if (arg == "--serve") {
+      serve = true;
     } else if (domain_file == "") {
       domain_file = arg;
     } else if (problem_file == "") {
@@ -74,12 +163,16 @@ int main(int argc, char* argv[])
     domain_file = domain_and_problem_directory + "/domain.pddl";
     problem_file = domain_and_problem_directory + "/problem.pddl";
   }
+  else if (!batch_directory.empty()) {
+    if (domain_file.empty())
+      domain_file = batch_directory + "/domain.pddl";
+  }
   else if (domain_file.empty()) {
     std::cerr << "Error: Missing domain file in arguments.\n";
     printUsage();
     return 1;
   }
-  else if (problem_file.empty()) {
+  else if (problem_file.empty() && !serve) {
     std::cerr << "Error: Missing problem file in arguments.\n";
     printUsage();
     return 1;
@@ -89,11 +182,20 @@ int main(int argc, char* argv[])
   std::map<std::string, ogp::Domain> loadedDomains;
   auto domain = ogp::pddlToDomain(domainContent, loadedDomains);
   loadedDomains.emplace(domain.getName(), std::move(domain));
+  if (serve)
+  {
+    ogp::servePlanner(std::cin, std::cout, loadedDomains);
+    return 0;
+  }
+  if (!batch_directory.empty())
+    return _planBatchDirectory(batch_directory, domain_file, loadedDomains, max_nb_of_threads);
   if (verbose)
     std::cout << "Parsing domain file \"" << domain_file << "\" done successfully." << std::endl;
 
-  auto problemContent = _getFileContent(problem_file);
-  ogp::DomainAndProblemPtrs domainAndProblemPtrs = ogp::pddlToProblem(problemContent, loadedDomains);
+  std::ifstream problemFile(problem_file);
+  if (!problemFile.is_open())
+    throw std::runtime_error("Error: Could not open file " + problem_file);
+  ogp::DomainAndProblemPtrs domainAndProblemPtrs = ogp::pddlToProblem(problemFile, loadedDomains);
   auto& problem = *domainAndProblemPtrs.problemPtr;
   if (verbose)
     std::cout << "Parsing problem file \"" << problem_file << "\" done successfully." << std::endl;
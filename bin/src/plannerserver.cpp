@@ -0,0 +1,172 @@
+#include "plannerserver.hpp"
+#include <cctype>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <orderedgoalsplanner/types/domain.hpp>
+#include <orderedgoalsplanner/types/fact.hpp>
+#include <orderedgoalsplanner/types/problem.hpp>
+#include <orderedgoalsplanner/types/setofcallbacks.hpp>
+#include <orderedgoalsplanner/util/serializer/deserializefrompddl.hpp>
+#include <orderedgoalsplanner/orderedgoalsplanner.hpp>
+
+namespace ogp
+{
+namespace
+{
+
+/// Read a frame. Returns false if the end of the input is reached before a new frame.
+bool _readFrame(std::istream& pInput,
+                std::string& pName,
+                std::string& pPayload)
+{
+  std::string header;
+  do
+  {
+    if (!std::getline(pInput, header))
+      return false;
+  }
+  while (header.empty());
+
+  std::istringstream headerStream(header);
+  std::size_t payloadSize = 0;
+  if (!(headerStream >> pName >> payloadSize))
+    throw std::runtime_error("Invalid frame header: \"" + header + "\"");
+  pPayload.resize(payloadSize);
+  if (payloadSize > 0 && !pInput.read(&pPayload[0], payloadSize))
+    throw std::runtime_error("The payload of the frame \"" + pName + "\" is truncated");
+  return true;
+}
+
+
+void _writeFrame(std::ostream& pOutput,
+                 const std::string& pName,
+                 const std::string& pPayload = "")
+{
+  pOutput << pName << " " << pPayload.size() << "\n" << pPayload;
+  pOutput.flush();
+}
+
+
+void _skipSpaces(const std::string& pStr,
+                 std::size_t& pPos)
+{
+  while (pPos < pStr.size() && std::isspace(static_cast<unsigned char>(pStr[pPos])))
+    ++pPos;
+}
+
+
+Problem& _getProblem(DomainAndProblemPtrs& pDomainAndProblem)
+{
+  if (!pDomainAndProblem.problemPtr)
+    throw std::runtime_error("No problem loaded, a \"problem\" request is expected first");
+  return *pDomainAndProblem.problemPtr;
+}
+
+}
+
+
+void servePlanner(std::istream& pInput,
+                  std::ostream& pOutput,
+                  const std::map<std::string, Domain>& pLoadedDomains)
+{
+  DomainAndProblemPtrs current;
+  std::string name;
+  std::string payload;
+  while (true)
+  {
+    try
+    {
+      if (!_readFrame(pInput, name, payload))
+        return;
+    }
+    catch (const std::exception& e)
+    {
+      // The next frames cannot be found anymore
+      _writeFrame(pOutput, "error", e.what());
+      return;
+    }
+
+    try
+    {
+      if (name == "quit")
+      {
+        _writeFrame(pOutput, "ok");
+        return;
+      }
+
+      if (name == "problem")
+      {
+        current = pddlToProblem(payload, pLoadedDomains);
+        _writeFrame(pOutput, "ok");
+      }
+      else if (name == "init")
+      {
+        auto& problem = _getProblem(current);
+        const auto& domain = *current.domainPtr;
+        // Parse all the facts before modifying the world state, so that an invalid request changes nothing
+        std::vector<std::pair<Fact, bool>> factsAndIfNegated;
+        std::size_t pos = 0;
+        _skipSpaces(payload, pos);
+        while (pos < payload.size() && payload[pos] != ')')
+        {
+          bool isFactNegated = false;
+          Fact fact(payload, true, domain.getOntology(), problem.entities, {}, &isFactNegated, pos, &pos);
+          factsAndIfNegated.emplace_back(std::move(fact), isFactNegated);
+          _skipSpaces(payload, pos);
+        }
+        if (pos < payload.size())
+          throw std::runtime_error("Unexpected content after the facts: \"" + payload.substr(pos) + "\"");
+
+        auto itFact = factsAndIfNegated.begin();
+        problem.worldState.modifyFacts([&](bool& pIsFactNegated) -> std::optional<Fact>
+        {
+          if (itFact == factsAndIfNegated.end())
+            return {};
+          pIsFactNegated = itFact->second;
+          return std::move((itFact++)->first);
+        }, problem.goalStack, domain.getSetOfEvents(), SetOfCallbacks(), domain.getOntology(), problem.entities, {});
+        _writeFrame(pOutput, "ok");
+      }
+      else if (name == "goal")
+      {
+        auto& problem = _getProblem(current);
+        const auto& ontology = current.domainPtr->getOntology();
+        std::vector<Goal> goals;
+        std::size_t pos = 0;
+        _skipSpaces(payload, pos);
+        while (pos < payload.size())
+        {
+          auto goalPtr = pddlToGoal(payload, pos, ontology, problem.entities);
+          if (!goalPtr)
+            throw std::runtime_error("Failed to parse a pddl goal");
+          goals.emplace_back(std::move(*goalPtr));
+          _skipSpaces(payload, pos);
+        }
+        problem.goalStack.setGoals(goals, problem.worldState, {});
+        _writeFrame(pOutput, "ok");
+      }
+      else if (name == "plan")
+      {
+        // Plan on a copy to keep the current problem for the next requests
+        Problem problem = _getProblem(current);
+        auto plan = planForEveryGoals(problem, *current.domainPtr, {});
+        _writeFrame(pOutput, "ok", planToPddl(plan, *current.domainPtr));
+      }
+      else
+      {
+        throw std::runtime_error("Unknown request: \"" + name + "\"");
+      }
+    }
+    catch (const std::exception& e)
+    {
+      _writeFrame(pOutput, "error", e.what());
+    }
+  }
+}
+
+} // End of namespace ogp
@@ -0,0 +1,38 @@
+#ifndef ORDEREDGOALSPLANNER_BIN_SRC_PLANNERSERVER_HPP
+#define ORDEREDGOALSPLANNER_BIN_SRC_PLANNERSERVER_HPP
+
+#include <iosfwd>
+#include <map>
+#include <string>
+
+namespace ogp
+{
+struct Domain;
+
+
+/**
+ * @brief Answer to planning requests read from an input stream, until the end of the stream or a "quit" request.<br/>
+ * The domains are only loaded once and the current problem is kept between the requests,
+ * so the parsing and the caches are not recomputed for each plan.
+ * @param[in] pInput Stream to read the requests.
+ * @param[out] pOutput Stream to write the replies.
+ * @param[in] pLoadedDomains Domains that the problems can use.
+ *
+ * Each request and each reply is a frame made of a header line "<name> <size of the payload in bytes>" followed by the payload.<br/>
+ * The requests are:
+ *  - "problem": the payload is a PDDL problem that replaces the current problem.
+ *  - "init": the payload is a list of PDDL facts to add to the current problem, or to remove if they are in a "not".
+ *  - "goal": the payload is a list of PDDL goals that replace the goals of the current problem, from the most important one.
+ *  - "plan": plan for the goals of the current problem without modifying it. The reply payload is the plan in PDDL.
+ *  - "quit": stop to answer.
+ *
+ * The replies are named "ok" or "error". The payload of an error reply is the error message.
+ */
+void servePlanner(std::istream& pInput,
+                  std::ostream& pOutput,
+                  const std::map<std::string, Domain>& pLoadedDomains);
+
+} // End of namespace ogp
+
+
+#endif // ORDEREDGOALSPLANNER_BIN_SRC_PLANNERSERVER_HPP
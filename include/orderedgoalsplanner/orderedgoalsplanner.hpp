@@ -1,20 +1,30 @@
 #ifndef INCLUDE_ORDEREDGOALSPLANNER_ORDEREDGOALSPLANNER_HPP
 #define INCLUDE_ORDEREDGOALSPLANNER_ORDEREDGOALSPLANNER_HPP
 
+#include <atomic>
+#include <functional>
+#include <future>
+#include <iosfwd>
 #include <list>
 #include <map>
+#include <optional>
+#include <unordered_map>
 #include "util/api.hpp"
 #include <orderedgoalsplanner/util/alias.hpp>
 #include <orderedgoalsplanner/types/domain.hpp>
 #include <orderedgoalsplanner/types/actioninvocationwithgoal.hpp>
 #include <orderedgoalsplanner/types/actionstodoinparallel.hpp>
 #include <orderedgoalsplanner/types/problem.hpp>
+#include <orderedgoalsplanner/types/planbatch.hpp>
 #include <orderedgoalsplanner/types/lookforanactionoutputinfos.hpp>
 
 namespace ogp
 {
 struct ParallelPan;
 
+// Thread safety: the functions below only read the domain, without taking any lock, so several threads can use
+// the same domain with different problems at the same time. A problem must only be used by one thread at a time,
+// and a global historical shared between threads needs a mutex (see Historical::setMutex).
 
 /**
  * @brief Ask the planner to get the next action to do.
@@ -107,6 +117,92 @@ std::list<ActionInvocationWithGoal> planForEveryGoals(
     Historical* pGlobalHistorical = nullptr,
     std::list<Goal>* pGoalsDonePtr = nullptr);
 
+/**
+ * @brief Compute the plan of planForEveryGoals one step at a time.<br/>
+ * A step is returned as soon as the sub-plan that contains it is found, without planning the next goals.
+ * So the first action can be started while the next steps are still to compute.
+ */
+struct ORDEREDGOALSPLANNER_API PlanStepGenerator
+{
+  /**
+   * @brief Construct a generator. Nothing is planned before the first call of next.
+   * @param[in, out] pProblem Problem of the planner. It is updated after each step, like in planForEveryGoals.<br/>
+   * It has to stay alive while the generator is used.
+   * @param[in] pDomain Domain of the planner. It has to stay alive while the generator is used.
+   * @param[in] pNow Current time.
+   * @param[in, out] pGlobalHistorical Historical more global (and with a smaller priority) than the one contained in the problem.
+   * @param[in] pSpeculateNextGoal If true, as soon as the sub-plan of a goal is found, the next goal is planned on another thread
+   * from the state predicted at the end of this sub-plan. This result is used only if the problem really reaches the predicted state.
+   * It is useful when the steps are executed while the plan is generated, for example with ordered goals.
+   */
+  PlanStepGenerator(Problem& pProblem,
+                    const Domain& pDomain,
+                    const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                    Historical* pGlobalHistorical = nullptr,
+                    bool pSpeculateNextGoal = false);
+
+  /// Stop the speculative planification if there is one, and wait until it sees the stop.
+  ~PlanStepGenerator();
+
+  /// Get the next step of the plan, or nothing if the plan is finished.
+  std::optional<ActionInvocationWithGoal> next();
+
+  /// Move the goals satisfied by the steps already returned.
+  void moveGoalsDone(std::list<Goal>& pGoalsDone) { _lookForAnActionOutputInfos.moveGoalsDone(pGoalsDone); }
+
+  /// Get the number of sub-plans that came from a speculative planification.
+  std::size_t getNbOfSpeculationsUsed() const { return _nbOfSpeculationsUsed; }
+
+private:
+  Problem& _problem;
+  const Domain& _domain;
+  std::unique_ptr<std::chrono::steady_clock::time_point> _now;
+  Historical* _globalHistorical;
+  /// Action invocation to the number of times it is already in the plan, to not loop infinitely.
+  std::unordered_map<ActionInvocation, std::size_t> _actionAlreadyInPlan;
+  LookForAnActionOutputInfos _lookForAnActionOutputInfos;
+  /// Steps of the last sub-plan found that are not returned yet.
+  std::list<ActionInvocationWithGoal> _stepsOfCurrentSubPlan;
+  bool _isFinished;
+  bool _speculateNextGoal;
+  struct Speculation;
+  /// Planification of the next goal that is running from a predicted state.
+  std::unique_ptr<Speculation> _speculationPtr;
+  /// Number of sub-plans that came from a speculative planification.
+  std::size_t _nbOfSpeculationsUsed;
+
+  /// Predict the state at the end of the current sub-plan and start to plan the next goal from it.
+  void _startSpeculation();
+  /// Use the result of the speculation if the problem is in the predicted state. Returns true if it was used.
+  bool _useSpeculation();
+};
+
+/**
+ * @brief Repair a plan after unexpected changes of the problem, instead of planning again from scratch.<br/>
+ * The steps of the previous plan that are still executable from the beginning are kept.
+ * At the first step that is not executable anymore, a short sub-plan is searched to bridge the current state
+ * to a following step of the previous plan, and the remaining steps from this one are kept.
+ * The bridge that gives the shortest plan is chosen, and a remaining step is kept only if the goals of the skipped
+ * and of the kept steps are still satisfied at the end. Only the bridges to the last steps of the previous plan are
+ * searched, and if none of them is kept, the executable steps are not kept either.<br/>
+ * Finally, the goals that are not satisfied by these steps are planned like in planForEveryGoals.
+ * @param[in, out] pProblem Problem of the planner, with the unexpected changes. It is modified like in planForEveryGoals.
+ * @param[in] pDomain Domain of the planner.
+ * @param[in] pPreviousPlan Plan that was computed before the unexpected changes, without the steps already done.
+ * @param[in] pNow Current time.
+ * @param[in, out] pGlobalHistorical Historical more global (and with a smaller priority) than the one contained in the problem.
+ * @param[out] pGoalsDonePtr List of goals satisfied during the plannification.
+ * @return List of all the actions to do with their parameters with values.
+ */
+ORDEREDGOALSPLANNER_API
+std::list<ActionInvocationWithGoal> repairPlan(
+    Problem& pProblem,
+    const Domain& pDomain,
+    const std::list<ActionInvocationWithGoal>& pPreviousPlan,
+    const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+    Historical* pGlobalHistorical = nullptr,
+    std::list<Goal>* pGoalsDonePtr = nullptr);
+
 ORDEREDGOALSPLANNER_API
 ParallelPan parallelPlanForEveryGoals(
     Problem& pProblem,
@@ -114,6 +210,72 @@ ParallelPan parallelPlanForEveryGoals(
     const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
     Historical* pGlobalHistorical);
 
+/**
+ * @brief Plan for every goals of several independent problems that share the same domain.<br/>
+ * The problems are spread on several threads. The domain is only read, so it is shared between the threads.
+ * @param[in] pDomain Domain of all the problems.
+ * @param[in, out] pProblems Problems to plan. Each problem is modified like in planForEveryGoals.
+ * @param[in] pOptions Options of the batch.
+ * @return The plan and the latency of each problem, and the total duration of the batch.
+ *
+ * An exception thrown while planning a problem does not stop the other problems, its message is stored in the problem result.
+ */
+ORDEREDGOALSPLANNER_API
+PlanBatchResult planBatch(const Domain& pDomain,
+                          std::vector<Problem>& pProblems,
+                          const PlanBatchOptions& pOptions = {});
+
+/// Function that runs a task, for example by posting it to a thread pool. The task has to be run exactly once.
+using PlanningExecutor = std::function<void(std::function<void()>)>;
+
+/**
+ * @brief Asynchronous version of planForMoreImportantGoalPossible.<br/>
+ * The problem and the global historical are copied when this function is called, so they can be modified
+ * while the planification is running. The copy is cheap for the historical (see Historical::snapshot).
+ * @param[in] pProblem Problem of the planner. It is not modified.
+ * @param[in] pDomain Domain of the planner. It has to stay alive and unchanged until the result is ready.
+ * @param[in] pTryToDoMoreOptimalSolution True if we will try to find a result that bring the quicker to the goal.
+ * @param[in] pNow Current time.
+ * @param[in] pExecutor Executor to run the planification. If it is empty, the planification runs on a new thread
+ * and the destructor of the future waits for its end.
+ * @param[in, opt] pGlobalHistorical A historical to give more priority to an action less frequently used.
+ * @param[in, opt] pStopRequested Flag to set to stop the planification, for example before releasing the domain.
+ * The search checks it regularly and the future then contains an exception.
+ * @return Future of the next actions to do. It contains the exception if the planification threw.
+ */
+ORDEREDGOALSPLANNER_API
+std::future<std::list<ActionInvocationWithGoal>> planForMoreImportantGoalPossibleAsync(
+    const Problem& pProblem,
+    const Domain& pDomain,
+    bool pTryToDoMoreOptimalSolution,
+    const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+    const PlanningExecutor& pExecutor = {},
+    const Historical* pGlobalHistorical = nullptr,
+    const std::shared_ptr<std::atomic<bool>>& pStopRequested = {});
+
+/**
+ * @brief Asynchronous version of planForEveryGoals.<br/>
+ * The problem and the global historical are copied when this function is called, so they can be modified
+ * while the planification is running. The global historical is not notified about the actions of the plan.
+ * @param[in] pProblem Problem of the planner. It is not modified.
+ * @param[in] pDomain Domain of the planner. It has to stay alive and unchanged until the result is ready.
+ * @param[in] pNow Current time.
+ * @param[in] pExecutor Executor to run the planification. If it is empty, the planification runs on a new thread
+ * and the destructor of the future waits for its end.
+ * @param[in, opt] pGlobalHistorical A historical to give more priority to an action less frequently used.
+ * @param[in, opt] pStopRequested Flag to set to stop the planification, for example before releasing the domain.
+ * The search checks it regularly and the future then contains an exception.
+ * @return Future of all the actions to do. It contains the exception if the planification threw.
+ */
+ORDEREDGOALSPLANNER_API
+std::future<std::list<ActionInvocationWithGoal>> planForEveryGoalsAsync(
+    const Problem& pProblem,
+    const Domain& pDomain,
+    const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+    const PlanningExecutor& pExecutor = {},
+    const Historical* pGlobalHistorical = nullptr,
+    const std::shared_ptr<std::atomic<bool>>& pStopRequested = {});
+
 /**
  * @brief Convert a plan to a string.
  * @param[in] pPlan Plan to print.
@@ -124,16 +286,36 @@ ORDEREDGOALSPLANNER_API
 std::string planToStr(const std::list<ActionInvocationWithGoal>& pPlan,
                       const std::string& pSep = ", ");
 
+/// Write a plan directly in an output stream.
+ORDEREDGOALSPLANNER_API
+void planToStr(std::ostream& pOutput,
+               const std::list<ActionInvocationWithGoal>& pPlan,
+               const std::string& pSep = ", ");
+
 ORDEREDGOALSPLANNER_API
 std::string parallelPlanToStr(const ParallelPan& pPlan);
 
+ORDEREDGOALSPLANNER_API
+void parallelPlanToStr(std::ostream& pOutput,
+                       const ParallelPan& pPlan);
+
 ORDEREDGOALSPLANNER_API
 std::string planToPddl(const std::list<ActionInvocationWithGoal>& pPlan,
                        const Domain& pDomain);
 
+ORDEREDGOALSPLANNER_API
+void planToPddl(std::ostream& pOutput,
+                const std::list<ActionInvocationWithGoal>& pPlan,
+                const Domain& pDomain);
+
 ORDEREDGOALSPLANNER_API
 std::string parallelPlanToPddl(const ParallelPan& pPlan,
                                const Domain& pDomain);
+
+ORDEREDGOALSPLANNER_API
+void parallelPlanToPddl(std::ostream& pOutput,
+                        const ParallelPan& pPlan,
+                        const Domain& pDomain);
 /**
  * @brief Convert a list of goals to a string.
  * @param[in] pGoals List of goals to print.
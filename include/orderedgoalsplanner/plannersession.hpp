@@ -0,0 +1,86 @@
+#ifndef INCLUDE_ORDEREDGOALSPLANNER_PLANNERSESSION_HPP
+#define INCLUDE_ORDEREDGOALSPLANNER_PLANNERSESSION_HPP
+
+#include <chrono>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "util/api.hpp"
+#include <orderedgoalsplanner/types/actioninvocationwithgoal.hpp>
+#include <orderedgoalsplanner/types/goal.hpp>
+
+namespace ogp
+{
+struct Domain;
+struct Historical;
+struct Problem;
+
+
+/**
+ * @brief Planner that remembers its last plan, to not plan again while nothing relevant for this plan changed.<br/>
+ * The relevant facts are the ones of the goals objectives, and the ones of the preconditions and of the effects
+ * of the actions and of the events that can lead to these goals.<br/>
+ * It is useful when the planner is called at each perception tick, while most of the perceived facts do not impact the plan.
+ */
+struct ORDEREDGOALSPLANNER_API PlannerSession
+{
+  /**
+   * @brief Construct a planner session.
+   * @param[in] pDomain Domain of the planner. It has to stay alive while the session is used.
+   */
+  PlannerSession(const Domain& pDomain);
+
+  /**
+   * @brief Same as the free function planForMoreImportantGoalPossible, but if the goals and the relevant facts
+   * did not change since the last call, and if no goal became inactive for too long, the last plan is returned
+   * without planning again.
+   * @param[in, out] pProblem Problem of the planner.
+   * @param[in] pTryToDoMoreOptimalSolution True if we will try to find a result that bring the quicker to the goal.
+   * @param[in] pNow Current time.
+   * @param[in, opt] pGlobalHistorical A historical to give more priority to an action less frequently used.<br/>
+   * A change of an historical does not cause a new planification.
+   * @return The next actions to do.
+   */
+  std::list<ActionInvocationWithGoal> planForMoreImportantGoalPossible(
+      Problem& pProblem,
+      bool pTryToDoMoreOptimalSolution,
+      const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+      const Historical* pGlobalHistorical = nullptr);
+
+  /// Forget the last plan, so that the next call plans again.
+  void reset();
+
+  /// Know if the last call returned the last plan without planning again.
+  bool wasLastPlanReused() const { return _wasLastPlanReused; }
+
+  /// Names of the facts that can change the last plan.
+  const std::vector<std::string>& relevantFactNames() const { return _relevantFactNames; }
+
+private:
+  const Domain& _domain;
+  bool _hasLastPlan;
+  bool _wasLastPlanReused;
+  /// Last plan returned.
+  std::list<ActionInvocationWithGoal> _lastPlan;
+  /// Identifier of the domain when the last plan was computed.
+  std::string _domainUuid;
+  /// Goals of the problem after the last planification.
+  std::map<int, std::vector<Goal>> _goals;
+  /// Names of the facts that can change the last plan.
+  std::vector<std::string> _relevantFactNames;
+  /// Versions of the relevant facts after the last planification. (see SetOfFacts::getFactNameVersion)
+  std::vector<std::size_t> _relevantFactVersions;
+
+  /// Know if the last plan can be returned for this problem at the current time.
+  bool _canReuseLastPlan(const Problem& pProblem,
+                         const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow) const;
+  /// Compute the relevant facts for the goals of the problem.
+  void _updateRelevantFacts(const Problem& pProblem);
+};
+
+} // !ogp
+
+
+#endif // INCLUDE_ORDEREDGOALSPLANNER_PLANNERSESSION_HPP
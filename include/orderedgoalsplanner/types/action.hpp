@@ -1,6 +1,7 @@
 #ifndef INCLUDE_ORDEREDGOALSPLANNER_TYPES_ACTION_HPP
 #define INCLUDE_ORDEREDGOALSPLANNER_TYPES_ACTION_HPP
 
+#include <limits>
 #include <vector>
 #include "../util/api.hpp"
 #include <orderedgoalsplanner/types/condition.hpp>
@@ -34,7 +35,8 @@ struct ORDEREDGOALSPLANNER_API Action
       canThisActionBeUsedByThePlanner(true),
       actionsSuccessionsWithoutInterestCache(),
       actionsPredecessorsCache(),
-      eventsPredecessorsCache()
+      eventsPredecessorsCache(),
+      indexInDomainCache(std::numeric_limits<std::size_t>::max())
   {
   }
 
@@ -51,7 +53,8 @@ struct ORDEREDGOALSPLANNER_API Action
       canThisActionBeUsedByThePlanner(true),
       actionsSuccessionsWithoutInterestCache(),
       actionsPredecessorsCache(),
-      eventsPredecessorsCache()
+      eventsPredecessorsCache(),
+      indexInDomainCache(std::numeric_limits<std::size_t>::max())
   {
   }
 
@@ -66,7 +69,8 @@ struct ORDEREDGOALSPLANNER_API Action
       canThisActionBeUsedByThePlanner(pAction.canThisActionBeUsedByThePlanner),
       actionsSuccessionsWithoutInterestCache(pAction.actionsSuccessionsWithoutInterestCache),
       actionsPredecessorsCache(pAction.actionsPredecessorsCache),
-      eventsPredecessorsCache(pAction.eventsPredecessorsCache)
+      eventsPredecessorsCache(pAction.eventsPredecessorsCache),
+      indexInDomainCache(pAction.indexInDomainCache)
   {
   }
 
@@ -83,6 +87,7 @@ struct ORDEREDGOALSPLANNER_API Action
     actionsSuccessionsWithoutInterestCache = pAction.actionsSuccessionsWithoutInterestCache;
     actionsPredecessorsCache = pAction.actionsPredecessorsCache;
     eventsPredecessorsCache = pAction.eventsPredecessorsCache;
+    indexInDomainCache = pAction.indexInDomainCache;
   }
 
   /// Check equality with another action.
@@ -133,6 +138,8 @@ struct ORDEREDGOALSPLANNER_API Action
   std::set<ActionId> actionsSuccessionsWithoutInterestCache;
   std::set<ActionId> actionsPredecessorsCache;
   std::set<FullEventId> eventsPredecessorsCache;
+  /// Index of this action in the domain. It is used to index the bitsets of the caches.
+  std::size_t indexInDomainCache;
 
   // TODO: manage durations
   std::size_t duration() const { return 1; }
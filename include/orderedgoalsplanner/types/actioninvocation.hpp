@@ -1,6 +1,7 @@
 #ifndef INCLUDE_ORDEREDGOALSPLANNER_TYPES_ACTIONINVOCATION_HPP
 #define INCLUDE_ORDEREDGOALSPLANNER_TYPES_ACTIONINVOCATION_HPP
 
+#include <functional>
 #include <map>
 #include <set>
 #include <string>
@@ -24,6 +25,18 @@ struct ORDEREDGOALSPLANNER_API ActionInvocation
                    const std::map<Parameter, std::set<Entity>>& pParameters);
   ~ActionInvocation();
 
+  /// Check equality with another action invocation.
+  bool operator==(const ActionInvocation& pOther) const;
+  /// Check not equality with another action invocation.
+  bool operator!=(const ActionInvocation& pOther) const { return !operator==(pOther); }
+
+  /**
+   * @brief Compute a hash of the action identifier and of the parameter values.<br/>
+   * Two equal action invocations have the same hash.
+   * @return The hash value.
+   */
+  std::size_t hash() const;
+
   /**
    * @brief Serialize in a string.
    * @return String containing the action identifier with his parameters.
@@ -42,4 +55,17 @@ struct ORDEREDGOALSPLANNER_API ActionInvocation
 } // !ogp
 
 
+namespace std
+{
+template <>
+struct hash<ogp::ActionInvocation>
+{
+  std::size_t operator()(const ogp::ActionInvocation& pActionInvocation) const
+  {
+    return pActionInvocation.hash();
+  }
+};
+} // !std
+
+
 #endif // INCLUDE_ORDEREDGOALSPLANNER_TYPES_ACTIONINVOCATION_HPP
@@ -8,6 +8,7 @@ namespace ogp
 {
 struct Condition;
 struct Fact;
+struct FactOptional;
 
 
 struct ORDEREDGOALSPLANNER_API ConditionsToValue
@@ -16,6 +17,17 @@ public:
   bool add(const Condition& pCondition,
            const std::string& pValue);
 
+  /**
+   * @brief Link one fact of a condition to a value, as add does for each fact of a condition.
+   * @param[in] pFactOptional Fact of the condition.
+   * @param[in] pValue Value to link.
+   * @param[in] pIgnoreFluent If the fluent of the fact does not matter.
+   * @return True if the fact is not negated.
+   */
+  bool addFact(const FactOptional& pFactOptional,
+               const std::string& pValue,
+               bool pIgnoreFluent);
+
   void erase(const std::string& pValue);
 
   const FactsToValue& factsToValue() const { return _factsToValue; }
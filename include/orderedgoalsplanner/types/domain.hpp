@@ -14,7 +14,14 @@
 namespace ogp
 {
 
-/// Set of all the actions that the bot can do with accessors to optimize the search of a action.
+/**
+ * @brief Set of all the actions that the bot can do with accessors to optimize the search of a action.<br/>
+ * All the caches derived from the actions and the events are computed when the domain is modified,
+ * and the signature tables of the predicates when they are added to the ontology, never while planning.
+ * So once built, a domain is only read, without any lock, and it can be shared by several threads that plan
+ * different problems concurrently: the planning functions only take it as const.<br/>
+ * The functions that modify the domain must not be called while it is used by another thread.
+ */
 struct ORDEREDGOALSPLANNER_API Domain
 {
   /// Construct an empty domain.
@@ -49,6 +56,15 @@ struct ORDEREDGOALSPLANNER_API Domain
   void addAction(const ActionId& pActionId,
                  const Action& pAction);
 
+  /**
+   * @brief Add several actions and update the successions only once.
+   * @param pActions[in] Map of action identifiers to action to add.
+   *
+   * It is faster than calling addAction for each action.<br/>
+   * The actions whose identifier is already used will not be added.
+   */
+  void addActions(const std::map<ActionId, Action>& pActions);
+
   /**
    * @brief Remove an action.
    * @param pActionId[in] Identifier of the action to remove.
@@ -58,6 +74,15 @@ struct ORDEREDGOALSPLANNER_API Domain
    */
   void removeAction(const ActionId& pActionId);
 
+  /**
+   * @brief Remove several actions.
+   * @param pActionIds[in] Identifiers of the actions to remove.
+   *
+   * The successions of the remaining actions and events are updated without being recomputed.<br/>
+   * The identifiers that are not found are ignored.
+   */
+  void removeActions(const std::set<ActionId>& pActionIds);
+
   const Action* getActionPtr(const ActionId& pActionId) const;
 
   /// All action identifiers to action.
@@ -119,6 +144,9 @@ struct ORDEREDGOALSPLANNER_API Domain
   static const std::string& getSetOfEventsIdFromConstructor();
 
 private:
+  /// Fill a domain from a binary snapshot, with its caches, without recomputing them.
+  friend struct DomainSnapshotLoader;
+
   /// Universal unique identifier regenerated each time this object is modified.
   std::string _uuid;
   std::string _name;
@@ -134,10 +162,20 @@ private:
   std::map<SetOfEventsId, SetOfEvents> _setOfEvents;
   std::set<std::string> _requirements;
 
-  void _addAction(const ActionId& pActionId,
+  bool _addAction(const ActionId& pActionId,
                   const Action& pAction);
+  bool _removeAction(const ActionId& pActionId);
 
+  /// Recompute the successions and the predecessors of all the actions and events.
   void _updateSuccessions();
+  /// Update the successions and the predecessors after the removal of some actions, without recomputing the successions.
+  void _updateSuccessionsAfterActionsRemoval(const std::set<ActionId>& pRemovedActionIds);
+  /**
+   * Update the successions and the predecessors after the addition of some actions.<br/>
+   * Only the successions of the new actions and of the actions and events that can modify their preconditions are recomputed.
+   */
+  void _updateSuccessionsAfterActionsAddition(const std::set<ActionId>& pAddedActionIds);
+  void _updateIndexesInDomainCache();
 };
 
 } // !ogp
@@ -1,9 +1,11 @@
 #ifndef INCLUDE_ORDEREDGOALSPLANNER_ENTITY_HPP
 #define INCLUDE_ORDEREDGOALSPLANNER_ENTITY_HPP
 
+#include <optional>
 #include <string>
 #include <vector>
 #include "../util/api.hpp"
+#include "../util/util.hpp"
 #include "type.hpp"
 
 namespace ogp
@@ -32,6 +34,7 @@ struct ORDEREDGOALSPLANNER_API Entity
   static const std::string& anyEntityValue();
   static Entity createAnyEntity();
   static Entity createNumberEntity(const std::string& pNumber);
+  static Entity createNumberEntity(const Number& pNumber);
   static Entity fromDeclaration(const std::string& pStr,
                                 const SetOfTypes& pSetOfTypes);
 
@@ -49,6 +52,8 @@ struct ORDEREDGOALSPLANNER_API Entity
 
   std::string value;
   std::shared_ptr<Type> type;
+  /// Native value of a number entity, set at construction so that the arithmetic does not parse the value string.
+  std::optional<Number> number;
 };
 
 } // !ogp
@@ -3,6 +3,7 @@
 
 #include <assert.h>
 #include <functional>
+#include <limits>
 #include <map>
 #include <vector>
 #include "../util/api.hpp"
@@ -29,7 +30,8 @@ struct ORDEREDGOALSPLANNER_API Event
       factsToModify(pEvent.factsToModify ? pEvent.factsToModify->clone(nullptr) : std::unique_ptr<WorldStateModification>()),
       goalsToAdd(pEvent.goalsToAdd),
       actionsPredecessorsCache(pEvent.actionsPredecessorsCache),
-      eventsPredecessorsCache(pEvent.eventsPredecessorsCache)
+      eventsPredecessorsCache(pEvent.eventsPredecessorsCache),
+      indexInDomainCache(pEvent.indexInDomainCache)
   {
     assert(precondition);
     assert(factsToModify || !goalsToAdd.empty());
@@ -38,6 +40,7 @@ struct ORDEREDGOALSPLANNER_API Event
   void updateSuccessionCache(const Domain& pDomain,
                              const SetOfEventsId& pSetOfEventsIdOfThisEvent,
                              const EventId& pEventIdOfThisEvent);
+  void removePossibleSuccessionCache(const ActionId& pActionIdToRemove);
   std::string printSuccessionCache() const;
 
   /// Parameter names of this event.
@@ -54,6 +57,8 @@ struct ORDEREDGOALSPLANNER_API Event
 
   std::set<ActionId> actionsPredecessorsCache;
   std::set<FullEventId> eventsPredecessorsCache;
+  /// Index of this event in the domain. It is used to index the bitsets of the caches.
+  std::size_t indexInDomainCache;
 };
 
 
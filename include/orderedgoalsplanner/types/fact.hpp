@@ -8,6 +8,7 @@
 #include <set>
 #include "../util/api.hpp"
 #include <orderedgoalsplanner/types/entity.hpp>
+#include <orderedgoalsplanner/types/factsignatureid.hpp>
 #include <orderedgoalsplanner/types/predicate.hpp>
 
 namespace ogp
@@ -47,6 +48,19 @@ struct ORDEREDGOALSPLANNER_API Fact
        const std::vector<Parameter>& pParameters,
        bool pIsOkIfFluentIsMissing = false);
 
+  /**
+   * @brief Construct a fact from its already resolved and checked parts, for example when they are loaded from a snapshot.<br/>
+   * Unlike the other constructors, no validity check is done.
+   * @param[in] pPredicate Predicate of the fact, with the types of the parameters to fill.
+   * @param[in] pArguments Arguments of the fact.
+   * @param[in] pFluent Fluent of the fact.
+   * @param[in] pIsFluentNegated Is the fluent of the fact negated.
+   */
+  Fact(const Predicate& pPredicate,
+       std::vector<Entity>&& pArguments,
+       std::optional<Entity>&& pFluent,
+       bool pIsFluentNegated);
+
   /// Destruct the fact.
   ~Fact();
 
@@ -166,6 +180,11 @@ struct ORDEREDGOALSPLANNER_API Fact
   std::string toPddl(bool pInEffectContext,
                      bool pPrintAnyFluent = true) const;
 
+  /// Write this fact in PDDL directly in an output stream.
+  void toPddl(std::ostream& pOutput,
+              bool pInEffectContext,
+              bool pPrintAnyFluent = true) const;
+
   /// Serialize this fact to a string.
   std::string toStr(bool pPrintAnyFluent = true) const;
 
@@ -268,6 +287,12 @@ struct ORDEREDGOALSPLANNER_API Fact
   void generateSignatureForAllSubTypes(std::list<std::string>& pRes) const;
   void generateSignatureForAllUpperTypes(std::list<std::string>& pRes) const;
   void generateSignatureForSubAndUpperTypes(std::list<std::string>& pRes) const;
+  /// Identifier of the signature of this fact.
+  FactSignatureId signatureId() const;
+  /// Add the identifiers of the signatures of this fact for all upper types.
+  void signatureIdsForAllUpperTypes(std::vector<FactSignatureId>& pRes) const;
+  /// Add the identifiers of the signatures of this fact for all sub and upper types.
+  void signatureIdsForSubAndUpperTypes(std::vector<FactSignatureId>& pRes) const;
 
   void setArgumentType(std::size_t pIndex, const std::shared_ptr<Type>& pType);
   void setFluentType(const std::shared_ptr<Type>& pType);
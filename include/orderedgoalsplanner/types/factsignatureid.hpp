@@ -0,0 +1,27 @@
+#ifndef INCLUDE_ORDEREDGOALSPLANNER_TYPES_FACTSIGNATUREID_HPP
+#define INCLUDE_ORDEREDGOALSPLANNER_TYPES_FACTSIGNATUREID_HPP
+
+#include <cstdint>
+#include <string>
+#include "../util/api.hpp"
+
+namespace ogp
+{
+
+/// Identifier of a fact signature, that is the name of a fact with the types of its arguments and of its fluent.
+struct ORDEREDGOALSPLANNER_API FactSignatureId
+{
+  /// Integer identifier given by the predicate of the fact. It is 0 if the predicate cannot identify this typing.
+  std::uint64_t id = 0;
+  /// Signature in a string. It is only set if id is 0.
+  std::string signature = "";
+
+  bool operator<(const FactSignatureId& pOther) const { return id != pOther.id ? id < pOther.id : signature < pOther.signature; }
+  bool operator==(const FactSignatureId& pOther) const { return id == pOther.id && signature == pOther.signature; }
+  bool operator!=(const FactSignatureId& pOther) const { return !operator==(pOther); }
+};
+
+} // !ogp
+
+
+#endif // INCLUDE_ORDEREDGOALSPLANNER_TYPES_FACTSIGNATUREID_HPP
@@ -9,6 +9,7 @@
 #include <string>
 #include <vector>
 #include <sstream>
+#include <orderedgoalsplanner/types/factsignatureid.hpp>
 
 
 namespace ogp
@@ -128,7 +129,7 @@ private:
     std::vector<std::map<std::string, std::list<std::string>>> argIdToArgValueToValues;
     std::map<std::string, std::list<std::string>> fluentValueToValues;
   };
-  std::map<std::string, ParameterToValues> _signatureToLists;
+  std::map<FactSignatureId, ParameterToValues> _signatureToLists;
   std::list<std::string> _valuesWithoutFact;
 
   void _erase(const Fact& pFact,
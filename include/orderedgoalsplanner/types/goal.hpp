@@ -2,8 +2,11 @@
 #define INCLUDE_ORDEREDGOALSPLANNER_GOAL_HPP
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <chrono>
+#include <cstdint>
+#include <vector>
 #include "condition.hpp"
 #include "factoptional.hpp"
 #include "../util/api.hpp"
@@ -12,6 +15,7 @@
 namespace ogp
 {
 struct Domain;
+struct WorldState;
 
 
 // A characteristic that the world should have. It is the motivation of the bot for doing actions to respect this characteristic of the world.
@@ -59,6 +63,12 @@ struct ORDEREDGOALSPLANNER_API Goal
   /// Notify that the gaol is active. (so in top of the goals stack)
   void notifyActivity();
 
+  /**
+   * @brief Get the time from which the goal will be inactive for too long.
+   * @return The expiry time, or nothing if the goal is not inactive or if it can stay inactive forever.
+   */
+  std::optional<std::chrono::steady_clock::time_point> getInactivityExpiry() const;
+
   /// Get the time when this goal became incative. It is a null pointer if the goal is active.
   const std::unique_ptr<std::chrono::steady_clock::time_point>& getInactiveSince() const { return _inactiveSince; }
 
@@ -74,11 +84,17 @@ struct ORDEREDGOALSPLANNER_API Goal
   /// Know if the goal will be removed from the goals stack after the first time we try to satisfy it.
   bool isOneStepTowards() const { return _oneStepTowards; }
 
-  /// Get a const reference of the optional fact contained in this goal.
+  /// Get a const reference of the optional fact contained in this goal. It is immutable and shared between the copies of the goal.
   const Condition& objective() const { return *_objective; }
 
-  /// Get a reference of the optional fact contained in this goal.
-  Condition& objective() { return *_objective; }
+  /**
+   * @brief Get a reference of the objective to modify it.<br/>
+   * The objective is cloned before if it is shared with other goals, so they are not modified.
+   * The caches computed from the objective are reset, so the objective has to be modified before the next use of the goal.
+   * @deprecated The objective is shared between the copies of the goal. Construct a new goal instead.
+   */
+  [[deprecated("The objective is shared between the copies of the goal. Construct a new goal instead.")]]
+  Condition& objective();
 
   /// Get the group identifier of this goal. It can be empty if the goal does not belong to a group.
   const std::string& getGoalGroupId() const { return _goalGroupId; }
@@ -91,6 +107,15 @@ struct ORDEREDGOALSPLANNER_API Goal
 
   bool isASimpleFactObjective() const;
 
+  /**
+   * @brief Check if the objective of this goal is satisfied in a world state.<br/>
+   * The result is cached with the versions of the facts that the objective watches,
+   * so the objective is only evaluated again if one of these facts changed.
+   * @param[in] pWorldState World state to consider.
+   * @return True if the objective is satisfied.
+   */
+  bool isSatisfied(const WorldState& pWorldState) const;
+
   void refreshIfNeeded(const Domain& pDomain);
 
   std::string printActionsThatCanSatisfyThisGoal() const;
@@ -101,8 +126,13 @@ struct ORDEREDGOALSPLANNER_API Goal
 
   bool canDeductionSatisfyThisGoal(const ActionId& pDeductionId) const;
 
-  const std::set<ActionId>& getActionsPredecessors() const { return _cacheOfActionsPredecessors; }
-  const std::set<FullEventId>& getEventsPredecessors() const { return _cacheOfEventsPredecessors; }
+  const std::set<ActionId>& getActionsPredecessors() const { return _domainCache->actionsPredecessors; }
+  const std::set<FullEventId>& getEventsPredecessors() const { return _domainCache->eventsPredecessors; }
+
+  /// Know if an action is a predecessor of this goal, from its index in the domain. (Action::indexInDomainCache)
+  bool isActionPredecessor(std::size_t pActionIndex) const;
+  /// Know if an event is a predecessor of this goal, from its index in the domain. (Event::indexInDomainCache)
+  bool isEventPredecessor(std::size_t pEventIndex) const;
 
   /// Persist function name.
   static const std::string& getPersistFunctionName();
@@ -110,8 +140,8 @@ struct ORDEREDGOALSPLANNER_API Goal
   static const std::string& getOneStepTowardsFunctionName();
 
 private:
-  /// Condition that the world should satify in the world.
-  std::unique_ptr<Condition> _objective;
+  /// Condition that the world should satify in the world. It is immutable so the copies of the goal share it.
+  std::shared_ptr<const Condition> _objective;
   /**
    * The maximum time that we allow for this goal to be inactive in second.<br/>
    * A negative value means that the time is infinite.<br/>
@@ -120,6 +150,8 @@ private:
   int _maxTimeToKeepInactive;
   /// Time when this goal became inactive. It is a null pointer if the goal is active.
   std::unique_ptr<std::chrono::steady_clock::time_point> _inactiveSince;
+  /// Identifier of this goal in the goal stack that contains it, to find it from its inactivity expiry. It is not compared.
+  std::uint64_t _idInGoalStack;
   /// Know if the goal will be kept in the goals stack, when we succeded or failed to satisfy it.
   bool _isPersistentIfSkipped;
   /// Know if the goal will be removed from the goals stack after the first time we try to satisfy it.
@@ -127,10 +159,41 @@ private:
   /// Group identifier of this goal. It can be empty if the goal does not belong to a group.
   std::string _goalGroupId;
   std::string _uuidOfLastDomainUsedForCache;
-  std::set<ActionId> _cacheOfActionsThatCanSatisfyThisGoal;
-  std::set<std::string> _cacheOfEventsIdThatCanSatisfyThisGoal;
-  std::set<ActionId> _cacheOfActionsPredecessors;
-  std::set<FullEventId> _cacheOfEventsPredecessors;
+
+  /// Data that only depends on the objective and on the domain.
+  struct DomainCache
+  {
+    bool operator==(const DomainCache& pOther) const;
+
+    std::set<ActionId> actionsThatCanSatisfyThisGoal{};
+    std::set<FullEventId> eventsIdThatCanSatisfyThisGoal{};
+    std::set<ActionId> actionsPredecessors{};
+    std::set<FullEventId> eventsPredecessors{};
+    /// Bitset of the predecessor actions, indexed by Action::indexInDomainCache.
+    std::vector<bool> actionsPredecessorsIndexes{};
+    /// Bitset of the predecessor events, indexed by Event::indexInDomainCache.
+    std::vector<bool> eventsPredecessorsIndexes{};
+  };
+  /// Read-only cache shared between the copies of this goal. It is recomputed when the domain changes.
+  std::shared_ptr<const DomainCache> _domainCache;
+
+  static const std::shared_ptr<const DomainCache>& _getEmptyDomainCache();
+
+  /// Satisfaction of the objective computed for some versions of the watched facts.
+  struct SatisfactionCache
+  {
+    /// Names of the facts that the objective watches. It only depends on the objective so it is shared between the copies of the goal.
+    std::shared_ptr<const std::vector<std::string>> watchedFactNames;
+    /// Versions of the watched facts when the satisfaction was computed.
+    std::vector<std::size_t> watchedFactVersions;
+    /// Is the satisfaction computed.
+    bool isComputed = false;
+    /// Was the objective satisfied for these versions.
+    bool isSatisfied = false;
+  };
+  mutable SatisfactionCache _satisfactionCache;
+
+  friend struct GoalStack;
 };
 
 } // !ogp
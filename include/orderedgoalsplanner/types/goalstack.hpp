@@ -1,9 +1,12 @@
 #ifndef INCLUDE_ORDEREDGOALSPLANNER_GOALSTACK_HPP
 #define INCLUDE_ORDEREDGOALSPLANNER_GOALSTACK_HPP
 
+#include <cstdint>
 #include <set>
 #include <map>
 #include <memory>
+#include <optional>
+#include <vector>
 #include "../util/api.hpp"
 #include <orderedgoalsplanner/types/fact.hpp>
 #include <orderedgoalsplanner/types/goal.hpp>
@@ -186,6 +189,23 @@ struct ORDEREDGOALSPLANNER_API GoalStack
   void removeFirstGoalsThatAreAlreadySatisfied(const WorldState& pWorldState,
                                                const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow);
 
+  /**
+   * @brief Get the next time when a goal will be inactive for too long.<br/>
+   * It allows to sleep until the next call to removeGoalsInactiveForTooLong that can change something.
+   * @return The next expiry time, or nothing if no goal can expire.
+   */
+  std::optional<std::chrono::steady_clock::time_point> nextExpiry() const;
+
+  /**
+   * @brief Remove the goals that are inactive for too long and that are below the active goal.<br/>
+   * It does nothing if no goal has expired, so it can be called only when pNow reaches nextExpiry().
+   * @param[in] pWorldState World state to consider.
+   * @param[in] pNow Current time.
+   * @return True if at least one goal is removed, false otherwise.
+   */
+  bool removeGoalsInactiveForTooLong(const WorldState& pWorldState,
+                                     const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow);
+
   /// Goals to satisfy.
   const std::map<int, std::vector<Goal>>& goals() const { return _goals; }
 
@@ -212,6 +232,43 @@ private:
   /// Current active goal.
   const Goal* _currentGoalPtr = nullptr;
 
+  /// Time from which a goal will be inactive for too long.
+  struct InactivityExpiry
+  {
+    bool operator<(const InactivityExpiry& pOther) const;
+
+    std::chrono::steady_clock::time_point expiry;
+    /// Identifier of the goal in this goal stack.
+    std::uint64_t goalId;
+  };
+  /// Inactivity expiries of the goals, updated when a goal is added, removed or becomes inactive.
+  struct InactivityExpiries
+  {
+    /// Expiries that are not passed yet, the first one is the next expiry.
+    std::set<InactivityExpiry> notPassed{};
+    /// Goals whose expiry is passed. They are removed as soon as they are below the active goal.
+    std::set<std::uint64_t> passedGoalIds{};
+  };
+  /// Inactivity expiries shared between the copies of this goal stack until one of them modifies them.
+  std::shared_ptr<InactivityExpiries> _inactivityExpiriesPtr{};
+  /// Last identifier given to a goal added in this goal stack.
+  std::uint64_t _lastGoalId = 0;
+
+  /// Get the inactivity expiries to modify, they are copied if they are shared with another goal stack.
+  InactivityExpiries& _getInactivityExpiriesToModify();
+  /// Give an identifier to a goal added in this goal stack and store its inactivity expiry.
+  void _onGoalAdded(Goal& pGoal);
+  /// Forget the inactivity expiry of a goal removed from this goal stack.
+  void _onGoalRemoved(const Goal& pGoal);
+  /// Set a goal inactive, if not already, and store its inactivity expiry.
+  void _setGoalInactive(Goal& pGoal,
+                        const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow);
+  /// Move the expiries passed at pNow from the not passed expiries to the passed expiries.
+  void _updatePassedInactivityExpiries(const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow);
+  /// Know if a goal is inactive for too long, from the passed expiries.
+  bool _isInactiveForTooLong(const Goal& pGoal,
+                             const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow) const;
+
   void _removeNoStackableGoalsAndNotifyGoalsChanged(
       const WorldState& pWorldState,
       const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow);
@@ -12,12 +12,24 @@ namespace ogp
 {
 
 
-/// Container of the actions already done.
+/**
+ * @brief Container of the actions already done.<br/>
+ * The copies and the snapshots of an historical share the container until one of them is modified.
+ * A notification modifies the container in place if it is not shared, else it replaces it by a modified copy.
+ * So a snapshot is never modified and it can be read without lock.
+ */
 struct ORDEREDGOALSPLANNER_API Historical
 {
   /// Set the mutex.
   void setMutex(std::shared_ptr<std::mutex> pMutex);
 
+  /**
+   * @brief Get a snapshot of this historical, without mutex and without copying the actions already done.<br/>
+   * The snapshot is not impacted by the next notifications, so it can be read without lock while this historical is modified by another thread.
+   * @return The snapshot.
+   */
+  Historical snapshot() const;
+
   /**
    * @brief Notify that an action finished.
    * @param pActionId Identifier of the finished action.
@@ -41,8 +53,8 @@ struct ORDEREDGOALSPLANNER_API Historical
 private:
   /// Mutex to proect this struct.
   std::shared_ptr<std::mutex> _mutexPtr;
-  /// Action to the number of time the action has already been done.
-  std::map<ActionId, std::size_t> _actionToNumberOfTimeAleardyDone;
+  /// Action to the number of time the action has already been done. It is null if no action has been done.
+  std::shared_ptr<std::map<ActionId, std::size_t>> _actionToNumberOfTimeAleardyDone;
 
   // Notify that an action finished.
   void _notifyActionDone(const ActionId& pActionId);
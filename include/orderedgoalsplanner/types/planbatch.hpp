@@ -0,0 +1,56 @@
+#ifndef INCLUDE_ORDEREDGOALSPLANNER_TYPES_PLANBATCH_HPP
+#define INCLUDE_ORDEREDGOALSPLANNER_TYPES_PLANBATCH_HPP
+
+#include <chrono>
+#include <list>
+#include <string>
+#include <vector>
+#include "../util/api.hpp"
+#include <orderedgoalsplanner/types/actioninvocationwithgoal.hpp>
+
+
+namespace ogp
+{
+
+/// Options to plan a batch of problems.
+struct ORDEREDGOALSPLANNER_API PlanBatchOptions
+{
+  /// Maximum number of threads to use. 0 means the number of threads supported by the hardware.
+  std::size_t maxNbOfThreads = 0;
+};
+
+
+/// Result of the plannification of one problem of a batch.
+struct ORDEREDGOALSPLANNER_API ProblemPlanResult
+{
+  /// Plan found for the problem.
+  std::list<ActionInvocationWithGoal> plan{};
+  /// Time spent to plan this problem.
+  std::chrono::microseconds duration{0};
+  /// Error message if the plannification threw, empty otherwise.
+  std::string errorMessage{};
+};
+
+
+/// Result of the plannification of a batch of problems.
+struct ORDEREDGOALSPLANNER_API PlanBatchResult
+{
+  /// Results of the problems, in the same order as the problems of the batch.
+  std::vector<ProblemPlanResult> problemResults{};
+  /// Total time spent to plan all the problems.
+  std::chrono::microseconds duration{0};
+
+  /// Number of problems planned per second.
+  double throughput() const
+  {
+    if (duration.count() <= 0)
+      return 0;
+    return static_cast<double>(problemResults.size()) * 1000000 / duration.count();
+  }
+};
+
+
+} // !ogp
+
+
+#endif // INCLUDE_ORDEREDGOALSPLANNER_TYPES_PLANBATCH_HPP
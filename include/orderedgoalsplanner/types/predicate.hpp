@@ -10,6 +10,7 @@
 
 namespace ogp
 {
+struct FactSignaturesTable;
 
 struct ORDEREDGOALSPLANNER_API Predicate
 {
@@ -19,6 +20,16 @@ struct ORDEREDGOALSPLANNER_API Predicate
             std::size_t pBeginPos = 0,
             std::size_t* pResPos = nullptr);
 
+  /**
+   * @brief Construct a predicate from its already resolved parts.
+   * @param[in] pName Name of the predicate.
+   * @param[in] pParameters Argument types of the predicate.
+   * @param[in] pFluent Fluent type of the predicate.
+   */
+  Predicate(const std::string& pName,
+            const std::vector<Parameter>& pParameters,
+            const std::shared_ptr<Type>& pFluent = {});
+
   std::string toPddl() const;
   std::string toStr() const;
 
@@ -31,6 +42,9 @@ struct ORDEREDGOALSPLANNER_API Predicate
   std::vector<Parameter> parameters;
   /// Fluent type of the predicate.
   std::shared_ptr<Type> fluent;
+  /// Identifiers of the signatures of the facts of this predicate, computed when the predicate is added to a set of predicates.
+  /// It is immutable and shared between the copies of the predicate.
+  std::shared_ptr<const FactSignaturesTable> signaturesTable;
 };
 
 } // !ogp
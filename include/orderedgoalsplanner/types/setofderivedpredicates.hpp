@@ -22,6 +22,9 @@ struct ORDEREDGOALSPLANNER_API SetOfDerivedPredicates
 
   const Predicate* nameToPredicatePtr(const std::string& pPredicateName) const;
 
+  /// Get all the derived predicates by their name.
+  const std::map<std::string, DerivedPredicate>& allDerivedPredicates() const { return _nameToDerivedPredicate; }
+
   std::unique_ptr<Condition> optFactToConditionPtr(const FactOptional& pFactOptional) const;
 
 
@@ -6,6 +6,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 #include "entity.hpp"
 
 namespace ogp
@@ -27,15 +28,29 @@ struct ORDEREDGOALSPLANNER_API SetOfEntities
 
   const std::set<Entity>* typeNameToEntities(const std::string& pTypename) const;
 
+  /**
+   * @brief Get the entities of a type, including the entities of all its sub types.
+   * @param[in] pTypename Name of the type.
+   * @return Sorted contiguous array of entities or nullptr if there is no entity of this type.
+   */
+  const std::vector<Entity>* typeNameToEntitiesWithSubTypes(const std::string& pTypename) const;
+
   const Entity* valueToEntity(const std::string& pValue) const;
 
   std::string toStr(std::size_t pIdentation = 0) const;
 
   bool empty() const { return _valueToEntity.empty(); }
 
+  /// Get all the entities by their value.
+  const std::map<std::string, Entity>& allEntities() const { return _valueToEntity; }
+
 private:
   std::map<std::string, Entity> _valueToEntity;
   std::map<std::string, std::set<Entity>> _typeNameToEntities;
+  /// Type name to sorted entities of this type or of one of its sub types. It is refreshed on each addition.
+  std::map<std::string, std::vector<Entity>> _typeNameToEntitiesWithSubTypes;
+
+  void _remove(const Entity& pEntity);
 };
 
 } // namespace ogp
@@ -7,8 +7,10 @@
 #include <optional>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <sstream>
+#include <orderedgoalsplanner/types/factsignatureid.hpp>
 
 
 namespace ogp
@@ -22,6 +24,12 @@ struct SetOfEntities;
 struct ORDEREDGOALSPLANNER_API SetOfFacts
 {
   SetOfFacts();
+  /// Construct a copy. The indexes of the copy point to its own facts.
+  SetOfFacts(const SetOfFacts& pOther);
+  SetOfFacts(SetOfFacts&& pOther) = default;
+
+  SetOfFacts& operator=(const SetOfFacts& pOther);
+  SetOfFacts& operator=(SetOfFacts&& pOther) = default;
 
   static SetOfFacts fromPddl(const std::string& pStr,
                              std::size_t& pPos,
@@ -31,9 +39,16 @@ struct ORDEREDGOALSPLANNER_API SetOfFacts
 
   std::string toPddl(std::size_t pIdentation, bool pPrintTimeLessFactsToo) const;
 
+  /// Write the facts in PDDL directly in an output stream, without building the whole content in a string.
+  void toPddl(std::ostream& pOutput, std::size_t pIdentation, bool pPrintTimeLessFactsToo) const;
+
   void add(const Fact& pFact,
            bool pCanBeRemoved = true);
 
+  /// Add a fact by moving it in the set, to avoid a copy when the fact is not used anymore by the caller.
+  void add(Fact&& pFact,
+           bool pCanBeRemoved = true);
+
   bool erase(const Fact& pValue);
 
   void clear();
@@ -41,25 +56,25 @@ struct ORDEREDGOALSPLANNER_API SetOfFacts
   class SetOfFactIterator {
      public:
          // Constructor accepting reference to std::list<Toto*>
-         SetOfFactIterator(const std::list<Fact>* listPtr)
+         SetOfFactIterator(const std::list<const Fact*>* listPtr)
            : _listPtr(listPtr),
              _list()
          {}
 
-         SetOfFactIterator(std::list<Fact>&& list)
+         SetOfFactIterator(std::list<const Fact*>&& list)
            : _listPtr(nullptr),
              _list(std::move(list))
          {}
 
          // Custom iterator class for non-const access
          class Iterator {
-             typename std::list<Fact>::const_iterator iter;
+             typename std::list<const Fact*>::const_iterator iter;
 
          public:
-             Iterator(typename std::list<Fact>::const_iterator it) : iter(it) {}
+             Iterator(typename std::list<const Fact*>::const_iterator it) : iter(it) {}
 
              // Overload the dereference operator to return Toto& instead of Toto*
-             const Fact& operator*() const { return *iter; }
+             const Fact& operator*() const { return **iter; }
 
              // Pre-increment operator
              Iterator& operator++() {
@@ -78,8 +93,8 @@ struct ORDEREDGOALSPLANNER_API SetOfFacts
          std::string toStr() const;
 
      private:
-         const std::list<Fact>* _listPtr;
-         std::list<Fact> _list;
+         const std::list<const Fact*>* _listPtr;
+         std::list<const Fact*> _list;
   };
 
 
@@ -107,11 +122,22 @@ struct ORDEREDGOALSPLANNER_API SetOfFacts
 
   bool empty() const { return _facts.empty(); }
 
+  /**
+   * @brief Get the version of the facts that have a name.<br/>
+   * Each modification of the facts of a name gives them a new version, unique among all the sets of facts.<br/>
+   * So if two versions are equal the facts of this name are the same. The goals use it to know if their satisfaction
+   * has to be computed again, so a modification does not have to notify them.
+   * @param[in] pFactName Name of the facts.
+   * @return The version of the facts, 0 if no fact of this name was ever added.
+   */
+  std::size_t getFactNameVersion(const std::string& pFactName) const;
+
 private:
   /// Fact to bool True if the fact is timeless
   std::map<Fact, bool> _facts;
-  std::optional<std::map<std::string, std::list<Fact>>> _exactCallToListsOpt;
-  std::optional<std::map<std::string, std::list<Fact>>> _exactCallWithoutFluentToListsOpt;
+  // The indexes below point to the facts stored in _facts, so that each fact is stored only once.
+  std::optional<std::map<std::string, std::list<const Fact*>>> _exactCallToListsOpt;
+  std::optional<std::map<std::string, std::list<const Fact*>>> _exactCallWithoutFluentToListsOpt;
   struct ParameterToValues
   {
     ParameterToValues(std::size_t pNbOfArgs)
@@ -120,20 +146,44 @@ private:
        fluentValueToValues()
     {
     }
-    std::list<Fact> all;
-    std::vector<std::map<std::string, std::list<Fact>>> argIdToArgValueToValues;
-    std::map<std::string, std::list<Fact>> fluentValueToValues;
+    std::list<const Fact*> all;
+    std::vector<std::map<std::string, std::list<const Fact*>>> argIdToArgValueToValues;
+    std::map<std::string, std::list<const Fact*>> fluentValueToValues;
   };
-  std::map<std::string, ParameterToValues> _signatureToLists;
+  std::map<FactSignatureId, ParameterToValues> _signatureToLists;
+  /// Fact name to the version of the facts of this name.
+  std::unordered_map<std::string, std::size_t> _factNameToVersion;
+  /// Versions reserved by this set of facts and not used yet.
+  struct ReservedVersions
+  {
+    ReservedVersions() = default;
+    /// A copy does not take the versions of the original, else they could give the same version to different facts.
+    ReservedVersions(const ReservedVersions&) {}
+    ReservedVersions& operator=(const ReservedVersions&) { return *this; }
+
+    std::size_t next = 0;
+    std::size_t end = 0;
+  };
+  ReservedVersions _reservedVersions;
 
   bool _erase(const Fact& pValue);
 
+  void _addInLists(const Fact& pFact);
+
+  /// Make the indexes copied from another set of facts point to the facts of this set.
+  void _redirectListsFrom(const SetOfFacts& pOther);
+
+  void _increaseFactNameVersion(const std::string& pFactName);
+
+  /// Get a new version from the versions reserved by this set of facts, and reserve some more if needed.
+  std::size_t _newFactNameVersion();
+
   // TODO: can be static
-  void _removeAValueForList(std::list<Fact>& pList,
-                            const Fact& pValue) const;
+  void _removeAValueForList(std::list<const Fact*>& pList,
+                            const Fact* pValuePtr) const;
 
-  const std::list<Fact>* _findAnExactCall(const std::optional<std::map<std::string, std::list<Fact>>>& pExactCalls,
-                                          const std::string& pExactCall) const;
+  const std::list<const Fact*>* _findAnExactCall(const std::optional<std::map<std::string, std::list<const Fact*>>>& pExactCalls,
+                                                 const std::string& pExactCall) const;
 
 };
 
@@ -39,6 +39,9 @@ struct ORDEREDGOALSPLANNER_API SetOfPredicates
   std::string toStr() const;
 
   bool empty() const { return _nameToPredicate.empty(); }
+
+  /// Get all the predicates by their name.
+  const std::map<std::string, Predicate>& allPredicates() const { return _nameToPredicate; }
   bool hasPredicateOfPddlType(PredicatePddlType pTypeFilter) const;
 
 private:
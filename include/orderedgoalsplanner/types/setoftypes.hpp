@@ -27,9 +27,17 @@ struct ORDEREDGOALSPLANNER_API SetOfTypes
   std::string toStr(std::size_t pIdentation = 0) const;
   bool empty() const;
 
+  /// Get the types without parent. The other types are accessible from their sub types.
+  const std::list<std::shared_ptr<Type>>& rootTypes() const { return _types; }
+
 private:
   std::list<std::shared_ptr<Type>> _types;
   std::map<std::string, std::shared_ptr<Type>> _nameToType;
+
+  void _addType(const std::string& pTypeToAdd,
+                const std::string& pParentType);
+  /// Number the types with pre-order intervals so that Type::isA is only two integer comparisons.
+  void _numberTypes();
 };
 
 } // namespace ogp
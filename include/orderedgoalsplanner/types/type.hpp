@@ -31,6 +31,13 @@ struct ORDEREDGOALSPLANNER_API Type
   const std::string name;
   const std::shared_ptr<Type> parent;
   std::list<std::shared_ptr<Type>> subTypes;
+
+  /// Identifier of the numbering of the type hierarchy. 0 means that the type is not numbered.
+  std::size_t hierarchyId;
+  /// Index of this type in the pre-order traversal of the hierarchy.
+  std::size_t preOrderIndex;
+  /// Biggest pre-order index of the sub types of this type.
+  std::size_t lastSubTypePreOrderIndex;
 };
 
 } // namespace ogp
@@ -2,9 +2,11 @@
 #define INCLUDE_ORDEREDGOALSPLANNER_TYPES_WORLDSTATE_HPP
 
 #include <chrono>
+#include <functional>
 #include <list>
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 #include <orderedgoalsplanner/types/fact.hpp>
 #include <orderedgoalsplanner/types/factstovalue.hpp>
@@ -53,6 +55,24 @@ struct ORDEREDGOALSPLANNER_API WorldState
                            const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
                            bool pCanFactsBeRemoved = true);
 
+  /**
+   * @brief Add or remove facts given one by one, without having to store them all before.<br/>
+   * The facts are moved in the world state and the notifications are done once all the facts are given.
+   * @param[in] pGetNextFact Called until it returns no fact. It returns the next fact and sets if it is negated, i.e. if it has to be removed.
+   * @param[out] pGoalStack Goal stacks that need to be refreshed.
+   * @param[in] pSetOfEvents events to apply indirect modifications according to the events.
+   * @param[in] pNow Current time.
+   * @return True if the world state has been modified.
+   */
+  bool modifyFacts(const std::function<std::optional<Fact> (bool&)>& pGetNextFact,
+                   GoalStack& pGoalStack,
+                   const std::map<SetOfEventsId, SetOfEvents>& pSetOfEvents,
+                   const SetOfCallbacks& pCallbacks,
+                   const Ontology& pOntology,
+                   const SetOfEntities& pEntities,
+                   const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                   bool pCanFactsBeRemoved = true);
+
   /**
    * @brief Notify that an action has been done.
    * @param[in] pParameters Effect parameters.
@@ -161,6 +181,7 @@ struct ORDEREDGOALSPLANNER_API WorldState
    * For example the current goal of the stack can be satisfied now and so maybe it should be removed from the goal stack.
    * @param[in] pSetOfEvents events to apply indirect modifications according to the events.
    * @param[in] pNow Current time.
+   * @param[in] pParametersToArgumentPtr Parameters of the modification to replace by their argument while applying it.
    */
   bool modify(const WorldStateModification* pWsModifPtr,
               GoalStack& pGoalStack,
@@ -169,7 +190,8 @@ struct ORDEREDGOALSPLANNER_API WorldState
               const Ontology& pOntology,
               const SetOfEntities& pEntities,
               const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
-              bool pCanFactsBeRemoved = true);
+              bool pCanFactsBeRemoved = true,
+              const std::map<Parameter, Entity>* pParametersToArgumentPtr = nullptr);
 
   /**
    * @brief Set the facts of the world.
@@ -318,8 +340,9 @@ private:
                  const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
                  bool pCanFactsBeRemoved);
 
+  template<typename FACT>
   void _addAFact(WhatChanged& pWhatChanged,
-                 const Fact& pFact,
+                 FACT&& pFact,
                  GoalStack& pGoalStack,
                  const std::map<SetOfEventsId, SetOfEvents>& pSetOfEvents,
                  const SetOfCallbacks& pCallbacks,
@@ -358,7 +381,8 @@ private:
                const Ontology& pOntology,
                const SetOfEntities& pEntities,
                const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
-               bool pCanFactsBeRemoved);
+               bool pCanFactsBeRemoved,
+               const std::map<Parameter, Entity>* pParametersToArgumentPtr = nullptr);
 
   /**
    * @brief Try to apply some events according to what changed in the world state.
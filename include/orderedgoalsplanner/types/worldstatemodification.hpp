@@ -89,9 +89,11 @@ struct ORDEREDGOALSPLANNER_API WorldStateModification
    * @brief Iterate over all the optional facts with fact value resolution according to the world state.
    * @param[in] pFactCallback Callback called for each optional fact of this object.
    * @param[in] pSetOfFact Facts to use to extract value of the facts.
+   * @param[in] pParametersToArgumentPtr Parameters to replace by their argument in the optional facts, without copying this object.
    */
   virtual void forAll(const std::function<void (const FactOptional&)>& pFactCallback,
-                      const SetOfFacts& pSetOfFact) const = 0;
+                      const SetOfFacts& pSetOfFact,
+                      const std::map<Parameter, Entity>* pParametersToArgumentPtr = nullptr) const = 0;
 
   virtual ContinueOrBreak forAllThatCanBeModified(const std::function<ContinueOrBreak (const FactOptional&)>& pFactCallback) const = 0;
 
@@ -143,9 +145,11 @@ struct ORDEREDGOALSPLANNER_API WorldStateModification
   /**
    * @brief Convert this world state modification to a value.
    * @param[in] pWorldState World state use to extract value of the facts.
+   * @param[in] pParametersToArgumentPtr Parameters to replace by their argument before extracting the value.
    * @return The world state modification converted to a string value.
    */
-  virtual std::optional<Entity> getFluent(const SetOfFacts& pSetOfFact) const = 0;
+  virtual std::optional<Entity> getFluent(const SetOfFacts& pSetOfFact,
+                                          const std::map<Parameter, Entity>* pParametersToArgumentPtr = nullptr) const = 0;
 
   /// Convert this world state modification to an optional fact if possible.
   virtual const FactOptional* getOptionalFact() const = 0;
@@ -0,0 +1,99 @@
+#ifndef INCLUDE_ORDEREDGOALSPLANNER_UTIL_SERIALIZER_BINARYSNAPSHOT_HPP
+#define INCLUDE_ORDEREDGOALSPLANNER_UTIL_SERIALIZER_BINARYSNAPSHOT_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "../api.hpp"
+
+namespace ogp
+{
+struct Domain;
+struct Problem;
+
+/// Version of the binary snapshot format. A snapshot written with another version cannot be loaded.
+const std::uint32_t binarySnapshotVersion = 2;
+
+
+/**
+ * @brief Convert a domain to a binary snapshot.
+ * @param[in] pDomain Domain to convert.
+ * @return Binary snapshot of the domain.
+ *
+ * The snapshot contains the symbols, the types, the predicates, the constants and the already compiled
+ * conditions and effects of the actions and of the events.<br/>
+ * It also contains the successions, the predecessors and the index of the preconditions of the domain,
+ * so they are not recomputed when the snapshot is loaded.
+ */
+ORDEREDGOALSPLANNER_API
+std::string domainToSnapshot(const Domain& pDomain);
+
+/**
+ * @brief Create a domain from a binary snapshot.
+ * @param[in] pData Beginning of the snapshot data. It can be a memory mapped file.
+ * @param[in] pSize Size of the snapshot data.
+ * @return Domain created.
+ *
+ * The symbols are read from the data without being copied, so the facts are built without being checked again.<br/>
+ * An exception is raised if the data is not a valid domain snapshot of the current version.
+ */
+ORDEREDGOALSPLANNER_API
+Domain snapshotToDomain(const char* pData,
+                        std::size_t pSize);
+
+ORDEREDGOALSPLANNER_API
+Domain snapshotToDomain(const std::string& pSnapshot);
+
+ORDEREDGOALSPLANNER_API
+void saveDomainSnapshot(const Domain& pDomain,
+                        const std::string& pFilename);
+
+ORDEREDGOALSPLANNER_API
+Domain loadDomainSnapshot(const std::string& pFilename);
+
+
+/**
+ * @brief Convert a problem to a binary snapshot.
+ * @param[in] pProblem Problem to convert.
+ * @param[in] pDomain Domain of the problem.
+ * @return Binary snapshot of the problem.
+ *
+ * The snapshot contains the name, the objects, the facts that can be removed and the goals of the problem.
+ */
+ORDEREDGOALSPLANNER_API
+std::string problemToSnapshot(const Problem& pProblem,
+                              const Domain& pDomain);
+
+/**
+ * @brief Create a problem from a binary snapshot.
+ * @param[in] pData Beginning of the snapshot data. It can be a memory mapped file.
+ * @param[in] pSize Size of the snapshot data.
+ * @param[in] pDomain Domain of the problem. It has to have the same name than the domain used to write the snapshot.
+ * @return Problem created.
+ *
+ * An exception is raised if the data is not a valid problem snapshot of the current version.
+ */
+ORDEREDGOALSPLANNER_API
+std::unique_ptr<Problem> snapshotToProblem(const char* pData,
+                                           std::size_t pSize,
+                                           const Domain& pDomain);
+
+ORDEREDGOALSPLANNER_API
+std::unique_ptr<Problem> snapshotToProblem(const std::string& pSnapshot,
+                                           const Domain& pDomain);
+
+ORDEREDGOALSPLANNER_API
+void saveProblemSnapshot(const Problem& pProblem,
+                         const Domain& pDomain,
+                         const std::string& pFilename);
+
+ORDEREDGOALSPLANNER_API
+std::unique_ptr<Problem> loadProblemSnapshot(const std::string& pFilename,
+                                             const Domain& pDomain);
+
+
+} // End of namespace ogp
+
+
+
+#endif // INCLUDE_ORDEREDGOALSPLANNER_UTIL_SERIALIZER_BINARYSNAPSHOT_HPP
@@ -1,6 +1,7 @@
 #ifndef INCLUDE_ORDEREDGOALSPLANNER_UTIL_SERIALIZER_DESERIALIZEFROMPDDL_HPP
 #define INCLUDE_ORDEREDGOALSPLANNER_UTIL_SERIALIZER_DESERIALIZEFROMPDDL_HPP
 
+#include <iosfwd>
 #include <map>
 #include <memory>
 #include <string>
@@ -31,6 +32,29 @@ Domain pddlToDomain(const std::string& pStr,
 DomainAndProblemPtrs pddlToProblem(const std::string& pStr,
                                    const std::map<std::string, Domain>& pPreviousDomains);
 
+/**
+ * @brief Create a problem from a PDDL content read progressively from a stream, for example a file.
+ * @param[in] pInput Stream containing the PDDL content.
+ * @param[in] pPreviousDomains Loaded domains that can be used by the problem.
+ * @return Domain and problem created.
+ *
+ * The facts of the ":init" section are read and added to the world state one by one,
+ * so the whole content is never in memory.
+ */
+DomainAndProblemPtrs pddlToProblem(std::istream& pInput,
+                                   const std::map<std::string, Domain>& pPreviousDomains);
+
+/**
+ * @brief Fill a problem of a loaded domain from a PDDL content read progressively from a stream.<br/>
+ * Contrary to the other overloads, the domain is not copied, so many problems can be loaded for the same domain.
+ * @param[out] pProblem Problem to fill. It is usually constructed with the timeless facts of the domain.
+ * @param[in] pInput Stream containing the PDDL content.
+ * @param[in] pDomain Domain of the problem. The PDDL content has to refer to it by its name.
+ */
+void pddlToProblem(Problem& pProblem,
+                   std::istream& pInput,
+                   const Domain& pDomain);
+
 
 std::unique_ptr<Condition> pddlToCondition(const std::string& pStr,
                                            std::size_t& pPos,
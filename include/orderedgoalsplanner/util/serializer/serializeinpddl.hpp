@@ -1,6 +1,7 @@
 #ifndef INCLUDE_ORDEREDGOALSPLANNER_UTIL_SERIALIZER_SERIALIZEINPDDL_HPP
 #define INCLUDE_ORDEREDGOALSPLANNER_UTIL_SERIALIZER_SERIALIZEINPDDL_HPP
 
+#include <iosfwd>
 #include <string>
 
 namespace ogp
@@ -12,9 +13,18 @@ struct Problem;
 
 std::string domainToPddl(const Domain& pDomain);
 
+/// Write a domain in PDDL directly in an output stream, without building the whole content in a string.
+void domainToPddl(std::ostream& pOutput,
+                  const Domain& pDomain);
+
 std::string problemToPddl(const Problem& pProblem,
                           const Domain& pDomain);
 
+/// Write a problem in PDDL directly in an output stream. The facts of the world state are written one by one.
+void problemToPddl(std::ostream& pOutput,
+                   const Problem& pProblem,
+                   const Domain& pDomain);
+
 
 std::string conditionToPddl(const Condition& pCondition,
                             std::size_t pIdentation);
@@ -44,6 +44,18 @@ std::string numberToString(const Number& num);
 
 extern bool ORDEREDGOALSPLANNER_DEBUG_FOR_TESTS;
 
+/**
+ * @brief Set the maximum number of threads used to split the internal computations of the library,
+ * like the succession caches of a domain or the facts of a PDDL problem.
+ * @param[in] pMaxNbOfThreads Maximum number of threads. 0, the default value, means the number of threads supported by the hardware.
+ */
+ORDEREDGOALSPLANNER_API
+void setMaxNbOfThreads(std::size_t pMaxNbOfThreads);
+
+/// Get the maximum number of threads used to split the internal computations of the library.
+ORDEREDGOALSPLANNER_API
+std::size_t getMaxNbOfThreads();
+
 ORDEREDGOALSPLANNER_API
 bool isNumber(const std::string& str);
 
@@ -75,6 +87,12 @@ bool compIntNb(const std::string& pNb1Str,
                bool pBoolSuperiorOrInferior,
                bool pCanBeEqual);
 
+ORDEREDGOALSPLANNER_API
+bool compIntNb(const Entity& pNb1,
+               const Number& pNb2,
+               bool pBoolSuperiorOrInferior,
+               bool pCanBeEqual);
+
 ORDEREDGOALSPLANNER_API
 std::string incrementLastNumberUntilAConditionIsSatisfied(
     const std::string& pStr,
@@ -98,6 +116,15 @@ ORDEREDGOALSPLANNER_API
 void trim(std::string& s);
 
 
+/// Mix the hash of a value into an accumulated hash.
+template <typename T>
+void hashCombine(std::size_t& pSeed,
+                 const T& pValue)
+{
+  pSeed ^= std::hash<T>()(pValue) + 0x9e3779b9 + (pSeed << 6) + (pSeed >> 2);
+}
+
+
 template <typename T>
 bool areUPtrEqual(const std::unique_ptr<T>& pPtr1,
                   const std::unique_ptr<T>& pPtr2)
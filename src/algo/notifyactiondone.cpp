@@ -78,12 +78,9 @@ void updateProblemForNextPotentialPlannerResultWithAction(
                              pLookForAnActionOutputInfosPtr);
 
   if (pOneStepAction.effect.potentialWorldStateModification)
-  {
-    auto potentialEffect = pOneStepAction.effect.potentialWorldStateModification->clone(&pOneStepOfPlannerResult.actionInvocation.parameters);
-    if (potentialEffect)
-      pProblem.worldState.modify(&*potentialEffect, pProblem.goalStack, setOfEvents,
-                                 callbacks, ontology, pProblem.entities, pNow);
-  }
+    pProblem.worldState.modify(&*pOneStepAction.effect.potentialWorldStateModification, pProblem.goalStack, setOfEvents,
+                               callbacks, ontology, pProblem.entities, pNow, true,
+                               &pOneStepOfPlannerResult.actionInvocation.parameters);
 }
 
 
@@ -1,12 +1,17 @@
 #include <orderedgoalsplanner/orderedgoalsplanner.hpp>
 #include <algorithm>
-#include <iomanip>
+#include <atomic>
 #include <optional>
+#include <ostream>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
 #include <orderedgoalsplanner/types/parallelplan.hpp>
 #include <orderedgoalsplanner/types/setofevents.hpp>
 #include <orderedgoalsplanner/util/util.hpp>
 #include "types/factsalreadychecked.hpp"
 #include "types/treeofalreadydonepaths.hpp"
+#include "util/parallelfor.hpp"
 #include "algo/actiondataforparallelisation.hpp"
 #include "algo/converttoparallelplan.hpp"
 #include "algo/notifyactiondone.hpp"
@@ -24,6 +29,44 @@ enum class PossibleEffect
   NOT_SATISFIED
 };
 
+/// Stop flag of the planification that runs on the current thread, or nullptr if it cannot be stopped.
+thread_local const std::atomic<bool>* _stopRequestedPtr = nullptr;
+
+/// Set the stop flag of the planifications that run on the current thread while this object is alive.
+struct StopRequestedScope
+{
+  StopRequestedScope(const std::atomic<bool>* pStopRequestedPtr)
+    : _previousStopRequestedPtr(_stopRequestedPtr)
+  {
+    _stopRequestedPtr = pStopRequestedPtr;
+  }
+
+  ~StopRequestedScope()
+  {
+    _stopRequestedPtr = _previousStopRequestedPtr;
+  }
+
+private:
+  const std::atomic<bool>* _previousStopRequestedPtr;
+};
+
+/// Throw if the stop of the planification that runs on the current thread is requested, to unwind the search.
+void _throwIfStopRequested()
+{
+  if (_stopRequestedPtr != nullptr && _stopRequestedPtr->load(std::memory_order_relaxed))
+    throw std::runtime_error("The planification is stopped");
+}
+
+
+/// Write the index of a plan step with at least 2 digits.
+void _writePlanStep(std::ostream& pOutput,
+                    std::size_t pStep)
+{
+  if (pStep < 10)
+    pOutput << '0';
+  pOutput << pStep << ": ";
+}
+
 PossibleEffect _merge(PossibleEffect pEff1,
                       PossibleEffect pEff2)
 {
@@ -143,26 +186,24 @@ PotentialNextAction::PotentialNextAction(const ActionId& pActionId,
 }
 
 
+/// The actions and events to consider are read from the cache of the goal. (computed once per domain)
 struct ResearchContext
 {
   ResearchContext(const Goal& pGoal,
                   const Problem& pProblem,
-                  const Domain& pDomain,
-                  const std::set<ActionId>& pActionIds,
-                  const std::set<FullEventId>& pFullEventIds)
+                  const Domain& pDomain)
     : goal(pGoal),
       problem(pProblem),
-      domain(pDomain),
-      actionIds(pActionIds),
-      fullEventIds(pFullEventIds)
+      domain(pDomain)
   {
   }
 
+  bool canUseAction(const Action& pAction) const { return goal.isActionPredecessor(pAction.indexInDomainCache); }
+  bool canUseEvent(const Event& pEvent) const { return goal.isEventPredecessor(pEvent.indexInDomainCache); }
+
   const Goal& goal;
   const Problem& problem;
   const Domain& domain;
-  const std::set<ActionId>& actionIds;
-  const std::set<FullEventId>& fullEventIds;
 };
 
 
@@ -275,24 +316,32 @@ bool PotentialNextAction::isMoreImportantThan(const PotentialNextAction& pOther,
 }
 
 
-std::set<Entity> _paramTypenameToEntities(const std::string& pParamtypename,
-                                          const Domain& pDomain,
-                                          const Problem& pProblem)
+/// Entities of a parameter type, as references to the precomputed tables of the constants and of the problem.
+struct EntitiesOfATypeView
 {
-  std::set<Entity> res;
-  auto* constantsPtr = pDomain.getOntology().constants.typeNameToEntities(pParamtypename);
-  if (constantsPtr != nullptr)
-    res = *constantsPtr;
+  const std::vector<Entity>* constantsPtr;
+  const std::vector<Entity>* entitiesPtr;
+
+  bool empty() const { return (constantsPtr == nullptr || constantsPtr->empty()) && (entitiesPtr == nullptr || entitiesPtr->empty()); }
 
-  auto* entitiesPtr = pProblem.entities.typeNameToEntities(pParamtypename);
-  if (entitiesPtr != nullptr)
+  /// Copy the entities in parameter candidates. The tables are sorted so the insertions are done at the end of the set.
+  void insertIn(std::set<Entity>& pRes) const
   {
-    if (res.empty())
-      res = *entitiesPtr;
-    else
-      res.insert(entitiesPtr->begin(), entitiesPtr->end());
+    if (constantsPtr != nullptr)
+      for (const auto& currEntity : *constantsPtr)
+        pRes.insert(pRes.end(), currEntity);
+    if (entitiesPtr != nullptr)
+      for (const auto& currEntity : *entitiesPtr)
+        pRes.insert(pRes.end(), currEntity);
   }
-  return res;
+};
+
+EntitiesOfATypeView _paramTypenameToEntities(const std::string& pParamtypename,
+                                             const Domain& pDomain,
+                                             const Problem& pProblem)
+{
+  return {pDomain.getOntology().constants.typeNameToEntitiesWithSubTypes(pParamtypename),
+          pProblem.entities.typeNameToEntitiesWithSubTypes(pParamtypename)};
 }
 
 
@@ -361,9 +410,14 @@ PossibleEffect _lookForAPossibleDeduction(TreeOfAlreadyDonePath& pTreeOfAlreadyD
 
             if (foundSomethingThatMatched && newParamValues.empty())
             {
-              if (pParameter.type)
-                newParamValues = _paramTypenameToEntities(pParameter.type->name, pContext.domain, pContext.problem);
-              return !newParamValues.empty();
+              if (!pParameter.type)
+                return false;
+              const auto entitiesOfTheType = _paramTypenameToEntities(pParameter.type->name, pContext.domain, pContext.problem);
+              if (entitiesOfTheType.empty())
+                return false;
+              // The candidates are only copied when there are some
+              entitiesOfTheType.insertIn(newParamValues);
+              return true;
             }
           }
           return true;
@@ -460,11 +514,8 @@ void _lookForAPossibleExistingOrNotFactFromActionsAndEvents(
   auto& actions = pContext.domain.actions();
   for (const auto& currActionId : pActionSuccessions)
   {
-    if (pContext.actionIds.count(currActionId) == 0)
-      continue;
-
     auto itAction = actions.find(currActionId);
-    if (itAction != actions.end())
+    if (itAction != actions.end() && pContext.canUseAction(itAction->second))
     {
       auto cpParentParameters = pParentParameters;
       std::map<Parameter, std::set<Entity>> cpTmpParameters;
@@ -504,11 +555,9 @@ void _lookForAPossibleExistingOrNotFactFromActionsAndEvents(
         if (itEvent != currInfrences.end())
         {
           auto& event = itEvent->second;
-          if (event.factsToModify)
+          if (event.factsToModify && pContext.canUseEvent(event))
           {
             auto fullEventId = generateFullEventId(currSetOfEventsSucc.first, currEventIdSucc);
-            if (pContext.fullEventIds.count(fullEventId) == 0)
-              continue;
 
             auto cpParentParameters = pParentParameters;
             std::map<Parameter, std::set<Entity>> cpTmpParameters;
@@ -599,9 +648,14 @@ bool _checkObjectiveCallback(std::map<Parameter, std::set<Entity>>& pParameters,
 
       if (foundSomethingThatMatched && newParamValues.empty())
       {
-        if (pParameter.type)
-          newParamValues = _paramTypenameToEntities(pParameter.type->name, pContext.domain, pContext.problem);
-        return !newParamValues.empty();
+        if (!pParameter.type)
+          return false;
+        const auto entitiesOfTheType = _paramTypenameToEntities(pParameter.type->name, pContext.domain, pContext.problem);
+        if (entitiesOfTheType.empty())
+          return false;
+        // The candidates are only copied when there are some
+        entitiesOfTheType.insertIn(newParamValues);
+        return true;
       }
     }
     return true;
@@ -779,7 +833,7 @@ PlanCost _extractPlanCost(
     const ActionPtrWithGoal* pPreviousActionPtr)
 {
   PlanCost res;
-  std::set<std::string> actionAlreadyInPlan;
+  std::unordered_set<ActionInvocation> actionAlreadyInPlan;
   bool shouldBreak = false;
   while (!pProblem.goalStack.goals().empty())
   {
@@ -795,10 +849,8 @@ PlanCost _extractPlanCost(
     for (const auto& currActionInSubPlan : subPlan)
     {
       ++res.nbOfActionDones;
-      const auto& actionToDoStr = currActionInSubPlan.actionInvocation.toStr();
-      if (actionAlreadyInPlan.count(actionToDoStr) > 0)
+      if (!actionAlreadyInPlan.insert(currActionInSubPlan.actionInvocation).second)
         shouldBreak = true;
-      actionAlreadyInPlan.insert(actionToDoStr);
       bool goalChanged = false;
       updateProblemForNextPotentialPlannerResult(pProblem, goalChanged, currActionInSubPlan, pDomain, pNow, pGlobalHistorical,
                                                  &pLookForAnActionOutputInfos);
@@ -906,12 +958,12 @@ ActionId _findFirstActionForAGoal(
     actionIdsToSkip = pPreviousActionPtr->actionPtr->actionsSuccessionsWithoutInterestCache;
   std::optional<PotentialNextActionComparisonCache> potentialNextActionComparisonCacheOpt;
 
-  ResearchContext context(pGoal, pProblem, pDomain,
-                          pGoal.getActionsPredecessors(), pGoal.getEventsPredecessors());
+  ResearchContext context(pGoal, pProblem, pDomain);
 
   auto& domainActions = pDomain.actions();
-  for (const ActionId& currActionId : context.actionIds)
+  for (const ActionId& currActionId : pGoal.getActionsPredecessors())
   {
+    _throwIfStopRequested();
     if (actionIdsToSkip.count(currActionId) > 0)
       continue;
 
@@ -935,6 +987,7 @@ ActionId _findFirstActionForAGoal(
         {
           while (true)
           {
+            _throwIfStopRequested();
             if (_isMoreOptimalNextAction(potentialNextActionComparisonCacheOpt, pNextInPlanCanBeAnEvent, newPotRes, res, pProblem, pDomain, dataRelatedToOptimisation, pLength, pGoal, pGlobalHistorical))
             {
               assert(newPotRes.actionPtr != nullptr);
@@ -955,7 +1008,7 @@ ActionId _findFirstActionForAGoal(
 bool _goalToPlanRec(
     std::list<ActionInvocationWithGoal>& pActionInvocations,
     Problem& pProblem,
-    std::map<std::string, std::size_t>& pActionAlreadyInPlan,
+    std::unordered_map<ActionInvocation, std::size_t>& pActionAlreadyInPlan,
     const Domain& pDomain,
     bool pTryToDoMoreOptimalSolution,
     const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
@@ -964,6 +1017,7 @@ bool _goalToPlanRec(
     int pPriority,
     const ActionPtrWithGoal* pPreviousActionPtr)
 {
+  _throwIfStopRequested();
   pProblem.worldState.refreshCacheIfNeeded(pDomain);
   TreeOfAlreadyDonePath treeOfAlreadyDonePath;
 
@@ -981,11 +1035,10 @@ bool _goalToPlanRec(
 
   if (potentialRes && potentialRes->fromGoal)
   {
-    const auto& actionToDoStr = potentialRes->actionInvocation.toStr();
-    auto itAlreadyFoundAction = pActionAlreadyInPlan.find(actionToDoStr);
+    auto itAlreadyFoundAction = pActionAlreadyInPlan.find(potentialRes->actionInvocation);
     if (itAlreadyFoundAction == pActionAlreadyInPlan.end())
     {
-      pActionAlreadyInPlan[actionToDoStr] = 1;
+      pActionAlreadyInPlan.emplace(potentialRes->actionInvocation, 1);
     }
     else
     {
@@ -1031,12 +1084,18 @@ std::list<ActionInvocationWithGoal> _planForMoreImportantGoalPossible(Problem& p
                                                                      const ActionPtrWithGoal* pPreviousActionPtr)
 {
   std::list<ActionInvocationWithGoal> res;
+  // The comparisons of the potential actions read a snapshot of the global historical, so they never lock it
+  std::optional<Historical> globalHistoricalSnapshot;
+  if (pGlobalHistorical != nullptr)
+    globalHistoricalSnapshot.emplace(pGlobalHistorical->snapshot());
+  const Historical* globalHistoricalSnapshotPtr = globalHistoricalSnapshot ? &*globalHistoricalSnapshot : nullptr;
+
   pProblem.goalStack.refreshIfNeeded(pDomain);
   pProblem.goalStack.iterateOnGoalsAndRemoveNonPersistent(
         [&](const Goal& pGoal, int pPriority){
-            std::map<std::string, std::size_t> actionAlreadyInPlan;
+            std::unordered_map<ActionInvocation, std::size_t> actionAlreadyInPlan;
             return _goalToPlanRec(res, pProblem, actionAlreadyInPlan,
-                                  pDomain, pTryToDoMoreOptimalSolution, pNow, pGlobalHistorical, pGoal, pPriority,
+                                  pDomain, pTryToDoMoreOptimalSolution, pNow, globalHistoricalSnapshotPtr, pGoal, pPriority,
                                   pPreviousActionPtr);
           },
         pProblem.worldState, pNow,
@@ -1044,6 +1103,117 @@ std::list<ActionInvocationWithGoal> _planForMoreImportantGoalPossible(Problem& p
   return res;
 }
 
+
+/// Run a planification with an executor and get its result in a future.
+template<typename FUNCTION>
+std::future<std::list<ActionInvocationWithGoal>> _planAsync(FUNCTION&& pPlanFunction,
+                                                            const PlanningExecutor& pExecutor,
+                                                            const std::shared_ptr<std::atomic<bool>>& pStopRequested)
+{
+  auto planFunctionWithStop = [planFunction = std::forward<FUNCTION>(pPlanFunction), stopRequested = pStopRequested]() mutable {
+    StopRequestedScope stopRequestedScope(stopRequested.get());
+    return planFunction();
+  };
+  // Without executor, the future waits for the end of the planification in its destructor so the domain is not released before
+  if (!pExecutor)
+    return std::async(std::launch::async, std::move(planFunctionWithStop));
+
+  // The std::function given to the executor has to be copyable, so the packaged task is shared
+  auto taskPtr = std::make_shared<std::packaged_task<std::list<ActionInvocationWithGoal>()>>(std::move(planFunctionWithStop));
+  auto res = taskPtr->get_future();
+  pExecutor([taskPtr]() { (*taskPtr)(); });
+  return res;
+}
+
+
+std::unique_ptr<std::chrono::steady_clock::time_point> _copyNow(const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow)
+{
+  if (pNow)
+    return std::make_unique<std::chrono::steady_clock::time_point>(*pNow);
+  return {};
+}
+
+
+/// Check if the precondition of a plan step is true in the world state of a problem.
+bool _isStepExecutable(const ActionInvocationWithGoal& pStep,
+                       const Problem& pProblem,
+                       const Domain& pDomain)
+{
+  auto* actionPtr = pDomain.getActionPtr(pStep.actionInvocation.actionId);
+  if (actionPtr == nullptr)
+    return false;
+  return !actionPtr->precondition ||
+      actionPtr->precondition->clone(&pStep.actionInvocation.parameters)->isTrue(pProblem.worldState);
+}
+
+
+/// Apply plan steps to a problem. Returns false if a step is not executable.
+bool _applyExecutableSteps(Problem& pProblem,
+                           const Domain& pDomain,
+                           const std::list<ActionInvocationWithGoal>& pSteps,
+                           const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow)
+{
+  for (const auto& currStep : pSteps)
+  {
+    if (!_isStepExecutable(currStep, pProblem, pDomain))
+      return false;
+    bool goalChanged = false;
+    updateProblemForNextPotentialPlannerResult(pProblem, goalChanged, currStep, pDomain, pNow, nullptr, nullptr);
+  }
+  return true;
+}
+
+
+/// Check that the goals that motivated some plan steps are satisfied or not in the goal stack anymore.
+bool _areGoalsOfStepsDone(const Problem& pProblem,
+                          std::list<ActionInvocationWithGoal>::const_iterator pStepsBegin,
+                          std::list<ActionInvocationWithGoal>::const_iterator pStepsEnd)
+{
+  for (auto itStep = pStepsBegin; itStep != pStepsEnd; ++itStep)
+  {
+    if (!itStep->fromGoal || pProblem.worldState.isGoalSatisfied(*itStep->fromGoal))
+      continue;
+    for (const auto& currGoalsGroup : pProblem.goalStack.goals())
+      for (const auto& currGoal : currGoalsGroup.second)
+        if (currGoal == *itStep->fromGoal)
+          return false;
+  }
+  return true;
+}
+
+
+/// Maximum number of steps of a previous plan to which a bridge is searched, because each search is a planification.
+const std::size_t _maxNbOfBridgesToSearch = 8;
+
+/// Plan the steps that make a plan step executable. Returns nothing if they are not found.
+std::optional<std::list<ActionInvocationWithGoal>> _planBridgeToStep(
+    Problem& pProblem,
+    const Domain& pDomain,
+    const ActionInvocationWithGoal& pStep,
+    const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+    const Historical* pGlobalHistorical)
+{
+  auto* actionPtr = pDomain.getActionPtr(pStep.actionInvocation.actionId);
+  if (actionPtr == nullptr)
+    return {};
+  std::list<ActionInvocationWithGoal> res;
+  if (!actionPtr->precondition)
+    return res;
+  Goal bridgeGoal(actionPtr->precondition->clone(&pStep.actionInvocation.parameters));
+  if (pProblem.worldState.isGoalSatisfied(bridgeGoal))
+    return res;
+
+  bridgeGoal.refreshIfNeeded(pDomain);
+  std::unordered_map<ActionInvocation, std::size_t> actionAlreadyInPlan;
+  if (!_goalToPlanRec(res, pProblem, actionAlreadyInPlan, pDomain, true, pNow, pGlobalHistorical,
+                      bridgeGoal, pStep.fromGoalPriority, nullptr))
+    return {};
+  // The bridge is motivated by the goal of the step that it makes executable
+  for (auto& currBridgeStep : res)
+    currBridgeStep.fromGoal = pStep.fromGoal ? pStep.fromGoal->clone() : std::unique_ptr<Goal>();
+  return res;
+}
+
 }
 
 
@@ -1088,12 +1258,11 @@ void notifyActionStarted(Problem& pProblem,
   {
     if (itAction->second.effect.worldStateModificationAtStart)
     {
-      auto worldStateModificationAtStart = itAction->second.effect.worldStateModificationAtStart->clone(&pActionInvocationWithGoal.actionInvocation.parameters);
       auto& setOfEvents = pDomain.getSetOfEvents();
       const auto& ontology = pDomain.getOntology();
-      if (worldStateModificationAtStart)
-        pProblem.worldState.modify(&*worldStateModificationAtStart, pProblem.goalStack, setOfEvents,
-                                   pCallbacks, ontology, pProblem.entities, pNow);
+      pProblem.worldState.modify(&*itAction->second.effect.worldStateModificationAtStart, pProblem.goalStack, setOfEvents,
+                                 pCallbacks, ontology, pProblem.entities, pNow, true,
+                                 &pActionInvocationWithGoal.actionInvocation.parameters);
     }
   }
 }
@@ -1131,44 +1300,327 @@ std::list<ActionInvocationWithGoal> planForEveryGoals(
     Historical* pGlobalHistorical,
     std::list<Goal>* pGoalsDonePtr)
 {
-  const bool tryToDoMoreOptimalSolution = true;
-  std::map<std::string, std::size_t> actionAlreadyInPlan;
   std::list<ActionInvocationWithGoal> res;
-  LookForAnActionOutputInfos lookForAnActionOutputInfos;
-  while (!pProblem.goalStack.goals().empty())
+  PlanStepGenerator planStepGenerator(pProblem, pDomain, pNow, pGlobalHistorical);
+  while (auto step = planStepGenerator.next())
+    res.emplace_back(std::move(*step));
+  if (pGoalsDonePtr != nullptr)
+    planStepGenerator.moveGoalsDone(*pGoalsDonePtr);
+  return res;
+}
+
+
+struct PlanStepGenerator::Speculation
+{
+  /// Stop the search if it is still running, the destructor of the future waits only until the search sees it.
+  ~Speculation() { stopRequested = true; }
+
+  /// State predicted at the end of the current sub-plan.
+  struct PredictedState
   {
-    auto subPlan = _planForMoreImportantGoalPossible(pProblem, pDomain, tryToDoMoreOptimalSolution,
-                                                     pNow, pGlobalHistorical, &lookForAnActionOutputInfos, nullptr);
-    if (subPlan.empty())
-      break;
-    for (auto& currActionInSubPlan : subPlan)
+    std::map<Fact, bool> facts;
+    std::map<int, std::vector<Goal>> goals;
+  };
+
+  /// Set when the result of the speculation is not needed anymore, the search checks it.
+  std::atomic<bool> stopRequested{false};
+  /// State predicted at the end of the current sub-plan. It is ready before the sub-plan of the next goal.
+  std::future<PredictedState> predictedState;
+  /// Sub-plan of the next goal from the predicted state.
+  std::future<std::list<ActionInvocationWithGoal>> subPlan;
+};
+
+
+PlanStepGenerator::PlanStepGenerator(Problem& pProblem,
+                                     const Domain& pDomain,
+                                     const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                                     Historical* pGlobalHistorical,
+                                     bool pSpeculateNextGoal)
+  : _problem(pProblem),
+    _domain(pDomain),
+    _now(_copyNow(pNow)),
+    _globalHistorical(pGlobalHistorical),
+    _actionAlreadyInPlan(),
+    _lookForAnActionOutputInfos(),
+    _stepsOfCurrentSubPlan(),
+    _isFinished(false),
+    _speculateNextGoal(pSpeculateNextGoal),
+    _speculationPtr(),
+    _nbOfSpeculationsUsed(0)
+{
+}
+
+
+PlanStepGenerator::~PlanStepGenerator()
+{
+  // The destructor of the speculation requests the stop of its search, then waits for its end
+}
+
+
+void PlanStepGenerator::_startSpeculation()
+{
+  _speculationPtr = std::make_unique<Speculation>();
+  // The global historical of the prediction is a snapshot, so the real one is only notified by the real steps
+  std::optional<Historical> predictedGlobalHistorical;
+  if (_globalHistorical != nullptr)
+    predictedGlobalHistorical.emplace(_globalHistorical->snapshot());
+  std::promise<Speculation::PredictedState> predictedStatePromise;
+  _speculationPtr->predictedState = predictedStatePromise.get_future();
+  // Only the copies are done on this thread, the prediction of the state is done with the search
+  _speculationPtr->subPlan = std::async(std::launch::async,
+                                        [problem = _problem, steps = _stepsOfCurrentSubPlan, &domain = _domain, now = _copyNow(_now),
+                                         globalHistorical = std::move(predictedGlobalHistorical),
+                                         predictedStatePromise = std::move(predictedStatePromise),
+                                         stopRequestedPtr = &_speculationPtr->stopRequested]() mutable {
+    Historical* globalHistoricalPtr = globalHistorical ? &*globalHistorical : nullptr;
+    LookForAnActionOutputInfos lookForAnActionOutputInfos;
+    for (const auto& currStep : steps)
     {
-      const auto& actionToDoStr = currActionInSubPlan.actionInvocation.toStr();
-      auto itAlreadyFoundAction = actionAlreadyInPlan.find(actionToDoStr);
-      if (itAlreadyFoundAction == actionAlreadyInPlan.end())
+      bool goalChanged = false;
+      updateProblemForNextPotentialPlannerResult(problem, goalChanged, currStep, domain, now, globalHistoricalPtr,
+                                                 &lookForAnActionOutputInfos);
+      if (goalChanged)
+        break;
+    }
+    predictedStatePromise.set_value(Speculation::PredictedState{problem.worldState.facts(), problem.goalStack.goals()});
+    if (problem.goalStack.goals().empty())
+      return std::list<ActionInvocationWithGoal>();
+
+    StopRequestedScope stopRequestedScope(stopRequestedPtr);
+    LookForAnActionOutputInfos nextGoalLookForAnActionOutputInfos;
+    return _planForMoreImportantGoalPossible(problem, domain, true, now, globalHistoricalPtr,
+                                             &nextGoalLookForAnActionOutputInfos, nullptr);
+  });
+}
+
+
+bool PlanStepGenerator::_useSpeculation()
+{
+  auto speculationPtr = std::move(_speculationPtr);
+  if (!speculationPtr)
+    return false;
+
+  std::list<ActionInvocationWithGoal> subPlan;
+  try
+  {
+    auto predictedState = speculationPtr->predictedState.get();
+    if (predictedState.facts != _problem.worldState.facts() ||
+        predictedState.goals != _problem.goalStack.goals())
+      return false; // The speculation is stopped when it is destroyed
+    subPlan = speculationPtr->subPlan.get();
+  }
+  catch (...)
+  {
+    return false; // The planification will be done again, without speculation
+  }
+
+  // Apply to the goal stack what the planification did, without searching again
+  const Goal* goalOfSubPlanPtr = !subPlan.empty() && subPlan.front().fromGoal ? &*subPlan.front().fromGoal : nullptr;
+  _problem.goalStack.refreshIfNeeded(_domain);
+  _problem.goalStack.iterateOnGoalsAndRemoveNonPersistent(
+        [&](const Goal& pGoal, int){ return goalOfSubPlanPtr != nullptr && pGoal == *goalOfSubPlanPtr; },
+        _problem.worldState, _now, &_lookForAnActionOutputInfos);
+  _stepsOfCurrentSubPlan = std::move(subPlan);
+  ++_nbOfSpeculationsUsed;
+  return true;
+}
+
+
+std::optional<ActionInvocationWithGoal> PlanStepGenerator::next()
+{
+  while (!_isFinished)
+  {
+    if (_stepsOfCurrentSubPlan.empty())
+    {
+      if (_problem.goalStack.goals().empty())
+        break;
+      if (!_useSpeculation())
       {
-        actionAlreadyInPlan[actionToDoStr] = 1;
+        const bool tryToDoMoreOptimalSolution = true;
+        _stepsOfCurrentSubPlan = _planForMoreImportantGoalPossible(_problem, _domain, tryToDoMoreOptimalSolution,
+                                                                   _now, _globalHistorical, &_lookForAnActionOutputInfos, nullptr);
       }
-      else
+      if (_stepsOfCurrentSubPlan.empty())
+        break;
+      if (_speculateNextGoal)
+        _startSpeculation();
+    }
+
+    auto res = std::move(_stepsOfCurrentSubPlan.front());
+    _stepsOfCurrentSubPlan.pop_front();
+    auto itAlreadyFoundAction = _actionAlreadyInPlan.find(res.actionInvocation);
+    if (itAlreadyFoundAction == _actionAlreadyInPlan.end())
+    {
+      _actionAlreadyInPlan.emplace(res.actionInvocation, 1);
+    }
+    else
+    {
+      if (itAlreadyFoundAction->second > 10)
       {
-        if (itAlreadyFoundAction->second > 10)
-          break;
-        ++itAlreadyFoundAction->second;
+        // Drop the end of this sub-plan and plan again
+        _stepsOfCurrentSubPlan.clear();
+        continue;
       }
-      bool goalChanged = false;
-      updateProblemForNextPotentialPlannerResult(pProblem, goalChanged, currActionInSubPlan, pDomain, pNow, pGlobalHistorical,
-                                                 &lookForAnActionOutputInfos);
-      res.emplace_back(std::move(currActionInSubPlan));
-      if (goalChanged)
+      ++itAlreadyFoundAction->second;
+    }
+    bool goalChanged = false;
+    updateProblemForNextPotentialPlannerResult(_problem, goalChanged, res, _domain, _now, _globalHistorical,
+                                               &_lookForAnActionOutputInfos);
+    if (goalChanged)
+      _stepsOfCurrentSubPlan.clear();
+    return res;
+  }
+  _isFinished = true;
+  return {};
+}
+
+
+std::list<ActionInvocationWithGoal> repairPlan(
+    Problem& pProblem,
+    const Domain& pDomain,
+    const std::list<ActionInvocationWithGoal>& pPreviousPlan,
+    const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+    Historical* pGlobalHistorical,
+    std::list<Goal>* pGoalsDonePtr)
+{
+  // Keep the beginning of the previous plan while it is executable
+  Problem simulatedProblem = pProblem;
+  // Refresh the goals to be able to compare them with the goals of the previous plan
+  simulatedProblem.goalStack.refreshIfNeeded(pDomain);
+  auto itInvalidStep = pPreviousPlan.begin();
+  while (itInvalidStep != pPreviousPlan.end() &&
+         !simulatedProblem.goalStack.goals().empty() &&
+         _isStepExecutable(*itInvalidStep, simulatedProblem, pDomain))
+  {
+    bool goalChanged = false;
+    updateProblemForNextPotentialPlannerResult(simulatedProblem, goalChanged, *itInvalidStep, pDomain, pNow, nullptr, nullptr);
+    ++itInvalidStep;
+  }
+  std::list<ActionInvocationWithGoal> repairedSteps(pPreviousPlan.begin(), itInvalidStep);
+
+  if (itInvalidStep != pPreviousPlan.end() &&
+      !simulatedProblem.goalStack.goals().empty())
+  {
+    std::optional<Historical> globalHistoricalSnapshot;
+    if (pGlobalHistorical != nullptr)
+      globalHistoricalSnapshot.emplace(pGlobalHistorical->snapshot());
+    const Historical* globalHistoricalSnapshotPtr = globalHistoricalSnapshot ? &*globalHistoricalSnapshot : nullptr;
+
+    // Look for the bridge from the current state to the end of the previous plan that gives the shortest plan
+    std::optional<std::list<ActionInvocationWithGoal>> bestBridgeAndSuffix;
+    std::size_t suffixSize = 0;
+    for (auto itSuffixBegin = pPreviousPlan.end(); itSuffixBegin != itInvalidStep && suffixSize < _maxNbOfBridgesToSearch;)
+    {
+      --itSuffixBegin;
+      ++suffixSize;
+      // The next suffixes are longer than the best plan found
+      if (bestBridgeAndSuffix && suffixSize > bestBridgeAndSuffix->size())
         break;
+      auto bridgeAndSuffix = _planBridgeToStep(simulatedProblem, pDomain, *itSuffixBegin, pNow, globalHistoricalSnapshotPtr);
+      if (!bridgeAndSuffix ||
+          (bestBridgeAndSuffix && bridgeAndSuffix->size() + suffixSize > bestBridgeAndSuffix->size()))
+        continue;
+      bridgeAndSuffix->insert(bridgeAndSuffix->end(), itSuffixBegin, pPreviousPlan.end());
+
+      auto problemAfterRepair = simulatedProblem;
+      if (_applyExecutableSteps(problemAfterRepair, pDomain, *bridgeAndSuffix, pNow) &&
+          _areGoalsOfStepsDone(problemAfterRepair, itInvalidStep, pPreviousPlan.end()))
+        bestBridgeAndSuffix = std::move(bridgeAndSuffix);
     }
+    if (bestBridgeAndSuffix)
+      repairedSteps.splice(repairedSteps.end(), *bestBridgeAndSuffix);
+    else
+      repairedSteps.clear(); // The kept steps can lead nowhere, so everything is planned again
   }
+
+  LookForAnActionOutputInfos lookForAnActionOutputInfos;
+  for (const auto& currStep : repairedSteps)
+  {
+    bool goalChanged = false;
+    updateProblemForNextPotentialPlannerResult(pProblem, goalChanged, currStep, pDomain, pNow, pGlobalHistorical,
+                                               &lookForAnActionOutputInfos);
+  }
+
+  // Plan the goals that are not satisfied by the repaired plan
+  auto res = std::move(repairedSteps);
+  PlanStepGenerator planStepGenerator(pProblem, pDomain, pNow, pGlobalHistorical);
+  while (auto step = planStepGenerator.next())
+    res.emplace_back(std::move(*step));
   if (pGoalsDonePtr != nullptr)
+  {
     lookForAnActionOutputInfos.moveGoalsDone(*pGoalsDonePtr);
+    std::list<Goal> otherGoalsDone;
+    planStepGenerator.moveGoalsDone(otherGoalsDone);
+    pGoalsDonePtr->splice(pGoalsDonePtr->end(), otherGoalsDone);
+  }
   return res;
 }
 
 
+PlanBatchResult planBatch(const Domain& pDomain,
+                          std::vector<Problem>& pProblems,
+                          const PlanBatchOptions& pOptions)
+{
+  PlanBatchResult res;
+  res.problemResults.resize(pProblems.size());
+  const auto batchBeginTime = std::chrono::steady_clock::now();
+  parallelFor(pProblems.size(), [&](std::size_t pIndex)
+  {
+    auto& problemResult = res.problemResults[pIndex];
+    const auto beginTime = std::chrono::steady_clock::now();
+    try
+    {
+      problemResult.plan = planForEveryGoals(pProblems[pIndex], pDomain, {});
+    }
+    catch (const std::exception& e)
+    {
+      problemResult.errorMessage = e.what();
+    }
+    problemResult.duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - beginTime);
+  }, 1, pOptions.maxNbOfThreads);
+  res.duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - batchBeginTime);
+  return res;
+}
+
+
+std::future<std::list<ActionInvocationWithGoal>> planForMoreImportantGoalPossibleAsync(
+    const Problem& pProblem,
+    const Domain& pDomain,
+    bool pTryToDoMoreOptimalSolution,
+    const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+    const PlanningExecutor& pExecutor,
+    const Historical* pGlobalHistorical,
+    const std::shared_ptr<std::atomic<bool>>& pStopRequested)
+{
+  std::optional<Historical> globalHistoricalSnapshot;
+  if (pGlobalHistorical != nullptr)
+    globalHistoricalSnapshot.emplace(pGlobalHistorical->snapshot());
+  return _planAsync([problem = pProblem, &pDomain, pTryToDoMoreOptimalSolution, now = _copyNow(pNow),
+                    globalHistoricalSnapshot = std::move(globalHistoricalSnapshot)]() mutable {
+    return planForMoreImportantGoalPossible(problem, pDomain, pTryToDoMoreOptimalSolution, now,
+                                            globalHistoricalSnapshot ? &*globalHistoricalSnapshot : nullptr);
+  }, pExecutor, pStopRequested);
+}
+
+
+std::future<std::list<ActionInvocationWithGoal>> planForEveryGoalsAsync(
+    const Problem& pProblem,
+    const Domain& pDomain,
+    const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+    const PlanningExecutor& pExecutor,
+    const Historical* pGlobalHistorical,
+    const std::shared_ptr<std::atomic<bool>>& pStopRequested)
+{
+  std::optional<Historical> globalHistoricalSnapshot;
+  if (pGlobalHistorical != nullptr)
+    globalHistoricalSnapshot.emplace(pGlobalHistorical->snapshot());
+  return _planAsync([problem = pProblem, &pDomain, now = _copyNow(pNow),
+                    globalHistoricalSnapshot = std::move(globalHistoricalSnapshot)]() mutable {
+    return planForEveryGoals(problem, pDomain, now, globalHistoricalSnapshot ? &*globalHistoricalSnapshot : nullptr);
+  }, pExecutor, pStopRequested);
+}
+
+
 ParallelPan parallelPlanForEveryGoals(
     Problem& pProblem,
     const Domain& pDomain,
@@ -1188,69 +1640,104 @@ ParallelPan parallelPlanForEveryGoals(
 std::string planToStr(const std::list<ActionInvocationWithGoal>& pPlan,
                       const std::string& pSep)
 {
-  std::string res;
+  std::ostringstream res;
+  planToStr(res, pPlan, pSep);
+  return res.str();
+}
+
+
+void planToStr(std::ostream& pOutput,
+               const std::list<ActionInvocationWithGoal>& pPlan,
+               const std::string& pSep)
+{
   bool firstIteration = true;
   for (const auto& currAction : pPlan)
   {
     if (firstIteration)
       firstIteration = false;
     else
-      res += pSep;
-    res += currAction.actionInvocation.toStr();
+      pOutput << pSep;
+    pOutput << currAction.actionInvocation.toStr();
   }
-  return res;
 }
 
 
 std::string parallelPlanToStr(const ParallelPan& pPlan)
 {
-  std::string res;
+  std::ostringstream res;
+  parallelPlanToStr(res, pPlan);
+  return res.str();
+}
+
+
+void parallelPlanToStr(std::ostream& pOutput,
+                       const ParallelPan& pPlan)
+{
+  bool somethingWritten = false;
   for (const auto& currAcctionsInParallel : pPlan.actionsToDoInParallel)
   {
-    if (!res.empty())
-      res += "\n";
+    if (somethingWritten)
+      pOutput << "\n";
     bool firstIteration = true;
     for (const auto& currAction : currAcctionsInParallel.actions)
     {
       if (firstIteration)
         firstIteration = false;
       else
-        res += ", ";
-      res += currAction.actionInvocation.toStr();
+        pOutput << ", ";
+      pOutput << currAction.actionInvocation.toStr();
+      somethingWritten = true;
     }
   }
-  return res;
 }
 
+
 std::string planToPddl(const std::list<ActionInvocationWithGoal>& pPlan,
                        const Domain& pDomain)
+{
+  std::ostringstream res;
+  planToPddl(res, pPlan, pDomain);
+  return res.str();
+}
+
+
+void planToPddl(std::ostream& pOutput,
+                const std::list<ActionInvocationWithGoal>& pPlan,
+                const Domain& pDomain)
 {
   std::size_t step = 0;
-  std::stringstream ss;
   for (const auto& currActionInvocationWithGoal : pPlan)
   {
-    ss << std::setw(2) << std::setfill('0') << step << ": ";
+    _writePlanStep(pOutput, step);
     ++step;
-    ss << currActionInvocationWithGoal.actionInvocation.toPddl(pDomain) << "\n";
+    pOutput << currActionInvocationWithGoal.actionInvocation.toPddl(pDomain) << "\n";
   }
-  return ss.str();
 }
 
 
 std::string parallelPlanToPddl(const ParallelPan& pPlan,
                                const Domain& pDomain)
+{
+  std::ostringstream res;
+  parallelPlanToPddl(res, pPlan, pDomain);
+  return res.str();
+}
+
+
+void parallelPlanToPddl(std::ostream& pOutput,
+                        const ParallelPan& pPlan,
+                        const Domain& pDomain)
 {
   std::size_t step = 0;
-  std::string res;
   for (const auto& currActionsToDoInParallel : pPlan.actionsToDoInParallel)
   {
-    std::stringstream ssBeginOfStep;
-    ssBeginOfStep << std::setw(2) << std::setfill('0') << step << ": ";
-    ++step;
     for (const auto& currActionInvocationWithGoal : currActionsToDoInParallel.actions)
-      res += ssBeginOfStep.str() + currActionInvocationWithGoal.actionInvocation.toPddl(pDomain) + "\n";
+    {
+      _writePlanStep(pOutput, step);
+      pOutput << currActionInvocationWithGoal.actionInvocation.toPddl(pDomain) << "\n";
+    }
+    ++step;
   }
-  return res;
 }
 
 
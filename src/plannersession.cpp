@@ -0,0 +1,157 @@
+#include <orderedgoalsplanner/plannersession.hpp>
+#include <algorithm>
+#include <set>
+#include <orderedgoalsplanner/types/domain.hpp>
+#include <orderedgoalsplanner/types/problem.hpp>
+#include <orderedgoalsplanner/orderedgoalsplanner.hpp>
+
+namespace ogp
+{
+namespace
+{
+
+void _addFactName(std::vector<std::string>& pFactNames,
+                  const FactOptional& pFactOptional)
+{
+  const auto& factName = pFactOptional.fact.name();
+  if (std::find(pFactNames.begin(), pFactNames.end(), factName) == pFactNames.end())
+    pFactNames.push_back(factName);
+}
+
+void _addFactNamesOfCondition(std::vector<std::string>& pFactNames,
+                              const std::unique_ptr<Condition>& pConditionPtr)
+{
+  if (!pConditionPtr)
+    return;
+  pConditionPtr->forAll([&](const FactOptional& pFactOptional, bool) {
+    _addFactName(pFactNames, pFactOptional);
+    return ContinueOrBreak::CONTINUE;
+  });
+}
+
+void _addFactNamesOfModification(std::vector<std::string>& pFactNames,
+                                 const std::unique_ptr<WorldStateModification>& pModificationPtr,
+                                 const SetOfFacts& pSetOfFacts)
+{
+  if (!pModificationPtr)
+    return;
+  pModificationPtr->forAll([&](const FactOptional& pFactOptional) {
+    _addFactName(pFactNames, pFactOptional);
+  }, pSetOfFacts);
+  pModificationPtr->forAllThatCanBeModified([&](const FactOptional& pFactOptional) {
+    _addFactName(pFactNames, pFactOptional);
+    return ContinueOrBreak::CONTINUE;
+  });
+}
+
+}
+
+
+PlannerSession::PlannerSession(const Domain& pDomain)
+  : _domain(pDomain),
+    _hasLastPlan(false),
+    _wasLastPlanReused(false),
+    _lastPlan(),
+    _domainUuid(),
+    _goals(),
+    _relevantFactNames(),
+    _relevantFactVersions()
+{
+}
+
+
+std::list<ActionInvocationWithGoal> PlannerSession::planForMoreImportantGoalPossible(
+    Problem& pProblem,
+    bool pTryToDoMoreOptimalSolution,
+    const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+    const Historical* pGlobalHistorical)
+{
+  _wasLastPlanReused = _canReuseLastPlan(pProblem, pNow);
+  if (_wasLastPlanReused)
+    return _lastPlan;
+
+  _lastPlan = ogp::planForMoreImportantGoalPossible(pProblem, _domain, pTryToDoMoreOptimalSolution, pNow, pGlobalHistorical);
+  _hasLastPlan = true;
+  _domainUuid = _domain.getUuid();
+  _goals = pProblem.goalStack.goals();
+  _updateRelevantFacts(pProblem);
+  return _lastPlan;
+}
+
+
+void PlannerSession::reset()
+{
+  _hasLastPlan = false;
+  _lastPlan.clear();
+  _goals.clear();
+  _relevantFactNames.clear();
+  _relevantFactVersions.clear();
+}
+
+
+bool PlannerSession::_canReuseLastPlan(const Problem& pProblem,
+                                       const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow) const
+{
+  if (!_hasLastPlan || _domainUuid != _domain.getUuid() || _goals != pProblem.goalStack.goals())
+    return false;
+  // A goal inactive for too long can be removed by the planification
+  auto nextExpiry = pProblem.goalStack.nextExpiry();
+  if (pNow && nextExpiry && *nextExpiry <= *pNow)
+    return false;
+  const auto& setOfFacts = pProblem.worldState.factsMapping();
+  for (std::size_t i = 0; i < _relevantFactNames.size(); ++i)
+    if (_relevantFactVersions[i] != setOfFacts.getFactNameVersion(_relevantFactNames[i]))
+      return false;
+  return true;
+}
+
+
+void PlannerSession::_updateRelevantFacts(const Problem& pProblem)
+{
+  _relevantFactNames.clear();
+  const auto& setOfFacts = pProblem.worldState.factsMapping();
+  std::set<ActionId> actionIds;
+  std::set<FullEventId> fullEventIds;
+  for (const auto& currGoalsGroup : pProblem.goalStack.goals())
+  {
+    for (const auto& currGoal : currGoalsGroup.second)
+    {
+      currGoal.objective().forAll([&](const FactOptional& pFactOptional, bool) {
+        _addFactName(_relevantFactNames, pFactOptional);
+        return ContinueOrBreak::CONTINUE;
+      });
+      actionIds.insert(currGoal.getActionsPredecessors().begin(), currGoal.getActionsPredecessors().end());
+      fullEventIds.insert(currGoal.getEventsPredecessors().begin(), currGoal.getEventsPredecessors().end());
+    }
+  }
+
+  for (const auto& currActionId : actionIds)
+  {
+    const auto* actionPtr = _domain.getActionPtr(currActionId);
+    if (actionPtr == nullptr)
+      continue;
+    _addFactNamesOfCondition(_relevantFactNames, actionPtr->precondition);
+    _addFactNamesOfCondition(_relevantFactNames, actionPtr->overAllCondition);
+    _addFactNamesOfCondition(_relevantFactNames, actionPtr->preferInContext);
+    _addFactNamesOfModification(_relevantFactNames, actionPtr->effect.worldStateModification, setOfFacts);
+    _addFactNamesOfModification(_relevantFactNames, actionPtr->effect.potentialWorldStateModification, setOfFacts);
+    _addFactNamesOfModification(_relevantFactNames, actionPtr->effect.worldStateModificationAtStart, setOfFacts);
+  }
+
+  for (const auto& currIdToSetOfEvents : _domain.getSetOfEvents())
+  {
+    for (const auto& currIdToEvent : currIdToSetOfEvents.second.events())
+    {
+      if (fullEventIds.count(generateFullEventId(currIdToSetOfEvents.first, currIdToEvent.first)) == 0)
+        continue;
+      _addFactNamesOfCondition(_relevantFactNames, currIdToEvent.second.precondition);
+      _addFactNamesOfModification(_relevantFactNames, currIdToEvent.second.factsToModify, setOfFacts);
+    }
+  }
+
+  _relevantFactVersions.resize(_relevantFactNames.size());
+  for (std::size_t i = 0; i < _relevantFactNames.size(); ++i)
+    _relevantFactVersions[i] = setOfFacts.getFactNameVersion(_relevantFactNames[i]);
+}
+
+} // !ogp
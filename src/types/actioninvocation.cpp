@@ -2,6 +2,7 @@
 #include <orderedgoalsplanner/types/domain.hpp>
 #include <orderedgoalsplanner/types/entity.hpp>
 #include <orderedgoalsplanner/types/parameter.hpp>
+#include <orderedgoalsplanner/util/util.hpp>
 
 namespace ogp
 {
@@ -28,6 +29,25 @@ ActionInvocation::ActionInvocation(const std::string& pActionId,
 ActionInvocation::~ActionInvocation() {}
 
 
+bool ActionInvocation::operator==(const ActionInvocation& pOther) const
+{
+  return actionId == pOther.actionId &&
+      parameters == pOther.parameters;
+}
+
+
+std::size_t ActionInvocation::hash() const
+{
+  std::size_t res = std::hash<std::string>()(actionId);
+  for (const auto& currParam : parameters)
+  {
+    hashCombine(res, currParam.first.name);
+    hashCombine(res, currParam.second.value);
+  }
+  return res;
+}
+
+
 std::string ActionInvocation::toStr() const
 {
   std::string res = actionId;
@@ -603,7 +603,7 @@ bool ConditionNode::isTrue(const WorldState& pWorldState,
             if (currWsFact.fluent() &&
                 leftFact.areEqualWithoutFluentConsideration(currWsFact))
             {
-              bool res = compIntNb(currWsFact.fluent()->value, rightNbPtr->nb,
+              bool res = compIntNb(*currWsFact.fluent(), rightNbPtr->nb,
                                    canBeSuperior(nodeType), canBeEqual(nodeType));
               if (!pIsWrappingExpressionNegated)
                 return res;
@@ -1179,7 +1179,7 @@ bool ConditionNumber::operator==(const Condition& pOther) const
 
 std::optional<Entity> ConditionNumber::getFluent(const SetOfFacts&) const
 {
-  return Entity::createNumberEntity(toStr(nullptr, true));
+  return Entity::createNumberEntity(nb);
 }
 
 std::unique_ptr<Condition> ConditionNumber::clone(const std::map<Parameter, Entity>*,
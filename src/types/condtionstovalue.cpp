@@ -14,15 +14,8 @@ bool ConditionsToValue::add(const Condition& pCondition,
         [&](const FactOptional& pFactOptional,
         bool pIgnoreFluent)
   {
-    if (pFactOptional.isFactNegated)
-    {
-      _notFactsToValue.add(pFactOptional.fact, pValue, pIgnoreFluent);
-    }
-    else
-    {
-      _factsToValue.add(pFactOptional.fact, pValue, pIgnoreFluent);
+    if (addFact(pFactOptional, pValue, pIgnoreFluent))
       hasAddedAFact = true;
-    }
     return ContinueOrBreak::CONTINUE;
   }
   );
@@ -30,6 +23,20 @@ bool ConditionsToValue::add(const Condition& pCondition,
 }
 
 
+bool ConditionsToValue::addFact(const FactOptional& pFactOptional,
+                                const std::string& pValue,
+                                bool pIgnoreFluent)
+{
+  if (pFactOptional.isFactNegated)
+  {
+    _notFactsToValue.add(pFactOptional.fact, pValue, pIgnoreFluent);
+    return false;
+  }
+  _factsToValue.add(pFactOptional.fact, pValue, pIgnoreFluent);
+  return true;
+}
+
+
 void ConditionsToValue::erase(const std::string& pValue)
 {
   _factsToValue.erase(pValue);
@@ -22,6 +22,14 @@ DerivedPredicate::DerivedPredicate(const Predicate& pPredicate,
 }
 
 
+DerivedPredicate::DerivedPredicate(const Predicate& pPredicate,
+                                   std::unique_ptr<Condition> pCondition)
+  : predicate(pPredicate),
+    condition(std::move(pCondition))
+{
+}
+
+
 DerivedPredicate::DerivedPredicate(const DerivedPredicate& pDerivedPredicate)
   : predicate(pDerivedPredicate.predicate),
     condition(pDerivedPredicate.condition->clone())
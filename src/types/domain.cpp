@@ -2,6 +2,7 @@
 #include <orderedgoalsplanner/types/condition.hpp>
 #include <orderedgoalsplanner/types/worldstate.hpp>
 #include <orderedgoalsplanner/util/util.hpp>
+#include "../util/parallelfor.hpp"
 #include "../util/uuid.hpp"
 #include "expressionParsed.hpp"
 
@@ -161,6 +162,110 @@ void _updateActionsPredecessors(
 
 
 
+/**
+ * @brief Compute the predecessors of the actions and of the events from their successions.
+ * @param[in, out] pAllActionsTmpData Actions with their temporary data.
+ * @param[in, out] pAllEventsTmpData Events with their temporary data.
+ */
+void _updatePredecessorsCaches(std::map<ActionId, ActionWithConditionAndFactFacts>& pAllActionsTmpData,
+                               std::map<FullEventId, EventWithTmpData>& pAllEventsTmpData)
+{
+  for (auto& currAction : pAllActionsTmpData)
+  {
+    ActionWithConditionAndFactFacts& tmpData = currAction.second;
+    Successions successions;
+    if (tmpData.action.effect.worldStateModification)
+      tmpData.action.effect.worldStateModification->getSuccesions(successions);
+    if (tmpData.action.effect.potentialWorldStateModification)
+      tmpData.action.effect.potentialWorldStateModification->getSuccesions(successions);
+
+    for (const auto& currFollowingActionId : successions.actions)
+    {
+      auto itFollowingAction = pAllActionsTmpData.find(currFollowingActionId);
+      if (itFollowingAction == pAllActionsTmpData.end())
+        throw std::runtime_error("Following action id not found: " + currFollowingActionId + ".");
+      itFollowingAction->second.invertSuccessionsFromActions.insert(currAction.first);
+    }
+
+    for (const auto& currIdToEvents : successions.events)
+    {
+      for (const auto& currFollowingEventId : currIdToEvents.second)
+      {
+        auto fullEventId = generateFullEventId(currIdToEvents.first, currFollowingEventId);
+        auto itFollowingEvent = pAllEventsTmpData.find(fullEventId);
+        if (itFollowingEvent == pAllEventsTmpData.end())
+          throw std::runtime_error("Following event id not found: " + fullEventId + ".");
+        itFollowingEvent->second.invertSuccessionsFromActions.insert(currAction.first);
+      }
+    }
+  }
+
+  for (auto& currEvent : pAllEventsTmpData)
+  {
+    EventWithTmpData& tmpData = currEvent.second;
+    Successions successions;
+    if (tmpData.event.factsToModify)
+      tmpData.event.factsToModify->getSuccesions(successions);
+
+    for (const auto& currFollowingActionId : successions.actions)
+    {
+      auto itFollowingAction = pAllActionsTmpData.find(currFollowingActionId);
+      if (itFollowingAction == pAllActionsTmpData.end())
+        throw std::runtime_error("Following action id not found: " + currFollowingActionId + ".");
+      itFollowingAction->second.invertSuccessionsFromEvents.insert(currEvent.first);
+    }
+
+    for (const auto& currIdToEvents : successions.events)
+    {
+      for (const auto& currFollowingEventId : currIdToEvents.second)
+      {
+        auto fullEventId = generateFullEventId(currIdToEvents.first, currFollowingEventId);
+        auto itFollowingEvent = pAllEventsTmpData.find(fullEventId);
+        if (itFollowingEvent == pAllEventsTmpData.end())
+          throw std::runtime_error("Following event id not found: " + fullEventId + ".");
+        itFollowingEvent->second.invertSuccessionsFromEvents.insert(currEvent.first);
+      }
+    }
+  }
+
+
+  for (auto& currAction : pAllActionsTmpData)
+  {
+    ActionWithConditionAndFactFacts& tmpData = currAction.second;
+    tmpData.action.actionsPredecessorsCache.clear();
+    tmpData.action.eventsPredecessorsCache.clear();
+    _updateActionsPredecessors(tmpData.action.actionsPredecessorsCache,
+                               tmpData.action.eventsPredecessorsCache,
+                               tmpData.invertSuccessionsFromActions,
+                               tmpData.invertSuccessionsFromEvents,
+                               pAllActionsTmpData, pAllEventsTmpData);
+  }
+
+  for (auto& currEvent : pAllEventsTmpData)
+  {
+    EventWithTmpData& tmpData = currEvent.second;
+    tmpData.event.actionsPredecessorsCache.clear();
+    tmpData.event.eventsPredecessorsCache.clear();
+    _updateActionsPredecessors(tmpData.event.actionsPredecessorsCache,
+                               tmpData.event.eventsPredecessorsCache,
+                               tmpData.invertSuccessionsFromActions,
+                               tmpData.invertSuccessionsFromEvents,
+                               pAllActionsTmpData, pAllEventsTmpData);
+  }
+}
+
+
+/// Check if a world state modification can modify a fact of one of the given predicates.
+bool _canModifyAFactOfPredicates(const std::unique_ptr<WorldStateModification>& pWorldStateModification,
+                                 const std::set<std::string>& pPredicateNames)
+{
+  return pWorldStateModification &&
+      pWorldStateModification->forAllThatCanBeModified([&](const FactOptional& pFactOptional) {
+    return pPredicateNames.count(pFactOptional.fact.name()) > 0 ? ContinueOrBreak::BREAK : ContinueOrBreak::CONTINUE;
+  }) == ContinueOrBreak::BREAK;
+}
+
+
 /**
  * @brief Check if a world state modification can do some modification if we assume the world already satisfies a condition.
  * @param[in] pWorldStateModification World state modification to check.
@@ -235,17 +340,28 @@ Domain::Domain(const std::map<ActionId, Action>& pActions,
 void Domain::addAction(const ActionId& pActionId,
                        const Action& pAction)
 {
-  _addAction(pActionId, pAction);
-  _updateSuccessions();
+  if (_addAction(pActionId, pAction))
+    _updateSuccessionsAfterActionsAddition({pActionId});
+}
+
+
+void Domain::addActions(const std::map<ActionId, Action>& pActions)
+{
+  std::set<ActionId> addedActionIds;
+  for (const auto& currAction : pActions)
+    if (_addAction(currAction.first, currAction.second))
+      addedActionIds.insert(currAction.first);
+  if (!addedActionIds.empty())
+    _updateSuccessionsAfterActionsAddition(addedActionIds);
 }
 
 
-void Domain::_addAction(const ActionId& pActionId,
+bool Domain::_addAction(const ActionId& pActionId,
                         const Action& pAction)
 {
   if (_actions.count(pActionId) > 0 ||
       pAction.effect.empty())
-    return;
+    return false;
   Action clonedAction = pAction.clone(_ontology.derivedPredicates);
 
   if (clonedAction.canThisActionBeUsedByThePlanner)
@@ -264,10 +380,9 @@ void Domain::_addAction(const ActionId& pActionId,
   }
 
   const Action& action = _actions.emplace(pActionId, std::move(clonedAction)).first->second;
+  _uuid = generateUuid(); // Regenerate uuid to force the problem to refresh his cache when it will use this object (the action indexes change)
   if (!action.canThisActionBeUsedByThePlanner)
-    return;
-
-  _uuid = generateUuid(); // Regenerate uuid to force the problem to refresh his cache when it will use this object
+    return true;
 
   bool hasAddedAFact = false;
   if (action.precondition)
@@ -275,13 +390,32 @@ void Domain::_addAction(const ActionId& pActionId,
 
   if (!hasAddedAFact)
     _actionsWithoutFactToAddInPrecondition.addValueWithoutFact(pActionId);
+  return true;
 }
 
 void Domain::removeAction(const ActionId& pActionId)
+{
+  if (_removeAction(pActionId))
+    _updateSuccessionsAfterActionsRemoval({pActionId});
+}
+
+
+void Domain::removeActions(const std::set<ActionId>& pActionIds)
+{
+  std::set<ActionId> removedActionIds;
+  for (const auto& currActionId : pActionIds)
+    if (_removeAction(currActionId))
+      removedActionIds.insert(currActionId);
+  if (!removedActionIds.empty())
+    _updateSuccessionsAfterActionsRemoval(removedActionIds);
+}
+
+
+bool Domain::_removeAction(const ActionId& pActionId)
 {
   auto it = _actions.find(pActionId);
   if (it == _actions.end())
-    return;
+    return false;
   auto& actionThatWillBeRemoved = it->second;
   _uuid = generateUuid(); // Regenerate uuid to force the problem to refresh his cache when it will use this object
 
@@ -291,7 +425,7 @@ void Domain::removeAction(const ActionId& pActionId)
     _actionsWithoutFactToAddInPrecondition.erase(pActionId);
 
   _actions.erase(it);
-  _updateSuccessions();
+  return true;
 }
 
 const Action* Domain::getActionPtr(const ActionId& pActionId) const
@@ -392,35 +526,52 @@ void Domain::_updateSuccessions()
   std::map<ActionId, ActionWithConditionAndFactFacts> actionTmpData;
   std::map<FullEventId, EventWithTmpData> eventTmpData;
 
+  _updateIndexesInDomainCache();
+
   // Add successions cache of the actions
   for (auto& currAction : _actions)
   {
     Action& action = currAction.second;
     if (!action.canThisActionBeUsedByThePlanner)
       continue;
-    ActionWithConditionAndFactFacts tmpData(currAction.first, action);
+    actionTmpData.emplace(currAction.first, ActionWithConditionAndFactFacts(currAction.first, action));
+  }
+  // Each action only modifies its own caches so they can be computed in parallel
+  std::vector<ActionWithConditionAndFactFacts*> actionTmpDataPtrs;
+  actionTmpDataPtrs.reserve(actionTmpData.size());
+  for (auto& currAction : actionTmpData)
+    actionTmpDataPtrs.push_back(&currAction.second);
+  parallelFor(actionTmpDataPtrs.size(), [&](std::size_t pIndex)
+  {
+    ActionWithConditionAndFactFacts& tmpData = *actionTmpDataPtrs[pIndex];
+    Action& action = tmpData.action;
     tmpData.factsFromCondition = action.precondition ? action.precondition->getAllOptFacts() : std::set<FactOptional>();
     tmpData.factsFromEffect = action.effect.getAllOptFactsThatCanBeModified();
-    action.updateSuccessionCache(*this, currAction.first, tmpData.factsFromCondition);
-    actionTmpData.emplace(currAction.first, std::move(tmpData));
-  }
+    action.updateSuccessionCache(*this, tmpData.actionId, tmpData.factsFromCondition);
+  });
 
   // Add successions cache of the events
+  std::vector<EventWithTmpData*> eventTmpDataPtrs;
   for (auto& currSetOfEvents : _setOfEvents)
   {
     const auto& currSetOfEventsId = currSetOfEvents.first;
     for (auto& currEvent : currSetOfEvents.second.events())
     {
-      currEvent.second.updateSuccessionCache(*this, currSetOfEventsId, currEvent.first);
       auto fullEventId = generateFullEventId(currSetOfEventsId, currEvent.first);
-      eventTmpData.emplace(fullEventId, EventWithTmpData(currSetOfEventsId, currEvent.first, currEvent.second));
+      auto itEventTmpData = eventTmpData.emplace(fullEventId, EventWithTmpData(currSetOfEventsId, currEvent.first, currEvent.second)).first;
+      eventTmpDataPtrs.push_back(&itEventTmpData->second);
     }
   }
+  parallelFor(eventTmpDataPtrs.size(), [&](std::size_t pIndex)
+  {
+    EventWithTmpData& tmpData = *eventTmpDataPtrs[pIndex];
+    tmpData.event.updateSuccessionCache(*this, tmpData.setOfEventsId, tmpData.eventId);
+  });
 
   // Add successions without interest cache (and update successions cache of the actions)
-  for (auto& currAction : actionTmpData)
+  parallelFor(actionTmpDataPtrs.size(), [&](std::size_t pIndex)
   {
-    ActionWithConditionAndFactFacts& tmpData = currAction.second;
+    ActionWithConditionAndFactFacts& tmpData = *actionTmpDataPtrs[pIndex];
     tmpData.action.actionsSuccessionsWithoutInterestCache.clear();
 
     for (auto& currActionSucc : actionTmpData)
@@ -432,92 +583,159 @@ void Domain::_updateSuccessions()
         tmpData.action.removePossibleSuccessionCache(currActionSucc.second.actionId);
       }
     }
-  }
+  });
 
 
-  for (auto& currAction : actionTmpData)
-  {
-    ActionWithConditionAndFactFacts& tmpData = currAction.second;
-    Successions successions;
-    if (tmpData.action.effect.worldStateModification)
-      tmpData.action.effect.worldStateModification->getSuccesions(successions);
-    if (tmpData.action.effect.potentialWorldStateModification)
-      tmpData.action.effect.potentialWorldStateModification->getSuccesions(successions);
+  _updatePredecessorsCaches(actionTmpData, eventTmpData);
+}
 
-    for (const auto& currFollowingActionId : successions.actions)
+
+void Domain::_updateSuccessionsAfterActionsRemoval(const std::set<ActionId>& pRemovedActionIds)
+{
+  std::map<ActionId, ActionWithConditionAndFactFacts> actionTmpData;
+  std::map<FullEventId, EventWithTmpData> eventTmpData;
+  _updateIndexesInDomainCache();
+
+  // The other successions stay valid so we only forget the removed actions
+  for (auto& currAction : _actions)
+  {
+    Action& action = currAction.second;
+    if (!action.canThisActionBeUsedByThePlanner)
+      continue;
+    for (const auto& currRemovedActionId : pRemovedActionIds)
     {
-      auto itFollowingAction = actionTmpData.find(currFollowingActionId);
-      if (itFollowingAction == actionTmpData.end())
-        throw std::runtime_error("Following action id not found: " + currFollowingActionId + ".");
-      itFollowingAction->second.invertSuccessionsFromActions.insert(currAction.first);
+      action.removePossibleSuccessionCache(currRemovedActionId);
+      action.actionsSuccessionsWithoutInterestCache.erase(currRemovedActionId);
     }
+    actionTmpData.emplace(currAction.first, ActionWithConditionAndFactFacts(currAction.first, action));
+  }
 
-    for (const auto& currIdToEvents : successions.events)
+  for (auto& currSetOfEvents : _setOfEvents)
+  {
+    for (auto& currEvent : currSetOfEvents.second.events())
     {
-      for (const auto& currFollowingEventId : currIdToEvents.second)
-      {
-        auto fullEventId = generateFullEventId(currIdToEvents.first, currFollowingEventId);
-        auto itFollowingEvent = eventTmpData.find(fullEventId);
-        if (itFollowingEvent == eventTmpData.end())
-          throw std::runtime_error("Following event id not found: " + fullEventId + ".");
-        itFollowingEvent->second.invertSuccessionsFromActions.insert(currAction.first);
-      }
+      for (const auto& currRemovedActionId : pRemovedActionIds)
+        currEvent.second.removePossibleSuccessionCache(currRemovedActionId);
+      auto fullEventId = generateFullEventId(currSetOfEvents.first, currEvent.first);
+      eventTmpData.emplace(fullEventId, EventWithTmpData(currSetOfEvents.first, currEvent.first, currEvent.second));
     }
   }
 
-  for (auto& currEvent : eventTmpData)
+  _updatePredecessorsCaches(actionTmpData, eventTmpData);
+}
+
+
+void Domain::_updateSuccessionsAfterActionsAddition(const std::set<ActionId>& pAddedActionIds)
+{
+  std::map<ActionId, ActionWithConditionAndFactFacts> actionTmpData;
+  std::map<FullEventId, EventWithTmpData> eventTmpData;
+  _updateIndexesInDomainCache();
+
+  bool hasAddedActionsUsedByThePlanner = false;
+  for (const auto& currAddedActionId : pAddedActionIds)
+    if (_actions.at(currAddedActionId).canThisActionBeUsedByThePlanner)
+      hasAddedActionsUsedByThePlanner = true;
+  // The other actions and events cannot have a succession with an action that is not used by the planner
+  if (!hasAddedActionsUsedByThePlanner)
+    return;
+
+  for (auto& currAction : _actions)
+    if (currAction.second.canThisActionBeUsedByThePlanner)
+      actionTmpData.emplace(currAction.first, ActionWithConditionAndFactFacts(currAction.first, currAction.second));
+  std::vector<ActionWithConditionAndFactFacts*> actionTmpDataPtrs;
+  actionTmpDataPtrs.reserve(actionTmpData.size());
+  for (auto& currAction : actionTmpData)
+    actionTmpDataPtrs.push_back(&currAction.second);
+  parallelFor(actionTmpDataPtrs.size(), [&](std::size_t pIndex)
   {
-    EventWithTmpData& tmpData = currEvent.second;
-    Successions successions;
-    if (tmpData.event.factsToModify)
-      tmpData.event.factsToModify->getSuccesions(successions);
+    ActionWithConditionAndFactFacts& tmpData = *actionTmpDataPtrs[pIndex];
+    Action& action = tmpData.action;
+    tmpData.factsFromCondition = action.precondition ? action.precondition->getAllOptFacts() : std::set<FactOptional>();
+    tmpData.factsFromEffect = action.effect.getAllOptFactsThatCanBeModified();
+  });
 
-    for (const auto& currFollowingActionId : successions.actions)
+  std::vector<ActionWithConditionAndFactFacts*> addedActionTmpDataPtrs;
+  std::set<std::string> predicatesOfAddedPreconditions;
+  for (const auto& currAddedActionId : pAddedActionIds)
+  {
+    auto it = actionTmpData.find(currAddedActionId);
+    if (it == actionTmpData.end())
+      continue;
+    addedActionTmpDataPtrs.push_back(&it->second);
+    for (const auto& currOptFact : it->second.factsFromCondition)
+      predicatesOfAddedPreconditions.insert(currOptFact.fact.name());
+  }
+
+  parallelFor(actionTmpDataPtrs.size(), [&](std::size_t pIndex)
+  {
+    ActionWithConditionAndFactFacts& tmpData = *actionTmpDataPtrs[pIndex];
+    Action& action = tmpData.action;
+    if (pAddedActionIds.count(tmpData.actionId) > 0)
     {
-      auto itFollowingAction = actionTmpData.find(currFollowingActionId);
-      if (itFollowingAction == actionTmpData.end())
-        throw std::runtime_error("Following action id not found: " + currFollowingActionId + ".");
-      itFollowingAction->second.invertSuccessionsFromEvents.insert(currEvent.first);
+      // Compute all the successions of a new action, as _updateSuccessions does
+      action.updateSuccessionCache(*this, tmpData.actionId, tmpData.factsFromCondition);
+      action.actionsSuccessionsWithoutInterestCache.clear();
+      for (auto& currActionSucc : actionTmpData)
+      {
+        if (tmpData.isImpossibleSuccession(currActionSucc.second) ||
+            !tmpData.doesSuccessionsHasAnInterest(currActionSucc.second))
+        {
+          action.actionsSuccessionsWithoutInterestCache.insert(currActionSucc.second.actionId);
+          action.removePossibleSuccessionCache(currActionSucc.second.actionId);
+        }
+      }
+      return;
     }
 
-    for (const auto& currIdToEvents : successions.events)
+    // An existing action can only gain a succession to a new action if its effect can modify a precondition of it
+    if (_canModifyAFactOfPredicates(action.effect.worldStateModification, predicatesOfAddedPreconditions) ||
+        _canModifyAFactOfPredicates(action.effect.potentialWorldStateModification, predicatesOfAddedPreconditions))
     {
-      for (const auto& currFollowingEventId : currIdToEvents.second)
+      action.updateSuccessionCache(*this, tmpData.actionId, tmpData.factsFromCondition);
+      for (const auto& currActionIdWithoutInterest : action.actionsSuccessionsWithoutInterestCache)
+        action.removePossibleSuccessionCache(currActionIdWithoutInterest);
+    }
+    for (auto* currAddedActionTmpDataPtr : addedActionTmpDataPtrs)
+    {
+      if (tmpData.isImpossibleSuccession(*currAddedActionTmpDataPtr) ||
+          !tmpData.doesSuccessionsHasAnInterest(*currAddedActionTmpDataPtr))
       {
-        auto fullEventId = generateFullEventId(currIdToEvents.first, currFollowingEventId);
-        auto itFollowingEvent = eventTmpData.find(fullEventId);
-        if (itFollowingEvent == eventTmpData.end())
-          throw std::runtime_error("Following event id not found: " + fullEventId + ".");
-        itFollowingEvent->second.invertSuccessionsFromEvents.insert(currEvent.first);
+        action.actionsSuccessionsWithoutInterestCache.insert(currAddedActionTmpDataPtr->actionId);
+        action.removePossibleSuccessionCache(currAddedActionTmpDataPtr->actionId);
       }
     }
-  }
+  });
 
-
-  for (auto& currAction : actionTmpData)
+  std::vector<EventWithTmpData*> eventTmpDataPtrsToUpdate;
+  for (auto& currSetOfEvents : _setOfEvents)
   {
-    ActionWithConditionAndFactFacts& tmpData = currAction.second;
-    tmpData.action.actionsPredecessorsCache.clear();
-    tmpData.action.eventsPredecessorsCache.clear();
-    _updateActionsPredecessors(tmpData.action.actionsPredecessorsCache,
-                               tmpData.action.eventsPredecessorsCache,
-                               tmpData.invertSuccessionsFromActions,
-                               tmpData.invertSuccessionsFromEvents,
-                               actionTmpData, eventTmpData);
+    for (auto& currEvent : currSetOfEvents.second.events())
+    {
+      auto fullEventId = generateFullEventId(currSetOfEvents.first, currEvent.first);
+      auto itEventTmpData = eventTmpData.emplace(fullEventId, EventWithTmpData(currSetOfEvents.first, currEvent.first, currEvent.second)).first;
+      if (_canModifyAFactOfPredicates(currEvent.second.factsToModify, predicatesOfAddedPreconditions))
+        eventTmpDataPtrsToUpdate.push_back(&itEventTmpData->second);
+    }
   }
-
-  for (auto& currEvent : eventTmpData)
+  parallelFor(eventTmpDataPtrsToUpdate.size(), [&](std::size_t pIndex)
   {
-    EventWithTmpData& tmpData = currEvent.second;
-    tmpData.event.actionsPredecessorsCache.clear();
-    tmpData.event.eventsPredecessorsCache.clear();
-    _updateActionsPredecessors(tmpData.event.actionsPredecessorsCache,
-                               tmpData.event.eventsPredecessorsCache,
-                               tmpData.invertSuccessionsFromActions,
-                               tmpData.invertSuccessionsFromEvents,
-                               actionTmpData, eventTmpData);
-  }
+    EventWithTmpData& tmpData = *eventTmpDataPtrsToUpdate[pIndex];
+    tmpData.event.updateSuccessionCache(*this, tmpData.setOfEventsId, tmpData.eventId);
+  });
 
+  _updatePredecessorsCaches(actionTmpData, eventTmpData);
+}
+
+
+void Domain::_updateIndexesInDomainCache()
+{
+  std::size_t index = 0;
+  for (auto& currAction : _actions)
+    currAction.second.indexInDomainCache = index++;
+  index = 0;
+  for (auto& currSetOfEvents : _setOfEvents)
+    for (auto& currEvent : currSetOfEvents.second.events())
+      currEvent.second.indexInDomainCache = index++;
 }
 
 
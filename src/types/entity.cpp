@@ -17,19 +17,24 @@ const std::string _anyValue = "*";
 Entity::Entity(const std::string& pValue,
                const std::shared_ptr<Type>& pType)
  : value(pValue),
-   type(pType)
+   type(pType),
+   number()
 {
+  if (type && type == SetOfTypes::numberType() && isNumber(value))
+    number = stringToNumber(value);
 }
 
 Entity::Entity(Entity&& pOther) noexcept
   : value(std::move(pOther.value)),
-    type(pOther.type) {
+    type(pOther.type),
+    number(pOther.number) {
 }
 
 
 Entity& Entity::operator=(Entity&& pOther) noexcept {
     value = std::move(pOther.value);
     type = pOther.type;
+    number = pOther.number;
     return *this;
 }
 
@@ -69,6 +74,14 @@ Entity Entity::createNumberEntity(const std::string& pNumber)
   return Entity(pNumber, SetOfTypes::numberType());
 }
 
+Entity Entity::createNumberEntity(const Number& pNumber)
+{
+  Entity res(numberToString(pNumber), {});
+  res.type = SetOfTypes::numberType();
+  res.number = pNumber;
+  return res;
+}
+
 
 Entity Entity::fromDeclaration(const std::string& pStr,
                                const SetOfTypes& pSetOfTypes)
@@ -13,7 +13,8 @@ Event::Event(std::unique_ptr<Condition> pPrecondition,
     factsToModify(pFactsToModify ? std::move(pFactsToModify) : std::unique_ptr<WorldStateModification>()),
     goalsToAdd(pGoalsToAdd),
     actionsPredecessorsCache(),
-    eventsPredecessorsCache()
+    eventsPredecessorsCache(),
+    indexInDomainCache(std::numeric_limits<std::size_t>::max())
 {
   assert(precondition);
   assert(factsToModify || !goalsToAdd.empty());
@@ -33,6 +34,12 @@ void Event::updateSuccessionCache(const Domain& pDomain,
     factsToModify->updateSuccesions(pDomain, containerId, optionalFactsToIgnore);
 }
 
+void Event::removePossibleSuccessionCache(const ActionId& pActionIdToRemove)
+{
+  if (factsToModify)
+    factsToModify->removePossibleSuccession(pActionIdToRemove);
+}
+
 std::string Event::printSuccessionCache() const
 {
   std::string res;
@@ -21,6 +21,37 @@ bool _isASeparator(char pChar)
       _isASeparatorForTheBeginOfAFollowingExpression(pChar);
 }
 
+/// Extract "(name arg1 arg2...)" if all the arguments are tokens. The "(name" part is extracted even if it fails after.
+bool _extractSimplePddlFactTokens(std::string_view pStr,
+                                  std::size_t& pPos,
+                                  std::string_view& pName,
+                                  std::vector<std::string_view>& pArguments)
+{
+  auto strSize = pStr.size();
+  if (pPos >= strSize || pStr[pPos] != '(')
+    return false;
+  ++pPos;
+  pName = ExpressionParsed::parseTokenViewThatCanBeEmpty(pStr, pPos);
+  if (pName.empty())
+    return false;
+
+  while (true)
+  {
+    ExpressionParsed::skipSpaces(pStr, pPos);
+    if (pPos >= strSize || pStr[pPos] == '(')
+      return false;
+    if (pStr[pPos] == ')')
+    {
+      ++pPos;
+      return true;
+    }
+    auto argument = ExpressionParsed::parseTokenViewThatCanBeEmpty(pStr, pPos);
+    if (argument.empty())
+      return false;
+    pArguments.emplace_back(argument);
+  }
+}
+
 }
 
 
@@ -282,7 +313,51 @@ ExpressionParsed ExpressionParsed::fromPddl(const std::string& pStr,
   return res;
 }
 
-void ExpressionParsed::skipSpaces(const std::string& pStr,
+bool ExpressionParsed::extractPddlFactTokens(std::string_view pStr,
+                                             std::size_t& pPos,
+                                             PddlFactTokens& pRes)
+{
+  std::size_t pos = pPos;
+  pRes.arguments.clear();
+  pRes.fluent = {};
+  pRes.isFactNegated = false;
+  skipSpaces(pStr, pos);
+  if (!_extractSimplePddlFactTokens(pStr, pos, pRes.name, pRes.arguments))
+    return false;
+
+  if (pRes.name == "not" || pRes.name == "=")
+  {
+    if (!pRes.arguments.empty())
+      return false;
+    bool isNegation = pRes.name == "not";
+    skipSpaces(pStr, pos);
+    if (!_extractSimplePddlFactTokens(pStr, pos, pRes.name, pRes.arguments) ||
+        pRes.name == "not" || pRes.name == "=")
+      return false;
+    skipSpaces(pStr, pos);
+    if (isNegation)
+    {
+      pRes.isFactNegated = true;
+    }
+    else
+    {
+      pRes.fluent = parseTokenViewThatCanBeEmpty(pStr, pos);
+      if (pRes.fluent.empty())
+        return false;
+      skipSpaces(pStr, pos);
+    }
+    if (pos >= pStr.size() || pStr[pos] != ')')
+      return false;
+    ++pos;
+  }
+
+  skipSpaces(pStr, pos);
+  pPos = pos;
+  return true;
+}
+
+
+void ExpressionParsed::skipSpaces(std::string_view pStr,
                                   std::size_t& pPos)
 {
   auto strSize = pStr.size();
@@ -311,7 +386,7 @@ void ExpressionParsed::skipSpacesWithTagExtraction(const std::string& pStr,
 }
 
 
-void ExpressionParsed::moveUntilEndOfLine(const std::string& pStr,
+void ExpressionParsed::moveUntilEndOfLine(std::string_view pStr,
                                           std::size_t& pPos)
 {
   auto strSize = pStr.size();
@@ -362,7 +437,7 @@ void ExpressionParsed::moveUntilEndOfLineWithTagExtraction(const std::string& pS
 }
 
 
-void ExpressionParsed::moveUntilClosingParenthesis(const std::string& pStr,
+void ExpressionParsed::moveUntilClosingParenthesis(std::string_view pStr,
                                                    std::size_t& pPos)
 {
   auto strSize = pStr.size();
@@ -375,7 +450,7 @@ void ExpressionParsed::moveUntilClosingParenthesis(const std::string& pStr,
 }
 
 
-std::string ExpressionParsed::parseToken(const std::string& pStr,
+std::string ExpressionParsed::parseToken(std::string_view pStr,
                                          std::size_t& pPos)
 {
   std::size_t beginOfTokenPos = pPos;
@@ -383,41 +458,40 @@ std::string ExpressionParsed::parseToken(const std::string& pStr,
   if (res.empty())
   {
     auto strSize = pStr.size();
-    throw std::runtime_error("Empty token in str " + pStr.substr(beginOfTokenPos, strSize - beginOfTokenPos));
+    throw std::runtime_error("Empty token in str " + std::string(pStr.substr(beginOfTokenPos, strSize - beginOfTokenPos)));
   }
   return res;
 }
 
 
-std::string ExpressionParsed::parseTokenThatCanBeEmpty(const std::string& pStr,
+std::string ExpressionParsed::parseTokenThatCanBeEmpty(std::string_view pStr,
                                                        std::size_t& pPos)
+{
+  return std::string(parseTokenViewThatCanBeEmpty(pStr, pPos));
+}
+
+
+std::string_view ExpressionParsed::parseTokenViewThatCanBeEmpty(std::string_view pStr,
+                                                                std::size_t& pPos)
 {
   auto strSize = pStr.size();
   skipSpaces(pStr, pPos);
-  std::string res = "";
   std::size_t beginOfTokenPos = pPos;
   while (pPos < strSize)
   {
     if (pStr[pPos] == ';')
     {
-      res = pStr.substr(beginOfTokenPos, pPos - beginOfTokenPos);
+      auto res = pStr.substr(beginOfTokenPos, pPos - beginOfTokenPos);
       ExpressionParsed::moveUntilEndOfLine(pStr, pPos);
       ++pPos;
       return res;
     }
 
     if (isEndOfTokenSeparator(pStr[pPos]))
-    {
-      res = pStr.substr(beginOfTokenPos, pPos - beginOfTokenPos);
       break;
-    }
     ++pPos;
   }
-  if (res.empty())
-  {
-    res = pStr.substr(beginOfTokenPos, pPos - beginOfTokenPos);
-  }
-  return res;
+  return pStr.substr(beginOfTokenPos, pPos - beginOfTokenPos);
 }
 
 
@@ -5,6 +5,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace ogp
@@ -15,6 +16,16 @@ struct Parameter;
 struct SetOfEntities;
 
 
+/// Tokens of a fact written in PDDL, viewed in the parsed string without any copy.
+struct PddlFactTokens
+{
+  std::string_view name;
+  std::vector<std::string_view> arguments;
+  std::string_view fluent;
+  bool isFactNegated = false;
+};
+
+
 struct ExpressionParsed
 {
   std::string name;
@@ -45,27 +56,42 @@ struct ExpressionParsed
                                    std::size_t& pPos,
                                    bool pCanHaveFollowingExpression);
 
-  static void skipSpaces(const std::string& pStr,
+  /**
+   * @brief Extract the tokens of a simple PDDL fact, like "(pred a b)", "(not (pred a b))" or "(= (func a) v)".
+   * @param[in] pStr String to parse.
+   * @param[in, out] pPos Position of the fact. It is moved after the fact only if the extraction succeeded.
+   * @param[out] pRes Tokens extracted. They are views of pStr.
+   * @return True if the fact was simple enough to be extracted, false if ExpressionParsed is needed to parse it.
+   */
+  static bool extractPddlFactTokens(std::string_view pStr,
+                                    std::size_t& pPos,
+                                    PddlFactTokens& pRes);
+
+  static void skipSpaces(std::string_view pStr,
                          std::size_t& pPos);
 
   void skipSpacesWithTagExtraction(const std::string& pStr,
                                    std::size_t& pPos);
 
-  static void moveUntilEndOfLine(const std::string& pStr,
+  static void moveUntilEndOfLine(std::string_view pStr,
                                  std::size_t& pPos);
 
   void moveUntilEndOfLineWithTagExtraction(const std::string& pStr,
                                            std::size_t& pPos);
 
-  static void moveUntilClosingParenthesis(const std::string& pStr,
+  static void moveUntilClosingParenthesis(std::string_view pStr,
                                           std::size_t& pPos);
 
-  static std::string parseToken(const std::string& pStr,
+  static std::string parseToken(std::string_view pStr,
                                 std::size_t& pPos);
 
-  static std::string parseTokenThatCanBeEmpty(const std::string& pStr,
+  static std::string parseTokenThatCanBeEmpty(std::string_view pStr,
                                               std::size_t& pPos);
 
+  /// Same as parseTokenThatCanBeEmpty but the token is returned as a view of pStr.
+  static std::string_view parseTokenViewThatCanBeEmpty(std::string_view pStr,
+                                                       std::size_t& pPos);
+
   static bool isEndOfTokenSeparator(char pChar);
 };
 
@@ -10,6 +10,7 @@
 #include <orderedgoalsplanner/types/setoffacts.hpp>
 #include <orderedgoalsplanner/util/util.hpp>
 #include "expressionParsed.hpp"
+#include "factsignaturestable.hpp"
 
 namespace ogp
 {
@@ -44,6 +45,89 @@ void _entitiesToValueStr(std::string& pStr,
   }
 }
 
+const Entity* _entityOfSignaturePosition(const Fact& pFact,
+                                         std::size_t pPosition)
+{
+  const auto& arguments = pFact.arguments();
+  if (pPosition < arguments.size())
+    return &arguments[pPosition];
+  return pFact.fluent() ? &*pFact.fluent() : nullptr;
+}
+
+/// Get the identifier of the signature of a fact, and the type index of each position, from the table of its predicate.
+/// Returns false if the table cannot identify this fact.
+bool _getSignatureIdFromTable(std::uint64_t& pId,
+                              std::vector<std::uint32_t>* pTypeIndexesPtr,
+                              const Fact& pFact)
+{
+  const auto* tablePtr = pFact.predicate.signaturesTable.get();
+  if (tablePtr == nullptr || tablePtr->positions.size() != pFact.arguments().size() + 1)
+    return false;
+  pId = tablePtr->predicateId;
+  if (pTypeIndexesPtr != nullptr)
+    pTypeIndexesPtr->resize(tablePtr->positions.size());
+  for (std::size_t i = 0; i < tablePtr->positions.size(); ++i)
+  {
+    const auto* entityPtr = _entityOfSignaturePosition(pFact, i);
+    std::uint32_t typeIndex = 0;
+    if (entityPtr != nullptr &&
+        !tablePtr->positions[i].getTypeIndex(typeIndex, entityPtr->type.get()))
+      return false;
+    if (pTypeIndexesPtr != nullptr)
+      (*pTypeIndexesPtr)[i] = typeIndex;
+    pId += typeIndex * tablePtr->positions[i].stride;
+  }
+  return true;
+}
+
+void _addUpperTypeSignatureIds(std::vector<FactSignatureId>& pRes,
+                               std::uint64_t pId,
+                               const std::vector<std::uint32_t>& pTypeIndexes,
+                               const FactSignaturesTable& pTable)
+{
+  for (std::size_t i = 0; i < pTypeIndexes.size(); ++i)
+  {
+    const auto& position = pTable.positions[i];
+    const auto idWithoutPosition = pId - pTypeIndexes[i] * position.stride;
+    for (auto currUpperType : position.upperTypes[pTypeIndexes[i]])
+      pRes.push_back(FactSignatureId{idWithoutPosition + currUpperType * position.stride});
+  }
+}
+
+/// Add the combinations of the sub types of the parameters to fill, from a position.
+void _addSubTypeSignatureIdsRec(std::vector<FactSignatureId>& pRes,
+                                std::uint64_t pId,
+                                bool pIsAnotherTyping,
+                                std::size_t pPosition,
+                                const std::vector<std::uint32_t>& pTypeIndexes,
+                                const FactSignaturesTable& pTable,
+                                const Fact& pFact)
+{
+  if (pPosition == pTypeIndexes.size())
+  {
+    if (pIsAnotherTyping)
+      pRes.push_back(FactSignatureId{pId});
+    return;
+  }
+  _addSubTypeSignatureIdsRec(pRes, pId, pIsAnotherTyping, pPosition + 1, pTypeIndexes, pTable, pFact);
+
+  const auto* entityPtr = _entityOfSignaturePosition(pFact, pPosition);
+  if (entityPtr == nullptr || !entityPtr->type || !entityPtr->isAParameterToFill())
+    return;
+  const auto& position = pTable.positions[pPosition];
+  const auto idWithoutPosition = pId - pTypeIndexes[pPosition] * position.stride;
+  for (auto currSubType : position.subTypes[pTypeIndexes[pPosition]])
+    _addSubTypeSignatureIdsRec(pRes, idWithoutPosition + currSubType * position.stride, true,
+                               pPosition + 1, pTypeIndexes, pTable, pFact);
+}
+
+void _addSignatureStrings(std::vector<FactSignatureId>& pRes,
+                          std::list<std::string>& pSignatures)
+{
+  for (auto& currSignature : pSignatures)
+    pRes.push_back(FactSignatureId{0, std::move(currSignature)});
+}
+
 bool _isInside(const Entity& pEntity,
                const std::vector<Parameter>* pParametersPtr)
 {
@@ -82,7 +166,7 @@ Fact::Fact(const std::string& pStr,
            std::size_t pBeginPos,
            std::size_t* pResPos,
            bool pIsOkIfFluentIsMissing)
-  : predicate("_not_set", pStrPddlFormated, pOntology.types),
+  : predicate("_not_set", {}),
     _name(),
     _arguments(),
     _fluent(),
@@ -92,59 +176,85 @@ Fact::Fact(const std::string& pStr,
   std::size_t pos = pBeginPos;
   try
   {
-    auto expressionParsed = pStrPddlFormated ?
-        ExpressionParsed::fromPddl(pStr, pos, false) :
-        ExpressionParsed::fromStr(pStr, pos);
-    if (!pStrPddlFormated)
+    PddlFactTokens factTokens;
+    if (pStrPddlFormated && ExpressionParsed::extractPddlFactTokens(pStr, pos, factTokens))
     {
-      if (!expressionParsed.name.empty() && expressionParsed.name[0] == '!')
-      {
-        if (pIsFactNegatedPtr != nullptr)
-           *pIsFactNegatedPtr = true;
-        _name = expressionParsed.name.substr(1, expressionParsed.name.size() - 1);
-      }
-      else
+      // Fast path for the simple facts: the tokens are used without building an ExpressionParsed tree
+      if (factTokens.isFactNegated && pIsFactNegatedPtr != nullptr)
+        *pIsFactNegatedPtr = true;
+      _name = std::string(factTokens.name);
+      if (!factTokens.fluent.empty())
       {
-        _name = expressionParsed.name;
+        if (factTokens.fluent == getUndefinedValue().value)
+        {
+          if (pIsFactNegatedPtr != nullptr)
+             *pIsFactNegatedPtr = true;
+          _fluent.emplace(Entity::createAnyEntity());
+        }
+        else
+        {
+          _fluent.emplace(Entity::fromUsage(std::string(factTokens.fluent), pOntology, pEntities, pParameters));
+        }
       }
+      _arguments.reserve(factTokens.arguments.size());
+      for (const auto& currArgument : factTokens.arguments)
+        _arguments.push_back(Entity::fromUsage(std::string(currArgument), pOntology, pEntities, pParameters));
     }
     else
     {
-      if (expressionParsed.name == "not" && expressionParsed.arguments.size() == 1)
+      auto expressionParsed = pStrPddlFormated ?
+          ExpressionParsed::fromPddl(pStr, pos, false) :
+          ExpressionParsed::fromStr(pStr, pos);
+      if (!pStrPddlFormated)
       {
-        if (pIsFactNegatedPtr != nullptr)
-           *pIsFactNegatedPtr = true;
-        expressionParsed = expressionParsed.arguments.back().clone();
+        if (!expressionParsed.name.empty() && expressionParsed.name[0] == '!')
+        {
+          if (pIsFactNegatedPtr != nullptr)
+             *pIsFactNegatedPtr = true;
+          _name = expressionParsed.name.substr(1, expressionParsed.name.size() - 1);
+        }
+        else
+        {
+          _name = expressionParsed.name;
+        }
+      }
+      else
+      {
+        if (expressionParsed.name == "not" && expressionParsed.arguments.size() == 1)
+        {
+          if (pIsFactNegatedPtr != nullptr)
+             *pIsFactNegatedPtr = true;
+          expressionParsed = expressionParsed.arguments.back().clone();
+        }
+        _name = expressionParsed.name;
       }
-      _name = expressionParsed.name;
-    }
 
-    _isFluentNegated = expressionParsed.isValueNegated;
-    auto* expressionParsedForArgumentsPtr = &expressionParsed;
-    if (_name == "=" && expressionParsed.arguments.size() == 2)
-    {
-      auto fluentStr = expressionParsed.arguments.back().name;
-      if (fluentStr == getUndefinedValue().value)
+      _isFluentNegated = expressionParsed.isValueNegated;
+      auto* expressionParsedForArgumentsPtr = &expressionParsed;
+      if (_name == "=" && expressionParsed.arguments.size() == 2)
       {
-        if (pIsFactNegatedPtr != nullptr)
-           *pIsFactNegatedPtr = true;
-        _fluent.emplace(Entity::createAnyEntity());
+        auto fluentStr = expressionParsed.arguments.back().name;
+        if (fluentStr == getUndefinedValue().value)
+        {
+          if (pIsFactNegatedPtr != nullptr)
+             *pIsFactNegatedPtr = true;
+          _fluent.emplace(Entity::createAnyEntity());
+        }
+        else
+        {
+          _fluent.emplace(Entity::fromUsage(fluentStr, pOntology, pEntities, pParameters));
+        }
+        expressionParsedForArgumentsPtr = &expressionParsed.arguments.front();
+        _name = expressionParsedForArgumentsPtr->name;
       }
-      else
+      else if (expressionParsed.value != "")
       {
-        _fluent.emplace(Entity::fromUsage(fluentStr, pOntology, pEntities, pParameters));
+        _fluent.emplace(Entity::fromUsage(expressionParsed.value, pOntology, pEntities, pParameters));
       }
-      expressionParsedForArgumentsPtr = &expressionParsed.arguments.front();
-      _name = expressionParsedForArgumentsPtr->name;
-    }
-    else if (expressionParsed.value != "")
-    {
-      _fluent.emplace(Entity::fromUsage(expressionParsed.value, pOntology, pEntities, pParameters));
-    }
-
-    for (auto& currArgument : expressionParsedForArgumentsPtr->arguments)
-      _arguments.push_back(Entity::fromUsage(currArgument.name, pOntology, pEntities, pParameters));
 
+      for (auto& currArgument : expressionParsedForArgumentsPtr->arguments)
+        _arguments.push_back(Entity::fromUsage(currArgument.name, pOntology, pEntities, pParameters));
+    }
 
     predicate = pOntology.predicates.nameToPredicate(_name);
     _finalizeInisilizationAndValidityChecks(pOntology, pEntities, pIsOkIfFluentIsMissing);
@@ -171,7 +281,7 @@ Fact::Fact(const std::string& pName,
            const SetOfEntities& pEntities,
            const std::vector<Parameter>& pParameters,
            bool pIsOkIfFluentIsMissing)
-  : predicate("_not_set", true, pOntology.types),
+  : predicate("_not_set", {}),
     _name(pName),
     _arguments(),
     _fluent(),
@@ -197,6 +307,21 @@ Fact::Fact(const std::string& pName,
 }
 
 
+Fact::Fact(const Predicate& pPredicate,
+           std::vector<Entity>&& pArguments,
+           std::optional<Entity>&& pFluent,
+           bool pIsFluentNegated)
+  : predicate(pPredicate),
+    _name(pPredicate.name),
+    _arguments(std::move(pArguments)),
+    _fluent(std::move(pFluent)),
+    _isFluentNegated(pIsFluentNegated),
+    _factSignature()
+{
+  _resetFactSignatureCache();
+}
+
+
 Fact::~Fact()
 {
 }
@@ -584,6 +709,27 @@ std::string Fact::toPddl(bool pInEffectContext,
   return res;
 }
 
+void Fact::toPddl(std::ostream& pOutput,
+                  bool pInEffectContext,
+                  bool pPrintAnyFluent) const
+{
+  bool printFluent = _fluent && (pPrintAnyFluent || !_fluent->isAnyValue());
+  if (printFluent && _isFluentNegated)
+  {
+    pOutput << toPddl(pInEffectContext, pPrintAnyFluent);
+    return;
+  }
+
+  if (printFluent)
+    pOutput << (pInEffectContext ? "(assign " : "(= ");
+  pOutput << "(" << _name;
+  for (const auto& currArgument : _arguments)
+    pOutput << " " << currArgument.value;
+  pOutput << ")";
+  if (printFluent)
+    pOutput << " " << _fluent->value << ")";
+}
+
 std::string Fact::toStr(bool pPrintAnyFluent) const
 {
   std::string res = _name;
@@ -1040,6 +1186,49 @@ void Fact::generateSignatureForSubAndUpperTypes(std::list<std::string>& pRes) co
 
 
 
+FactSignatureId Fact::signatureId() const
+{
+  std::uint64_t id = 0;
+  if (_getSignatureIdFromTable(id, nullptr, *this))
+    return FactSignatureId{id};
+  return FactSignatureId{0, factSignature()};
+}
+
+
+void Fact::signatureIdsForAllUpperTypes(std::vector<FactSignatureId>& pRes) const
+{
+  std::uint64_t id = 0;
+  std::vector<std::uint32_t> typeIndexes;
+  if (!_getSignatureIdFromTable(id, &typeIndexes, *this))
+  {
+    std::list<std::string> signatures;
+    generateSignatureForAllUpperTypes(signatures);
+    _addSignatureStrings(pRes, signatures);
+    return;
+  }
+  pRes.push_back(FactSignatureId{id});
+  _addUpperTypeSignatureIds(pRes, id, typeIndexes, *predicate.signaturesTable);
+}
+
+
+void Fact::signatureIdsForSubAndUpperTypes(std::vector<FactSignatureId>& pRes) const
+{
+  std::uint64_t id = 0;
+  std::vector<std::uint32_t> typeIndexes;
+  if (!_getSignatureIdFromTable(id, &typeIndexes, *this))
+  {
+    std::list<std::string> signatures;
+    generateSignatureForSubAndUpperTypes(signatures);
+    _addSignatureStrings(pRes, signatures);
+    return;
+  }
+  pRes.push_back(FactSignatureId{id});
+  const auto& table = *predicate.signaturesTable;
+  _addSubTypeSignatureIdsRec(pRes, id, false, 0, typeIndexes, table, *this);
+  _addUpperTypeSignatureIds(pRes, id, typeIndexes, table);
+}
+
+
 void Fact::setArgumentType(std::size_t pIndex, const std::shared_ptr<Type>& pType)
 {
   _arguments[pIndex].type = pType;
@@ -1065,7 +1254,7 @@ void Fact::setFluent(const std::optional<Entity>& pFluent)
 void Fact::setFluentValue(const std::string& pFluentStr)
 {
   if (_fluent)
-    _fluent->value = pFluentStr;
+    _fluent = Entity(pFluentStr, _fluent->type);
   else
     _fluent = Entity(pFluentStr, predicate.fluent);
   _resetFactSignatureCache();
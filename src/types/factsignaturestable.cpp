@@ -0,0 +1,90 @@
+#include "factsignaturestable.hpp"
+#include <atomic>
+#include <orderedgoalsplanner/types/predicate.hpp>
+#include <orderedgoalsplanner/types/type.hpp>
+
+namespace ogp
+{
+namespace
+{
+/// Number of bits of the typings in the identifier of a signature. The identifier of the predicate is in the bits above.
+const std::size_t _nbOfBitsForTypings = 32;
+std::atomic<std::uint64_t> _lastPredicateId(0);
+
+
+void _addTypesRec(std::vector<const Type*>& pTypes,
+                  const Type& pType)
+{
+  pTypes.push_back(&pType);
+  for (const auto& currSubType : pType.subTypes)
+    _addTypesRec(pTypes, *currSubType);
+}
+
+
+FactSignaturesTable::Position _createPosition(const Type* pTypePtr)
+{
+  FactSignaturesTable::Position res;
+  res.stride = 0;
+  std::vector<const Type*> types(1, nullptr);
+  if (pTypePtr != nullptr)
+  {
+    // A fact can be typed with any type of the tree that contains the type of the predicate
+    const Type* rootPtr = pTypePtr;
+    while (rootPtr->parent)
+      rootPtr = rootPtr->parent.get();
+    _addTypesRec(types, *rootPtr);
+  }
+
+  for (std::uint32_t i = 0; i < types.size(); ++i)
+    res.typeToIndex.emplace(types[i], i);
+  res.upperTypes.resize(types.size());
+  res.subTypes.resize(types.size());
+  for (std::uint32_t i = 1; i < types.size(); ++i)
+  {
+    for (const Type* parentPtr = types[i]->parent.get(); parentPtr != nullptr; parentPtr = parentPtr->parent.get())
+      res.upperTypes[i].push_back(res.typeToIndex[parentPtr]);
+    std::vector<const Type*> subTypes;
+    _addTypesRec(subTypes, *types[i]);
+    for (std::size_t j = 1; j < subTypes.size(); ++j)
+      res.subTypes[i].push_back(res.typeToIndex[subTypes[j]]);
+  }
+  return res;
+}
+
+}
+
+
+std::shared_ptr<const FactSignaturesTable> FactSignaturesTable::create(const Predicate& pPredicate)
+{
+  auto res = std::make_shared<FactSignaturesTable>();
+  res->positions.reserve(pPredicate.parameters.size() + 1);
+  for (const auto& currParameter : pPredicate.parameters)
+    res->positions.emplace_back(_createPosition(currParameter.type.get()));
+  res->positions.emplace_back(_createPosition(pPredicate.fluent.get()));
+
+  const std::uint64_t maxNbOfTypings = std::uint64_t(1) << _nbOfBitsForTypings;
+  std::uint64_t nbOfTypings = 1;
+  for (auto& currPosition : res->positions)
+  {
+    currPosition.stride = nbOfTypings;
+    nbOfTypings *= currPosition.upperTypes.size();
+    if (nbOfTypings > maxNbOfTypings)
+      return {};
+  }
+  res->predicateId = (++_lastPredicateId) << _nbOfBitsForTypings;
+  return res;
+}
+
+
+bool FactSignaturesTable::Position::getTypeIndex(std::uint32_t& pRes,
+                                                 const Type* pTypePtr) const
+{
+  auto it = typeToIndex.find(pTypePtr);
+  if (it == typeToIndex.end())
+    return false;
+  pRes = it->second;
+  return true;
+}
+
+
+} // !ogp
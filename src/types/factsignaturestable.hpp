@@ -0,0 +1,55 @@
+#ifndef INCLUDE_ORDEREDGOALSPLANNER_TYPES_FACTSIGNATURESTABLE_HPP
+#define INCLUDE_ORDEREDGOALSPLANNER_TYPES_FACTSIGNATURESTABLE_HPP
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace ogp
+{
+struct Predicate;
+struct Type;
+
+
+/**
+ * @brief Integers precomputed for a predicate to identify the signatures of its facts without building strings.<br/>
+ * The identifier of a signature is the identifier of the predicate followed by the index of the type
+ * of each argument and of the fluent. The table is immutable so it is read without lock.
+ */
+struct FactSignaturesTable
+{
+  /**
+   * @brief Create the table of a predicate from the current hierarchy of its types.
+   * @param[in] pPredicate Predicate of the facts.
+   * @return The table, or nullptr if the typings of the predicate are too many to be identified by an integer.
+   */
+  static std::shared_ptr<const FactSignaturesTable> create(const Predicate& pPredicate);
+
+  /// Types that an argument or the fluent of a fact can have.
+  struct Position
+  {
+    /// Type to its index. The index 0 is for no type.
+    std::unordered_map<const Type*, std::uint32_t> typeToIndex;
+    /// Type index to the indexes of its upper types, from its parent.
+    std::vector<std::vector<std::uint32_t>> upperTypes;
+    /// Type index to the indexes of all its sub types, in pre-order.
+    std::vector<std::vector<std::uint32_t>> subTypes;
+    /// Multiplier of the type index in the identifier of a signature.
+    std::uint64_t stride;
+
+    /// Get the index of a type. Returns false if the type is not in this position.
+    bool getTypeIndex(std::uint32_t& pRes, const Type* pTypePtr) const;
+  };
+
+  /// Identifier of the predicate, in the high bits of the identifiers of the signatures.
+  std::uint64_t predicateId;
+  /// Positions of the arguments, then of the fluent.
+  std::vector<Position> positions;
+};
+
+
+} // !ogp
+
+
+#endif // INCLUDE_ORDEREDGOALSPLANNER_TYPES_FACTSIGNATURESTABLE_HPP
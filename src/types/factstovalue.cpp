@@ -80,8 +80,8 @@ void FactsToValue::add(const Fact& pFact,
     }
   }
 
-  std::list<std::string> factSignatures;
-  pFact.generateSignatureForSubAndUpperTypes(factSignatures);
+  std::vector<FactSignatureId> factSignatures;
+  pFact.signatureIdsForSubAndUpperTypes(factSignatures);
   for (auto& currSignature : factSignatures)
   {
     auto& factArguments = pFact.arguments();
@@ -145,8 +145,8 @@ void FactsToValue::_erase(const Fact& pFact,
       }
     }
 
-    std::list<std::string> factSignatures;
-    pFact.generateSignatureForSubAndUpperTypes(factSignatures);
+    std::vector<FactSignatureId> factSignatures;
+    pFact.signatureIdsForSubAndUpperTypes(factSignatures);
     for (auto& currSignature : factSignatures)
     {
       auto& factArguments = pFact.arguments();
@@ -284,7 +284,7 @@ typename FactsToValue::ConstMapOfFactIterator FactsToValue::find(const Fact& pFa
     return {};
   };
 
-  auto itParameterToValues = _signatureToLists.find(pFact.factSignature());
+  auto itParameterToValues = _signatureToLists.find(pFact.signatureId());
   if (itParameterToValues != _signatureToLists.end())
   {
     const ParameterToValues& parameterToValues = itParameterToValues->second;
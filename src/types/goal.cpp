@@ -1,7 +1,9 @@
 #include <orderedgoalsplanner/types/goal.hpp>
+#include <algorithm>
 #include <assert.h>
 #include <orderedgoalsplanner/types/condtionstovalue.hpp>
 #include <orderedgoalsplanner/types/domain.hpp>
+#include <orderedgoalsplanner/types/worldstate.hpp>
 #include <orderedgoalsplanner/util/serializer/deserializefrompddl.hpp>
 #include <orderedgoalsplanner/util/serializer/serializeinpddl.hpp>
 
@@ -16,14 +18,13 @@ Goal::Goal(std::unique_ptr<Condition> pObjective,
   : _objective(std::move(pObjective)),
     _maxTimeToKeepInactive(pMaxTimeToKeepInactive),
     _inactiveSince(),
+    _idInGoalStack(0),
     _isPersistentIfSkipped(pIsPersistentIfSkipped),
     _oneStepTowards(pOneStepTowards),
     _goalGroupId(pGoalGroupId),
     _uuidOfLastDomainUsedForCache(),
-    _cacheOfActionsThatCanSatisfyThisGoal(),
-    _cacheOfEventsIdThatCanSatisfyThisGoal(),
-    _cacheOfActionsPredecessors(),
-    _cacheOfEventsPredecessors()
+    _domainCache(_getEmptyDomainCache()),
+    _satisfactionCache()
 {
   assert(_objective);
 }
@@ -32,18 +33,20 @@ Goal::Goal(std::unique_ptr<Condition> pObjective,
 Goal::Goal(const Goal& pOther,
            const std::map<Parameter, Entity>* pParametersPtr,
            const std::string* pGoalGroupIdPtr)
-  : _objective(pOther._objective->clone(pParametersPtr)),
+  : _objective(pParametersPtr != nullptr ? std::shared_ptr<const Condition>(pOther._objective->clone(pParametersPtr)) : pOther._objective),
     _maxTimeToKeepInactive(pOther._maxTimeToKeepInactive),
     _inactiveSince(pOther._inactiveSince ? std::make_unique<std::chrono::steady_clock::time_point>(*pOther._inactiveSince) : std::unique_ptr<std::chrono::steady_clock::time_point>()),
+    _idInGoalStack(pOther._idInGoalStack),
     _isPersistentIfSkipped(pOther._isPersistentIfSkipped),
     _oneStepTowards(pOther._oneStepTowards),
     _goalGroupId(pGoalGroupIdPtr != nullptr ? *pGoalGroupIdPtr : pOther._goalGroupId),
     _uuidOfLastDomainUsedForCache(pOther._uuidOfLastDomainUsedForCache),
-    _cacheOfActionsThatCanSatisfyThisGoal(pOther._cacheOfActionsThatCanSatisfyThisGoal),
-    _cacheOfEventsIdThatCanSatisfyThisGoal(pOther._cacheOfEventsIdThatCanSatisfyThisGoal),
-    _cacheOfActionsPredecessors(pOther._cacheOfActionsPredecessors),
-    _cacheOfEventsPredecessors(pOther._cacheOfEventsPredecessors)
+    _domainCache(pOther._domainCache),
+    _satisfactionCache(pOther._satisfactionCache)
 {
+  // The parameters change the objective but not the names of its facts
+  if (pParametersPtr != nullptr)
+    _satisfactionCache.isComputed = false;
 }
 
 
@@ -60,36 +63,53 @@ Goal Goal::fromStr(const std::string& pStr,
 }
 
 
+Condition& Goal::objective()
+{
+  if (_objective.use_count() > 1)
+    _objective = std::shared_ptr<const Condition>(_objective->clone());
+  _uuidOfLastDomainUsedForCache.clear();
+  _domainCache = _getEmptyDomainCache();
+  _satisfactionCache = SatisfactionCache();
+  // The objective is not shared anymore and it was created as a non-const condition
+  return const_cast<Condition&>(*_objective);
+}
+
+
 void Goal::operator=(const Goal& pOther)
 {
-  _objective = pOther._objective->clone();
+  _objective = pOther._objective;
   _maxTimeToKeepInactive = pOther._maxTimeToKeepInactive;
   if (pOther._inactiveSince)
     _inactiveSince = std::make_unique<std::chrono::steady_clock::time_point>(*pOther._inactiveSince);
   else
     _inactiveSince.reset();
+  _idInGoalStack = pOther._idInGoalStack;
   _isPersistentIfSkipped = pOther._isPersistentIfSkipped;
   _oneStepTowards = pOther._oneStepTowards;
   _goalGroupId = pOther._goalGroupId;
   _uuidOfLastDomainUsedForCache = pOther._uuidOfLastDomainUsedForCache;
-  _cacheOfActionsThatCanSatisfyThisGoal = pOther._cacheOfActionsThatCanSatisfyThisGoal;
-  _cacheOfEventsIdThatCanSatisfyThisGoal = pOther._cacheOfEventsIdThatCanSatisfyThisGoal;
-  _cacheOfActionsPredecessors = pOther._cacheOfActionsPredecessors;
-  _cacheOfEventsPredecessors = pOther._cacheOfEventsPredecessors;
+  _domainCache = pOther._domainCache;
+  _satisfactionCache = pOther._satisfactionCache;
 }
 
 bool Goal::operator==(const Goal& pOther) const
 {
-  return *_objective == *pOther._objective &&
+  return (_objective == pOther._objective || *_objective == *pOther._objective) &&
       _maxTimeToKeepInactive == pOther._maxTimeToKeepInactive &&
       _isPersistentIfSkipped == pOther._isPersistentIfSkipped &&
       _oneStepTowards == pOther._oneStepTowards &&
       _goalGroupId == pOther._goalGroupId &&
       _uuidOfLastDomainUsedForCache == pOther._uuidOfLastDomainUsedForCache &&
-      _cacheOfActionsThatCanSatisfyThisGoal == pOther._cacheOfActionsThatCanSatisfyThisGoal &&
-      _cacheOfEventsIdThatCanSatisfyThisGoal == pOther._cacheOfEventsIdThatCanSatisfyThisGoal &&
-      _cacheOfActionsPredecessors == pOther._cacheOfActionsPredecessors &&
-      _cacheOfEventsPredecessors == pOther._cacheOfEventsPredecessors;
+      (_domainCache == pOther._domainCache || *_domainCache == *pOther._domainCache);
+}
+
+
+bool Goal::DomainCache::operator==(const DomainCache& pOther) const
+{
+  return actionsThatCanSatisfyThisGoal == pOther.actionsThatCanSatisfyThisGoal &&
+      eventsIdThatCanSatisfyThisGoal == pOther.eventsIdThatCanSatisfyThisGoal &&
+      actionsPredecessors == pOther.actionsPredecessors &&
+      eventsPredecessors == pOther.eventsPredecessors;
 }
 
 std::unique_ptr<Goal> Goal::clone() const
@@ -119,6 +139,16 @@ void Goal::notifyActivity()
   _inactiveSince.reset();
 }
 
+std::optional<std::chrono::steady_clock::time_point> Goal::getInactivityExpiry() const
+{
+  if (_maxTimeToKeepInactive < 0 || !_inactiveSince)
+    return {};
+  if (_maxTimeToKeepInactive == 0)
+    return *_inactiveSince;
+  // isInactiveForTooLong compares whole seconds with a strict superiority
+  return *_inactiveSince + std::chrono::seconds(_maxTimeToKeepInactive + 1);
+}
+
 std::string Goal::toStr() const
 {
   auto res = _objective->toStr();
@@ -140,6 +170,48 @@ std::string Goal::toPddl(std::size_t pIdentation) const
 }
 
 
+bool Goal::isSatisfied(const WorldState& pWorldState) const
+{
+  auto& cache = _satisfactionCache;
+  if (!cache.watchedFactNames)
+  {
+    auto watchedFactNames = std::make_shared<std::vector<std::string>>();
+    _objective->forAll([&](const FactOptional& pFactOptional, bool) {
+      const auto& factName = pFactOptional.fact.name();
+      if (std::find(watchedFactNames->begin(), watchedFactNames->end(), factName) == watchedFactNames->end())
+        watchedFactNames->push_back(factName);
+      return ContinueOrBreak::CONTINUE;
+    });
+    cache.watchedFactNames = std::move(watchedFactNames);
+    cache.isComputed = false;
+  }
+
+  const auto& setOfFacts = pWorldState.factsMapping();
+  const auto& watchedFactNames = *cache.watchedFactNames;
+  if (cache.isComputed)
+  {
+    bool aWatchedFactChanged = false;
+    for (std::size_t i = 0; i < watchedFactNames.size(); ++i)
+    {
+      if (cache.watchedFactVersions[i] != setOfFacts.getFactNameVersion(watchedFactNames[i]))
+      {
+        aWatchedFactChanged = true;
+        break;
+      }
+    }
+    if (!aWatchedFactChanged)
+      return cache.isSatisfied;
+  }
+
+  cache.watchedFactVersions.resize(watchedFactNames.size());
+  for (std::size_t i = 0; i < watchedFactNames.size(); ++i)
+    cache.watchedFactVersions[i] = setOfFacts.getFactNameVersion(watchedFactNames[i]);
+  cache.isSatisfied = _objective->isTrue(pWorldState);
+  cache.isComputed = true;
+  return cache.isSatisfied;
+}
+
+
 bool Goal::isASimpleFactObjective() const
 {
   return _objective && _objective->fcFactPtr() != nullptr;
@@ -154,8 +226,7 @@ void Goal::refreshIfNeeded(const Domain& pDomain)
 
   ConditionsToValue conditionsToValue;
   conditionsToValue.add(*_objective, "goal");
-  _cacheOfActionsPredecessors.clear();
-  _cacheOfEventsPredecessors.clear();
+  auto domainCache = std::make_shared<DomainCache>();
 
   auto optFactIteration = [&](const FactOptional& pFactOptional,
                               const std::unique_ptr<Condition>& pPreCondition,
@@ -183,7 +254,6 @@ void Goal::refreshIfNeeded(const Domain& pDomain)
   };
 
   // Update actions cache
-  _cacheOfActionsThatCanSatisfyThisGoal.clear();
   for (const auto& currIdToAction : pDomain.getActions())
   {
     auto search = ContinueOrBreak::CONTINUE;
@@ -205,19 +275,20 @@ void Goal::refreshIfNeeded(const Domain& pDomain)
     }
     if (search == ContinueOrBreak::BREAK)
     {
-      _cacheOfActionsThatCanSatisfyThisGoal.insert(currIdToAction.first);
-      _cacheOfActionsPredecessors.insert(currIdToAction.first);
-      _cacheOfActionsPredecessors.insert(currAction.actionsPredecessorsCache.begin(),
-                                         currAction.actionsPredecessorsCache.end());
-      _cacheOfEventsPredecessors.insert(currAction.eventsPredecessorsCache.begin(),
-                                        currAction.eventsPredecessorsCache.end());
+      domainCache->actionsThatCanSatisfyThisGoal.insert(currIdToAction.first);
+      domainCache->actionsPredecessors.insert(currIdToAction.first);
+      domainCache->actionsPredecessors.insert(currAction.actionsPredecessorsCache.begin(),
+                                              currAction.actionsPredecessorsCache.end());
+      domainCache->eventsPredecessors.insert(currAction.eventsPredecessorsCache.begin(),
+                                             currAction.eventsPredecessorsCache.end());
     }
   }
 
   // Update events cache
-  _cacheOfEventsIdThatCanSatisfyThisGoal.clear();
+  std::size_t nbOfEvents = 0;
   for (const auto& currIdToSetOfEvents : pDomain.getSetOfEvents())
   {
+    nbOfEvents += currIdToSetOfEvents.second.events().size();
     for (const auto& currSetOfEvents : currIdToSetOfEvents.second.events())
     {
       auto fullEventId = currIdToSetOfEvents.first + "|" + currSetOfEvents.first;
@@ -229,16 +300,53 @@ void Goal::refreshIfNeeded(const Domain& pDomain)
         });
         if (search == ContinueOrBreak::BREAK)
         {
-          _cacheOfEventsIdThatCanSatisfyThisGoal.insert(fullEventId);
-          _cacheOfEventsPredecessors.insert(fullEventId);
-          _cacheOfActionsPredecessors.insert(currEvent.actionsPredecessorsCache.begin(),
-                                             currEvent.actionsPredecessorsCache.end());
-          _cacheOfEventsPredecessors.insert(currEvent.eventsPredecessorsCache.begin(),
-                                            currEvent.eventsPredecessorsCache.end());
+          domainCache->eventsIdThatCanSatisfyThisGoal.insert(fullEventId);
+          domainCache->eventsPredecessors.insert(fullEventId);
+          domainCache->actionsPredecessors.insert(currEvent.actionsPredecessorsCache.begin(),
+                                                  currEvent.actionsPredecessorsCache.end());
+          domainCache->eventsPredecessors.insert(currEvent.eventsPredecessorsCache.begin(),
+                                                 currEvent.eventsPredecessorsCache.end());
         }
       }
     }
   }
+
+  // Update the bitsets of the predecessors
+  const auto& actions = pDomain.actions();
+  domainCache->actionsPredecessorsIndexes.resize(actions.size(), false);
+  for (const auto& currActionId : domainCache->actionsPredecessors)
+  {
+    auto itAction = actions.find(currActionId);
+    if (itAction != actions.end() && itAction->second.indexInDomainCache < actions.size())
+      domainCache->actionsPredecessorsIndexes[itAction->second.indexInDomainCache] = true;
+  }
+  domainCache->eventsPredecessorsIndexes.resize(nbOfEvents, false);
+  for (const auto& currIdToSetOfEvents : pDomain.getSetOfEvents())
+  {
+    for (const auto& currSetOfEvents : currIdToSetOfEvents.second.events())
+    {
+      const Event& currEvent = currSetOfEvents.second;
+      if (currEvent.indexInDomainCache < nbOfEvents &&
+          domainCache->eventsPredecessors.count(generateFullEventId(currIdToSetOfEvents.first, currSetOfEvents.first)) > 0)
+        domainCache->eventsPredecessorsIndexes[currEvent.indexInDomainCache] = true;
+    }
+  }
+
+  _domainCache = std::move(domainCache);
+}
+
+
+bool Goal::isActionPredecessor(std::size_t pActionIndex) const
+{
+  const auto& indexes = _domainCache->actionsPredecessorsIndexes;
+  return pActionIndex < indexes.size() && indexes[pActionIndex];
+}
+
+
+bool Goal::isEventPredecessor(std::size_t pEventIndex) const
+{
+  const auto& indexes = _domainCache->eventsPredecessorsIndexes;
+  return pEventIndex < indexes.size() && indexes[pEventIndex];
 }
 
 
@@ -248,7 +356,7 @@ std::string Goal::printActionsThatCanSatisfyThisGoal() const
 
   // Print actions cache
   bool firstIteration = true;
-  for (const auto& currId : _cacheOfActionsThatCanSatisfyThisGoal)
+  for (const auto& currId : _domainCache->actionsThatCanSatisfyThisGoal)
   {
     if (firstIteration)
     {
@@ -264,7 +372,7 @@ std::string Goal::printActionsThatCanSatisfyThisGoal() const
 
   // Print events cache
   firstIteration = true;
-  for (const auto& currId : _cacheOfEventsIdThatCanSatisfyThisGoal)
+  for (const auto& currId : _domainCache->eventsIdThatCanSatisfyThisGoal)
   {
     if (firstIteration)
     {
@@ -286,12 +394,12 @@ std::string Goal::printActionsThatCanSatisfyThisGoal() const
 
 bool Goal::canActionSatisfyThisGoal(const ActionId& pActionId) const
 {
-  return _cacheOfActionsThatCanSatisfyThisGoal.count(pActionId) > 0;
+  return _domainCache->actionsThatCanSatisfyThisGoal.count(pActionId) > 0;
 }
 
 bool Goal::canEventSatisfyThisGoal(const ActionId& pFullEventId) const
 {
-  return _cacheOfEventsIdThatCanSatisfyThisGoal.count(pFullEventId) > 0;
+  return _domainCache->eventsIdThatCanSatisfyThisGoal.count(pFullEventId) > 0;
 }
 
 bool Goal::canDeductionSatisfyThisGoal(const ActionId& pDeductionId) const
@@ -300,6 +408,13 @@ bool Goal::canDeductionSatisfyThisGoal(const ActionId& pDeductionId) const
 }
 
 
+const std::shared_ptr<const Goal::DomainCache>& Goal::_getEmptyDomainCache()
+{
+  static const std::shared_ptr<const DomainCache> emptyDomainCache = std::make_shared<const DomainCache>();
+  return emptyDomainCache;
+}
+
+
 const std::string& Goal::getPersistFunctionName()
 {
   static const std::string persistFunctionName = "persist";
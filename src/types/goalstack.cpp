@@ -1,4 +1,5 @@
 #include <orderedgoalsplanner/types/goalstack.hpp>
+#include <algorithm>
 #include <map>
 #include <sstream>
 #include <orderedgoalsplanner/types/domain.hpp>
@@ -14,7 +15,9 @@ namespace ogp
 GoalStack::GoalStack(const GoalStack& pOther)
   : onGoalsChanged(),
     _goals(pOther._goals),
-    _currentGoalPtr(nullptr)
+    _currentGoalPtr(nullptr),
+    _inactivityExpiriesPtr(pOther._inactivityExpiriesPtr),
+    _lastGoalId(pOther._lastGoalId)
 {
 }
 
@@ -22,6 +25,8 @@ GoalStack& GoalStack::operator=(const GoalStack& pOther)
 {
   _goals = pOther._goals;
   _currentGoalPtr = nullptr;
+  _inactivityExpiriesPtr = pOther._inactivityExpiriesPtr;
+  _lastGoalId = pOther._lastGoalId;
   return *this;
 }
 
@@ -79,6 +84,7 @@ bool GoalStack::_iterateOnGoalsAndRemoveNonPersistent(
   bool res = false;
   if (pLookForAnActionOutputInfosPtr != nullptr)
     pLookForAnActionOutputInfosPtr->setType(PlannerStepType::FINISHED_ON_SUCCESS);
+  _updatePassedInactivityExpiries(pNow);
 
   bool isCurrentlyActiveGoal = true;
   for (auto itGoalsGroup = _goals.end(); itGoalsGroup != _goals.begin(); )
@@ -87,8 +93,9 @@ bool GoalStack::_iterateOnGoalsAndRemoveNonPersistent(
     for (auto itGoal = itGoalsGroup->second.begin(); itGoal != itGoalsGroup->second.end(); )
     {
       // If the goal was inactive for too long we remove it
-      if (!isCurrentlyActiveGoal && itGoal->isInactiveForTooLong(pNow))
+      if (!isCurrentlyActiveGoal && _isInactiveForTooLong(*itGoal, pNow))
       {
+        _onGoalRemoved(*itGoal);
         itGoal = itGoalsGroup->second.erase(itGoal);
         res = true;
         continue;
@@ -126,11 +133,12 @@ bool GoalStack::_iterateOnGoalsAndRemoveNonPersistent(
 
       if (itGoal->isPersistent())
       {
-        itGoal->setInactiveSinceIfNotAlreadySet(pNow);
+        _setGoalInactive(*itGoal, pNow);
         ++itGoal;
       }
       else
       {
+        _onGoalRemoved(*itGoal);
         itGoal = itGoalsGroup->second.erase(itGoal);
         res = true;
       }
@@ -208,6 +216,10 @@ void GoalStack::setGoals(const std::map<int, std::vector<Goal>>& pGoals,
     _currentGoalPtr = nullptr;
     {
       _goals = pGoals;
+      _inactivityExpiriesPtr.reset();
+      for (auto& currGoalsGroup : _goals)
+        for (auto& currGoal : currGoalsGroup.second)
+          _onGoalAdded(currGoal);
       onGoalsChanged(_goals);
     }
     if (_removeNoStackableGoals(pWorldState, pNow))
@@ -257,6 +269,8 @@ bool GoalStack::_addGoals(const std::map<int, std::vector<Goal>>& pGoals,
   {
     auto& existingGoals = _goals[currGoals.first];
     existingGoals.insert(existingGoals.begin(), currGoals.second.begin(), currGoals.second.end());
+    for (std::size_t i = 0; i < currGoals.second.size(); ++i)
+      _onGoalAdded(existingGoals[i]);
     goalChanged = true;
   }
   if (goalChanged)
@@ -272,7 +286,7 @@ void GoalStack::pushFrontGoal(const Goal& pGoal,
 {
   {
     auto& existingGoals = _goals[pPriority];
-    existingGoals.insert(existingGoals.begin(), pGoal);
+    _onGoalAdded(*existingGoals.insert(existingGoals.begin(), pGoal));
     onGoalsChanged(_goals);
   }
   if (_removeNoStackableGoals(pWorldState, pNow))
@@ -287,6 +301,7 @@ void GoalStack::pushBackGoal(const Goal& pGoal,
   {
     auto& existingGoals = _goals[pPriority];
     existingGoals.push_back(pGoal);
+    _onGoalAdded(existingGoals.back());
     onGoalsChanged(_goals);
   }
   if (_removeNoStackableGoals(pWorldState, pNow))
@@ -349,6 +364,7 @@ void GoalStack::clearGoals(const WorldState& pWorldState,
     return;
 
   _goals.clear();
+  _inactivityExpiriesPtr.reset();
   _removeNoStackableGoals(pWorldState, pNow);
   onGoalsChanged(_goals);
 }
@@ -365,6 +381,7 @@ bool GoalStack::removeGoals(const std::string& pGoalGroupId,
     {
       if (it->getGoalGroupId() == pGoalGroupId)
       {
+        _onGoalRemoved(*it);
         it = itGroup->second.erase(it);
         goalChanged = true;
       }
@@ -481,6 +498,7 @@ bool GoalStack::_removeNoStackableGoals(const WorldState& pWorldState,
 {
   bool res = false;
   bool firstGoal = true;
+  _updatePassedInactivityExpiries(pNow);
   for (auto itGoalsGroup = _goals.end(); itGoalsGroup != _goals.begin(); )
   {
     --itGoalsGroup;
@@ -499,13 +517,14 @@ bool GoalStack::_removeNoStackableGoals(const WorldState& pWorldState,
         continue;
       }
 
-      if (!itGoal->isInactiveForTooLong(pNow))
+      if (!_isInactiveForTooLong(*itGoal, pNow))
       {
-        itGoal->setInactiveSinceIfNotAlreadySet(pNow);
+        _setGoalInactive(*itGoal, pNow);
         ++itGoal;
       }
       else
       {
+        _onGoalRemoved(*itGoal);
         itGoal = itGoalsGroup->second.erase(itGoal);
         res = true;
       }
@@ -514,10 +533,140 @@ bool GoalStack::_removeNoStackableGoals(const WorldState& pWorldState,
     if (itGoalsGroup->second.empty())
       itGoalsGroup = _goals.erase(itGoalsGroup);
   }
+  return res;
+}
+
+
+std::optional<std::chrono::steady_clock::time_point> GoalStack::nextExpiry() const
+{
+  if (!_inactivityExpiriesPtr || _inactivityExpiriesPtr->notPassed.empty())
+    return {};
+  return _inactivityExpiriesPtr->notPassed.begin()->expiry;
+}
+
+
+bool GoalStack::removeGoalsInactiveForTooLong(const WorldState& pWorldState,
+                                              const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow)
+{
+  _updatePassedInactivityExpiries(pNow);
+  if (!pNow || !_inactivityExpiriesPtr || _inactivityExpiriesPtr->passedGoalIds.empty())
+    return false;
 
+  // The world can have changed since the goals became inactive, so the active goal is searched again
+  // and only the goals below it are removed
+  bool res = false;
+  bool activeGoalFound = false;
+  for (auto itGoalsGroup = _goals.end(); itGoalsGroup != _goals.begin(); )
+  {
+    --itGoalsGroup;
+    for (auto itGoal = itGoalsGroup->second.begin(); itGoal != itGoalsGroup->second.end(); )
+    {
+      if (!activeGoalFound)
+      {
+        activeGoalFound = !pWorldState.isGoalSatisfied(*itGoal);
+        ++itGoal;
+      }
+      else if (_inactivityExpiriesPtr->passedGoalIds.count(itGoal->_idInGoalStack) > 0)
+      {
+        _onGoalRemoved(*itGoal);
+        itGoal = itGoalsGroup->second.erase(itGoal);
+        res = true;
+      }
+      else
+      {
+        ++itGoal;
+      }
+    }
+
+    if (itGoalsGroup->second.empty())
+      itGoalsGroup = _goals.erase(itGoalsGroup);
+  }
+
+  if (res)
+    onGoalsChanged(_goals);
   return res;
 }
 
 
+bool GoalStack::InactivityExpiry::operator<(const InactivityExpiry& pOther) const
+{
+  if (expiry != pOther.expiry)
+    return expiry < pOther.expiry;
+  return goalId < pOther.goalId;
+}
+
+
+GoalStack::InactivityExpiries& GoalStack::_getInactivityExpiriesToModify()
+{
+  if (!_inactivityExpiriesPtr)
+    _inactivityExpiriesPtr = std::make_shared<InactivityExpiries>();
+  else if (_inactivityExpiriesPtr.use_count() > 1)
+    _inactivityExpiriesPtr = std::make_shared<InactivityExpiries>(*_inactivityExpiriesPtr);
+  return *_inactivityExpiriesPtr;
+}
+
+
+void GoalStack::_onGoalAdded(Goal& pGoal)
+{
+  pGoal._idInGoalStack = ++_lastGoalId;
+  auto expiry = pGoal.getInactivityExpiry();
+  if (expiry)
+    _getInactivityExpiriesToModify().notPassed.insert(InactivityExpiry{*expiry, pGoal._idInGoalStack});
+}
+
+
+void GoalStack::_onGoalRemoved(const Goal& pGoal)
+{
+  if (!_inactivityExpiriesPtr)
+    return;
+  auto expiry = pGoal.getInactivityExpiry();
+  if (!expiry)
+    return;
+  auto& inactivityExpiries = _getInactivityExpiriesToModify();
+  if (inactivityExpiries.notPassed.erase(InactivityExpiry{*expiry, pGoal._idInGoalStack}) == 0)
+    inactivityExpiries.passedGoalIds.erase(pGoal._idInGoalStack);
+}
+
+
+void GoalStack::_setGoalInactive(Goal& pGoal,
+                                 const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow)
+{
+  if (pGoal.getInactiveSince() || !pNow)
+    return;
+  pGoal.setInactiveSinceIfNotAlreadySet(pNow);
+  auto expiry = pGoal.getInactivityExpiry();
+  if (expiry)
+    _getInactivityExpiriesToModify().notPassed.insert(InactivityExpiry{*expiry, pGoal._idInGoalStack});
+}
+
+
+void GoalStack::_updatePassedInactivityExpiries(const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow)
+{
+  if (!pNow || !_inactivityExpiriesPtr || _inactivityExpiriesPtr->notPassed.empty() ||
+      *pNow < _inactivityExpiriesPtr->notPassed.begin()->expiry)
+    return;
+  auto& inactivityExpiries = _getInactivityExpiriesToModify();
+  auto itEnd = inactivityExpiries.notPassed.begin();
+  while (itEnd != inactivityExpiries.notPassed.end() && itEnd->expiry <= *pNow)
+  {
+    inactivityExpiries.passedGoalIds.insert(itEnd->goalId);
+    ++itEnd;
+  }
+  inactivityExpiries.notPassed.erase(inactivityExpiries.notPassed.begin(), itEnd);
+}
+
+
+bool GoalStack::_isInactiveForTooLong(const Goal& pGoal,
+                                      const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow) const
+{
+  const int maxTimeToKeepInactive = pGoal.getMaxTimeToKeepInactive();
+  if (maxTimeToKeepInactive < 0)
+    return false;
+  if (maxTimeToKeepInactive == 0)
+    return true;
+  return pNow && _inactivityExpiriesPtr &&
+      _inactivityExpiriesPtr->passedGoalIds.count(pGoal._idInGoalStack) > 0;
+}
+
 
 } // !ogp
@@ -1,4 +1,5 @@
 #include <orderedgoalsplanner/types/historical.hpp>
+#include <atomic>
 
 
 namespace ogp
@@ -10,6 +11,21 @@ void Historical::setMutex(std::shared_ptr<std::mutex> pMutex)
   _mutexPtr = std::move(pMutex);
 }
 
+Historical Historical::snapshot() const
+{
+  Historical res;
+  if (_mutexPtr)
+  {
+    std::lock_guard<std::mutex> lock(*_mutexPtr);
+    res._actionToNumberOfTimeAleardyDone = _actionToNumberOfTimeAleardyDone;
+  }
+  else
+  {
+    res._actionToNumberOfTimeAleardyDone = _actionToNumberOfTimeAleardyDone;
+  }
+  return res;
+}
+
 void Historical::notifyActionDone(const ActionId& pActionId)
 {
   if (_mutexPtr)
@@ -26,8 +42,21 @@ void Historical::notifyActionDone(const ActionId& pActionId)
 
 void Historical::_notifyActionDone(const ActionId& pActionId)
 {
-  _actionToNumberOfTimeAleardyDone.emplace(pActionId, 0);
-  ++_actionToNumberOfTimeAleardyDone[pActionId];
+  if (!_actionToNumberOfTimeAleardyDone)
+  {
+    _actionToNumberOfTimeAleardyDone = std::make_shared<std::map<ActionId, std::size_t>>();
+  }
+  else if (_actionToNumberOfTimeAleardyDone.use_count() > 1)
+  {
+    // Copy on write, to not modify the container seen by the snapshots and by the copies of this historical
+    _actionToNumberOfTimeAleardyDone = std::make_shared<std::map<ActionId, std::size_t>>(*_actionToNumberOfTimeAleardyDone);
+  }
+  else
+  {
+    // Not shared, so it is modified in place. The fence orders the last reads of a released snapshot before this write
+    std::atomic_thread_fence(std::memory_order_acquire);
+  }
+  ++(*_actionToNumberOfTimeAleardyDone)[pActionId];
 }
 
 
@@ -53,13 +82,15 @@ std::size_t Historical::getNbOfTimeAnActionHasAlreadyBeenDone(const ActionId& pA
 
 bool Historical::_hasActionAlreadyBeenDone(const ActionId& pActionId) const
 {
-  return _actionToNumberOfTimeAleardyDone.count(pActionId) > 0;
+  return _actionToNumberOfTimeAleardyDone && _actionToNumberOfTimeAleardyDone->count(pActionId) > 0;
 }
 
 std::size_t Historical::_getNbOfTimeAnActionHasAlreadyBeenDone(const ActionId& pActionId) const
 {
-  auto it = _actionToNumberOfTimeAleardyDone.find(pActionId);
-  if (it == _actionToNumberOfTimeAleardyDone.end())
+  if (!_actionToNumberOfTimeAleardyDone)
+    return 0;
+  auto it = _actionToNumberOfTimeAleardyDone->find(pActionId);
+  if (it == _actionToNumberOfTimeAleardyDone->end())
     return 0;
   return it->second;
 }
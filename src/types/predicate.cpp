@@ -32,7 +32,8 @@ Predicate::Predicate(const std::string& pStr,
                      std::size_t* pResPos)
   : name(),
     parameters(),
-    fluent()
+    fluent(),
+    signaturesTable()
 {
   std::size_t pos = pBeginPos;
   auto expressionParsed = pStrPddlFormated ?
@@ -59,6 +60,17 @@ Predicate::Predicate(const std::string& pStr,
 }
 
 
+Predicate::Predicate(const std::string& pName,
+                     const std::vector<Parameter>& pParameters,
+                     const std::shared_ptr<Type>& pFluent)
+  : name(pName),
+    parameters(pParameters),
+    fluent(pFluent),
+    signaturesTable()
+{
+}
+
+
 std::string Predicate::toPddl() const
 {
   std::string res = "(" + name;
@@ -1,5 +1,6 @@
 #include <orderedgoalsplanner/types/setofderivedpredicates.hpp>
 #include <orderedgoalsplanner/types/derivedpredicate.hpp>
+#include "factsignaturestable.hpp"
 
 
 namespace ogp
@@ -19,7 +20,10 @@ void SetOfDerivedPredicates::addAll(const SetOfDerivedPredicates& pOther)
 void SetOfDerivedPredicates::addDerivedPredicate(const DerivedPredicate& pDerivedPredicate)
 {
   _nameToDerivedPredicate.erase(pDerivedPredicate.predicate.name);
-  _nameToDerivedPredicate.emplace(pDerivedPredicate.predicate.name, pDerivedPredicate);
+  auto& predicate = _nameToDerivedPredicate.emplace(pDerivedPredicate.predicate.name, pDerivedPredicate).first->second.predicate;
+  // The signatures of the facts are precomputed once, the copies of the predicate share them
+  if (!predicate.signaturesTable)
+    predicate.signaturesTable = FactSignaturesTable::create(predicate);
 }
 
 
@@ -1,4 +1,5 @@
 #include <orderedgoalsplanner/types/setofentities.hpp>
+#include <algorithm>
 #include <vector>
 #include <orderedgoalsplanner/util/util.hpp>
 #include <orderedgoalsplanner/types/setoftypes.hpp>
@@ -8,7 +9,8 @@ namespace ogp
 
 SetOfEntities::SetOfEntities()
     : _valueToEntity(),
-      _typeNameToEntities()
+      _typeNameToEntities(),
+      _typeNameToEntitiesWithSubTypes()
 {
 }
 
@@ -23,11 +25,25 @@ SetOfEntities SetOfEntities::fromPddl(const std::string& pStr,
 
 void SetOfEntities::add(const Entity& pEntity)
 {
-  _valueToEntity.erase(pEntity.value);
+  auto itOldEntity = _valueToEntity.find(pEntity.value);
+  if (itOldEntity != _valueToEntity.end())
+  {
+    _remove(itOldEntity->second);
+    _valueToEntity.erase(itOldEntity);
+  }
   _valueToEntity.emplace(pEntity.value, pEntity);
 
   if (pEntity.type)
+  {
     _typeNameToEntities[pEntity.type->name].insert(pEntity);
+    for (auto* typePtr = pEntity.type.get(); typePtr != nullptr; typePtr = typePtr->parent.get())
+    {
+      auto& entities = _typeNameToEntitiesWithSubTypes[typePtr->name];
+      auto itInsertion = std::lower_bound(entities.begin(), entities.end(), pEntity);
+      if (itInsertion == entities.end() || pEntity < *itInsertion)
+        entities.insert(itInsertion, pEntity);
+    }
+  }
 }
 
 void SetOfEntities::addAllFromPddl(const std::string& pStr,
@@ -74,6 +90,14 @@ const std::set<Entity>* SetOfEntities::typeNameToEntities(const std::string& pTy
   return nullptr;
 }
 
+const std::vector<Entity>* SetOfEntities::typeNameToEntitiesWithSubTypes(const std::string& pTypename) const
+{
+  auto it = _typeNameToEntitiesWithSubTypes.find(pTypename);
+  if (it != _typeNameToEntitiesWithSubTypes.end())
+    return &it->second;
+  return nullptr;
+}
+
 const Entity* SetOfEntities::valueToEntity(const std::string& pValue) const
 {
   auto it = _valueToEntity.find(pValue);
@@ -112,4 +136,32 @@ std::string SetOfEntities::toStr(std::size_t pIdentation) const
 }
 
 
+void SetOfEntities::_remove(const Entity& pEntity)
+{
+  if (!pEntity.type)
+    return;
+
+  auto itEntities = _typeNameToEntities.find(pEntity.type->name);
+  if (itEntities != _typeNameToEntities.end())
+  {
+    itEntities->second.erase(pEntity);
+    if (itEntities->second.empty())
+      _typeNameToEntities.erase(itEntities);
+  }
+
+  for (auto* typePtr = pEntity.type.get(); typePtr != nullptr; typePtr = typePtr->parent.get())
+  {
+    auto itEntitiesWithSubTypes = _typeNameToEntitiesWithSubTypes.find(typePtr->name);
+    if (itEntitiesWithSubTypes == _typeNameToEntitiesWithSubTypes.end())
+      continue;
+    auto& entities = itEntitiesWithSubTypes->second;
+    auto itEntity = std::lower_bound(entities.begin(), entities.end(), pEntity);
+    if (itEntity != entities.end() && !(pEntity < *itEntity))
+      entities.erase(itEntity);
+    if (entities.empty())
+      _typeNameToEntitiesWithSubTypes.erase(itEntitiesWithSubTypes);
+  }
+}
+
+
 } // !ogp
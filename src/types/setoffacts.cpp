@@ -1,5 +1,7 @@
 #include <orderedgoalsplanner/types/setoffacts.hpp>
+#include <atomic>
 #include <stdexcept>
+#include <unordered_map>
 #include <orderedgoalsplanner/types/fact.hpp>
 #include <orderedgoalsplanner/util/alias.hpp>
 #include <orderedgoalsplanner/util/util.hpp>
@@ -9,6 +11,11 @@ namespace ogp
 {
 namespace
 {
+/// Last version reserved by a set of facts.
+std::atomic<std::size_t> _lastFactNameVersion(0);
+/// Number of versions that a set of facts reserves at once, to not increase the shared counter at each modification.
+const std::size_t _nbOfFactNameVersionsToReserve = 64;
+
 std::string _getExactCall(const Fact& pFact)
 {
   auto res = pFact.name();
@@ -49,11 +56,39 @@ SetOfFacts::SetOfFacts()
  : _facts(),
    _exactCallToListsOpt(),
    _exactCallWithoutFluentToListsOpt(),
-   _signatureToLists()
+   _signatureToLists(),
+   _factNameToVersion(),
+   _reservedVersions()
 {
 }
 
 
+SetOfFacts::SetOfFacts(const SetOfFacts& pOther)
+ : _facts(pOther._facts),
+   _exactCallToListsOpt(pOther._exactCallToListsOpt),
+   _exactCallWithoutFluentToListsOpt(pOther._exactCallWithoutFluentToListsOpt),
+   _signatureToLists(pOther._signatureToLists),
+   _factNameToVersion(pOther._factNameToVersion),
+   _reservedVersions()
+{
+  _redirectListsFrom(pOther);
+}
+
+
+SetOfFacts& SetOfFacts::operator=(const SetOfFacts& pOther)
+{
+  if (this == &pOther)
+    return *this;
+  _facts = pOther._facts;
+  _exactCallToListsOpt = pOther._exactCallToListsOpt;
+  _exactCallWithoutFluentToListsOpt = pOther._exactCallWithoutFluentToListsOpt;
+  _signatureToLists = pOther._signatureToLists;
+  _factNameToVersion = pOther._factNameToVersion;
+  _redirectListsFrom(pOther);
+  return *this;
+}
+
+
 SetOfFacts SetOfFacts::fromPddl(const std::string& pStr,
                                 std::size_t& pPos,
                                 const Ontology& pOntology,
@@ -79,7 +114,15 @@ SetOfFacts SetOfFacts::fromPddl(const std::string& pStr,
 
 std::string SetOfFacts::toPddl(std::size_t pIdentation, bool pPrintTimeLessFactsToo) const
 {
-  std::string res;
+  std::ostringstream res;
+  toPddl(res, pIdentation, pPrintTimeLessFactsToo);
+  return res.str();
+}
+
+
+void SetOfFacts::toPddl(std::ostream& pOutput, std::size_t pIdentation, bool pPrintTimeLessFactsToo) const
+{
+  const std::string identationStr(pIdentation, ' ');
   bool firstIteration = true;
   for (auto& currFact : _facts)
   {
@@ -88,10 +131,10 @@ std::string SetOfFacts::toPddl(std::size_t pIdentation, bool pPrintTimeLessFacts
     if (firstIteration)
       firstIteration = false;
     else
-      res += "\n";
-    res += std::string(pIdentation, ' ') + currFact.first.toPddl(false, true);
+      pOutput << "\n";
+    pOutput << identationStr;
+    currFact.first.toPddl(pOutput, false, true);
   }
-  return res;
 }
 
 
@@ -100,51 +143,101 @@ void SetOfFacts::add(const Fact& pFact,
                      bool pCanBeRemoved)
 {
   auto insertionResult = _facts.emplace(pFact, pCanBeRemoved);
+  if (insertionResult.second)
+    _addInLists(insertionResult.first->first);
+}
+
+
+void SetOfFacts::add(Fact&& pFact,
+                     bool pCanBeRemoved)
+{
+  auto insertionResult = _facts.emplace(std::move(pFact), pCanBeRemoved);
+  if (insertionResult.second)
+    _addInLists(insertionResult.first->first);
+}
+
+
+void SetOfFacts::_addInLists(const Fact& pFact)
+{
+  _increaseFactNameVersion(pFact.name());
 
   if (!pFact.hasAParameter())
   {
     auto exactCallStr = _getExactCall(pFact);
     if (!_exactCallWithoutFluentToListsOpt)
       _exactCallWithoutFluentToListsOpt.emplace();
-    (*_exactCallWithoutFluentToListsOpt)[exactCallStr].emplace_back(pFact);
+    (*_exactCallWithoutFluentToListsOpt)[exactCallStr].emplace_back(&pFact);
 
     if (pFact.fluent())
     {
       _addFluentToExactCall(exactCallStr, pFact);
       if (!_exactCallToListsOpt)
         _exactCallToListsOpt.emplace();
-      (*_exactCallToListsOpt)[exactCallStr].emplace_back(pFact);
+      (*_exactCallToListsOpt)[exactCallStr].emplace_back(&pFact);
     }
   }
 
 
-  std::list<std::string> factSignatures;
-  pFact.generateSignatureForAllUpperTypes(factSignatures);
+  std::vector<FactSignatureId> factSignatures;
+  pFact.signatureIdsForAllUpperTypes(factSignatures);
   for (auto& currSignature : factSignatures)
   {
     auto& factArguments = pFact.arguments();
     auto insertionRes = _signatureToLists.emplace(currSignature, factArguments.size());
     ParameterToValues& parameterToValues = insertionRes.first->second;
 
-    parameterToValues.all.emplace_back(pFact);
+    parameterToValues.all.emplace_back(&pFact);
     for (std::size_t i = 0; i < factArguments.size(); ++i)
     {
       if (!factArguments[i].isAParameterToFill())
-        parameterToValues.argIdToArgValueToValues[i][factArguments[i].value].emplace_back(pFact);
+        parameterToValues.argIdToArgValueToValues[i][factArguments[i].value].emplace_back(&pFact);
       else
-        parameterToValues.argIdToArgValueToValues[i][""].emplace_back(pFact);
+        parameterToValues.argIdToArgValueToValues[i][""].emplace_back(&pFact);
     }
     if (pFact.fluent())
     {
       if (!pFact.fluent()->isAParameterToFill() && !pFact.isValueNegated())
-        parameterToValues.fluentValueToValues[pFact.fluent()->value].emplace_back(pFact);
+        parameterToValues.fluentValueToValues[pFact.fluent()->value].emplace_back(&pFact);
       else
-        parameterToValues.fluentValueToValues[""].emplace_back(pFact);
+        parameterToValues.fluentValueToValues[""].emplace_back(&pFact);
     }
   }
 }
 
 
+void SetOfFacts::_redirectListsFrom(const SetOfFacts& pOther)
+{
+  // The facts are copied in the same order, so the nth fact of this set is the copy of the nth fact of the other set
+  std::unordered_map<const Fact*, const Fact*> otherFactToFact;
+  otherFactToFact.reserve(_facts.size());
+  auto itFact = _facts.begin();
+  for (const auto& currOtherFact : pOther._facts)
+    otherFactToFact.emplace(&currOtherFact.first, &(itFact++)->first);
+
+  auto redirectList = [&](std::list<const Fact*>& pList) {
+    for (auto& currFactPtr : pList)
+      currFactPtr = otherFactToFact[currFactPtr];
+  };
+  auto redirectLists = [&](std::map<std::string, std::list<const Fact*>>& pLists) {
+    for (auto& currList : pLists)
+      redirectList(currList.second);
+  };
+
+  if (_exactCallToListsOpt)
+    redirectLists(*_exactCallToListsOpt);
+  if (_exactCallWithoutFluentToListsOpt)
+    redirectLists(*_exactCallWithoutFluentToListsOpt);
+  for (auto& currSignatureToLists : _signatureToLists)
+  {
+    ParameterToValues& parameterToValues = currSignatureToLists.second;
+    redirectList(parameterToValues.all);
+    for (auto& currArgValueToValues : parameterToValues.argIdToArgValueToValues)
+      redirectLists(currArgValueToValues);
+    redirectLists(parameterToValues.fluentValueToValues);
+  }
+}
+
+
 bool SetOfFacts::erase(const Fact& pFact)
 {
   if (_erase(pFact))
@@ -152,7 +245,11 @@ bool SetOfFacts::erase(const Fact& pFact)
 
   auto factIt = find(pFact);
   for (const auto& currFact : factIt)
-    return _erase(currFact);
+  {
+    // Copy the fact because the reference points to the fact that is removed
+    const Fact factToErase = currFact;
+    return _erase(factToErase);
+  }
   return false;
 }
 
@@ -165,14 +262,15 @@ bool SetOfFacts::_erase(const Fact& pFact)
     // Do not allow to remove if this fact is marked as cannot be removed
     if (!it->second)
       return false;
+    const Fact* factPtr = &it->first;
 
     if (!pFact.hasAParameter())
     {
       auto exactCallStr = _getExactCall(pFact);
       if (_exactCallWithoutFluentToListsOpt)
       {
-        std::list<Fact>& listOfTypes = (*_exactCallWithoutFluentToListsOpt)[exactCallStr];
-        _removeAValueForList(listOfTypes, pFact);
+        std::list<const Fact*>& listOfTypes = (*_exactCallWithoutFluentToListsOpt)[exactCallStr];
+        _removeAValueForList(listOfTypes, factPtr);
         if (listOfTypes.empty())
           _exactCallWithoutFluentToListsOpt->erase(exactCallStr);
       }
@@ -180,15 +278,15 @@ bool SetOfFacts::_erase(const Fact& pFact)
       if (_exactCallToListsOpt && pFact.fluent())
       {
         _addFluentToExactCall(exactCallStr, pFact);
-        std::list<Fact>& listWithFluentOfTypes = (*_exactCallToListsOpt)[exactCallStr];
-        _removeAValueForList(listWithFluentOfTypes, pFact);
+        std::list<const Fact*>& listWithFluentOfTypes = (*_exactCallToListsOpt)[exactCallStr];
+        _removeAValueForList(listWithFluentOfTypes, factPtr);
         if (listWithFluentOfTypes.empty())
           _exactCallToListsOpt->erase(exactCallStr);
       }
     }
 
-    std::list<std::string> factSignatures;
-    pFact.generateSignatureForAllUpperTypes(factSignatures);
+    std::vector<FactSignatureId> factSignatures;
+    pFact.signatureIdsForAllUpperTypes(factSignatures);
     for (auto itSignature = factSignatures.rbegin(); itSignature != factSignatures.rend(); ++itSignature)
     {
       auto& currSignature = *itSignature;
@@ -198,7 +296,7 @@ bool SetOfFacts::_erase(const Fact& pFact)
       {
         ParameterToValues& parameterToValues = itParameterToValues->second;
 
-        _removeAValueForList(parameterToValues.all, pFact);
+        _removeAValueForList(parameterToValues.all, factPtr);
         if (parameterToValues.all.empty())
         {
           _signatureToLists.erase(currSignature);
@@ -208,16 +306,16 @@ bool SetOfFacts::_erase(const Fact& pFact)
           for (std::size_t i = 0; i < factArguments.size(); ++i)
           {
             const std::string argKey = !factArguments[i].isAParameterToFill() ? factArguments[i].value : "";
-            std::list<Fact>& listOfValues = parameterToValues.argIdToArgValueToValues[i][argKey];
-            _removeAValueForList(listOfValues, pFact);
+            std::list<const Fact*>& listOfValues = parameterToValues.argIdToArgValueToValues[i][argKey];
+            _removeAValueForList(listOfValues, factPtr);
             if (listOfValues.empty())
                parameterToValues.argIdToArgValueToValues[i].erase(argKey);
           }
           if (pFact.fluent())
           {
             const std::string fluentKey = !pFact.fluent()->isAParameterToFill() ? pFact.fluent()->value : "";
-            std::list<Fact>& listOfValues = parameterToValues.fluentValueToValues[fluentKey];
-            _removeAValueForList(listOfValues, pFact);
+            std::list<const Fact*>& listOfValues = parameterToValues.fluentValueToValues[fluentKey];
+            _removeAValueForList(listOfValues, factPtr);
             if (listOfValues.empty())
                parameterToValues.fluentValueToValues.erase(fluentKey);
           }
@@ -230,6 +328,7 @@ bool SetOfFacts::_erase(const Fact& pFact)
     }
 
     _facts.erase(it);
+    _increaseFactNameVersion(pFact.name());
     return true;
   }
   return false;
@@ -262,13 +361,15 @@ void SetOfFacts::clear()
   if (_exactCallWithoutFluentToListsOpt)
     _exactCallWithoutFluentToListsOpt.reset();
   _signatureToLists.clear();
+  for (auto& currFactNameToVersion : _factNameToVersion)
+    currFactNameToVersion.second = _newFactNameVersion();
 }
 
 
 typename SetOfFacts::SetOfFactIterator SetOfFacts::find(const Fact& pFact,
                                                         bool pIgnoreFluent) const
 {
-  const std::list<Fact>* exactMatchPtr = nullptr;
+  const std::list<const Fact*>* exactMatchPtr = nullptr;
 
   if (!pFact.hasAParameter(pIgnoreFluent) && !pFact.isValueNegated())
   {
@@ -285,8 +386,8 @@ typename SetOfFacts::SetOfFactIterator SetOfFacts::find(const Fact& pFact,
     return SetOfFactIterator(exactMatchPtr);
   }
 
-  const std::list<Fact>* resPtr = nullptr;
-  auto _matchArg = [&](const std::map<std::string, std::list<Fact>>& pArgValueToValues,
+  const std::list<const Fact*>* resPtr = nullptr;
+  auto _matchArg = [&](const std::map<std::string, std::list<const Fact*>>& pArgValueToValues,
                        const std::string& pArgValue) -> std::optional<typename SetOfFacts::SetOfFactIterator> {
     auto itForThisValue = pArgValueToValues.find(pArgValue);
     if (itForThisValue != pArgValueToValues.end())
@@ -301,7 +402,7 @@ typename SetOfFacts::SetOfFactIterator SetOfFacts::find(const Fact& pFact,
     return {};
   };
 
-  auto itParameterToValues = _signatureToLists.find(pFact.factSignature());
+  auto itParameterToValues = _signatureToLists.find(pFact.signatureId());
   if (itParameterToValues != _signatureToLists.end())
   {
     const ParameterToValues& parameterToValues = itParameterToValues->second;
@@ -386,12 +487,38 @@ void SetOfFacts::extractPotentialArgumentsOfAFactParameter(
 }
 
 
-void SetOfFacts::_removeAValueForList(std::list<Fact>& pList,
-                                     const Fact& pValue) const
+std::size_t SetOfFacts::getFactNameVersion(const std::string& pFactName) const
+{
+  auto it = _factNameToVersion.find(pFactName);
+  if (it != _factNameToVersion.end())
+    return it->second;
+  return 0;
+}
+
+
+void SetOfFacts::_increaseFactNameVersion(const std::string& pFactName)
+{
+  _factNameToVersion[pFactName] = _newFactNameVersion();
+}
+
+
+std::size_t SetOfFacts::_newFactNameVersion()
+{
+  if (_reservedVersions.next == _reservedVersions.end)
+  {
+    _reservedVersions.next = _lastFactNameVersion.fetch_add(_nbOfFactNameVersionsToReserve) + 1;
+    _reservedVersions.end = _reservedVersions.next + _nbOfFactNameVersionsToReserve;
+  }
+  return _reservedVersions.next++;
+}
+
+
+void SetOfFacts::_removeAValueForList(std::list<const Fact*>& pList,
+                                     const Fact* pValuePtr) const
 {
   for (auto it = pList.begin(); it != pList.end(); ++it)
   {
-    if (*it == pValue)
+    if (*it == pValuePtr)
     {
       pList.erase(it);
       return;
@@ -400,8 +527,8 @@ void SetOfFacts::_removeAValueForList(std::list<Fact>& pList,
 }
 
 
-const std::list<Fact>* SetOfFacts::_findAnExactCall(
-    const std::optional<std::map<std::string, std::list<Fact>>>& pExactCalls,
+const std::list<const Fact*>* SetOfFacts::_findAnExactCall(
+    const std::optional<std::map<std::string, std::list<const Fact*>>>& pExactCalls,
     const std::string& pExactCall) const
 {
   if (pExactCalls)
@@ -3,6 +3,7 @@
 #include <orderedgoalsplanner/types/setoftypes.hpp>
 #include <orderedgoalsplanner/util/util.hpp>
 #include "expressionParsed.hpp"
+#include "factsignaturestable.hpp"
 
 namespace ogp
 {
@@ -55,7 +56,10 @@ void SetOfPredicates::addAll(const SetOfPredicates& pOther)
 void SetOfPredicates::addPredicate(const Predicate& pPredicate)
 {
   _nameToPredicate.erase(pPredicate.name);
-  _nameToPredicate.emplace(pPredicate.name, pPredicate);
+  auto& predicate = _nameToPredicate.emplace(pPredicate.name, pPredicate).first->second;
+  // The signatures of the facts are precomputed once, the copies of the predicate share them
+  if (!predicate.signaturesTable)
+    predicate.signaturesTable = FactSignaturesTable::create(predicate);
 }
 
 const Predicate* SetOfPredicates::nameToPredicatePtr(const std::string& pName) const
@@ -1,4 +1,5 @@
 #include <orderedgoalsplanner/types/setoftypes.hpp>
+#include <atomic>
 #include <stdexcept>
 #include <sstream>
 #include <vector>
@@ -12,6 +13,19 @@ namespace
 const std::string _numberTypeName = "number";
 const std::shared_ptr<Type> _numberType = std::make_shared<Type>(_numberTypeName);
 
+std::atomic<std::size_t> _lastHierarchyId(0);
+
+void _numberTypesRec(Type& pType,
+                     std::size_t pHierarchyId,
+                     std::size_t& pPreOrderIndex)
+{
+  pType.hierarchyId = pHierarchyId;
+  pType.preOrderIndex = pPreOrderIndex++;
+  for (auto& currSubType : pType.subTypes)
+    _numberTypesRec(*currSubType, pHierarchyId, pPreOrderIndex);
+  pType.lastSubTypePreOrderIndex = pPreOrderIndex - 1;
+}
+
 void _removeAfterSemicolon(std::string& str) {
     size_t pos = str.find(';');
     if (pos != std::string::npos) {
@@ -38,6 +52,14 @@ SetOfTypes SetOfTypes::fromPddl(const std::string& pStr)
 
 void SetOfTypes::addType(const std::string& pTypeToAdd,
                          const std::string& pParentType)
+{
+  _addType(pTypeToAdd, pParentType);
+  _numberTypes();
+}
+
+
+void SetOfTypes::_addType(const std::string& pTypeToAdd,
+                          const std::string& pParentType)
 {
   if (pParentType == "")
   {
@@ -49,7 +71,7 @@ void SetOfTypes::addType(const std::string& pTypeToAdd,
   auto it = _nameToType.find(pParentType);
   if (it == _nameToType.end())
   {
-    addType(pParentType);
+    _addType(pParentType, "");
     it = _nameToType.find(pParentType);
   }
 
@@ -86,8 +108,18 @@ void SetOfTypes::addTypesFromPddl(const std::string& pStr)
     ogp::split(types, typesStrs, " ");
     for (auto& currType : types)
       if (!currType.empty())
-        addType(currType, parentType);
+        _addType(currType, parentType);
   }
+  _numberTypes();
+}
+
+
+void SetOfTypes::_numberTypes()
+{
+  const std::size_t hierarchyId = ++_lastHierarchyId;
+  std::size_t preOrderIndex = 0;
+  for (auto& currType : _types)
+    _numberTypesRec(*currType, hierarchyId, preOrderIndex);
 }
 
 std::shared_ptr<Type> SetOfTypes::nameToType(const std::string& pName) const
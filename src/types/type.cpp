@@ -8,7 +8,10 @@ Type::Type(const std::string& pName,
            const std::shared_ptr<Type>& pParent)
     : name(pName),
       parent(pParent),
-      subTypes()
+      subTypes(),
+      hierarchyId(0),
+      preOrderIndex(0),
+      lastSubTypePreOrderIndex(0)
 {
 }
 
@@ -40,6 +43,10 @@ void Type::toStrs(std::list<std::string>& pStrs) const
 
 bool Type::isA(const Type& pOtherType) const
 {
+  if (hierarchyId != 0 && hierarchyId == pOtherType.hierarchyId)
+    return pOtherType.preOrderIndex <= preOrderIndex &&
+        preOrderIndex <= pOtherType.lastSubTypePreOrderIndex;
+
   if (name == pOtherType.name)
     return true;
   if (parent)
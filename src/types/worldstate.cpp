@@ -78,16 +78,35 @@ bool WorldState::modifyFactsFromPddl(const std::string& pStr,
 {
   auto strSize = pStr.size();
   ExpressionParsed::skipSpaces(pStr, pPos);
-  WhatChanged whatChanged;
+  return modifyFacts([&](bool& pIsFactNegated) -> std::optional<Fact>
+  {
+    if (pPos >= strSize || pStr[pPos] == ')')
+      return {};
+    return Fact(pStr, true, pOntology, pEntities, {}, &pIsFactNegated, pPos, &pPos);
+  }, pGoalStack, pSetOfEvents, pCallbacks, pOntology, pEntities, pNow, pCanFactsBeRemoved);
+}
 
-  while (pPos < strSize && pStr[pPos] != ')')
+
+bool WorldState::modifyFacts(const std::function<std::optional<Fact> (bool&)>& pGetNextFact,
+                             GoalStack& pGoalStack,
+                             const std::map<SetOfEventsId, SetOfEvents>& pSetOfEvents,
+                             const SetOfCallbacks& pCallbacks,
+                             const Ontology& pOntology,
+                             const SetOfEntities& pEntities,
+                             const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                             bool pCanFactsBeRemoved)
+{
+  WhatChanged whatChanged;
+  while (true)
   {
     bool isFactNegated = false;
-    Fact fact(pStr, true, pOntology, pEntities, {}, &isFactNegated, pPos, &pPos);
+    auto factOpt = pGetNextFact(isFactNegated);
+    if (!factOpt)
+      break;
     if (isFactNegated)
-      _removeAFact(whatChanged, fact);
+      _removeAFact(whatChanged, *factOpt);
     else
-      _addAFact(whatChanged, fact, pGoalStack, pSetOfEvents, pCallbacks,
+      _addAFact(whatChanged, std::move(*factOpt), pGoalStack, pSetOfEvents, pCallbacks,
                 pOntology, pEntities, pNow, pCanFactsBeRemoved);
   }
 
@@ -113,15 +132,8 @@ void WorldState::applyEffect(const std::map<Parameter, Entity>& pParameters,
   WhatChanged whatChanged;
   if (pEffect)
   {
-    if (pParameters.empty())
-    {
-      _modify(whatChanged, &*pEffect, pGoalStack, pSetOfEvents, pCallbacks, pOntology, pEntities, pNow, canFactsBeRemoved);
-    }
-    else
-    {
-      auto effect = pEffect->clone(&pParameters);
-      _modify(whatChanged, &*effect, pGoalStack, pSetOfEvents, pCallbacks, pOntology, pEntities, pNow, canFactsBeRemoved);
-    }
+    _modify(whatChanged, &*pEffect, pGoalStack, pSetOfEvents, pCallbacks, pOntology, pEntities, pNow, canFactsBeRemoved,
+            pParameters.empty() ? nullptr : &pParameters);
   }
 
   _notifyWhatChanged(whatChanged, pGoalChanged, pGoalStack, pSetOfEvents,
@@ -217,15 +229,16 @@ template void WorldState::_addFacts<std::set<Fact>>(WhatChanged&, const std::set
 template void WorldState::_addFacts<std::vector<Fact>>(WhatChanged&, const std::vector<Fact>&, GoalStack&, const std::map<SetOfEventsId, SetOfEvents>&, const SetOfCallbacks&, const Ontology&, const SetOfEntities&, const std::unique_ptr<std::chrono::steady_clock::time_point>&, bool);
 
 
+template<typename FACT>
 void WorldState::_addAFact(WhatChanged& pWhatChanged,
-                          const Fact& pFact,
-                          GoalStack& pGoalStack,
-                          const std::map<SetOfEventsId, SetOfEvents>& pSetOfEvents,
-                          const SetOfCallbacks& pCallbacks,
-                          const Ontology& pOntology,
-                          const SetOfEntities& pEntities,
-                          const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
-                          bool pCanFactsBeRemoved)
+                           FACT&& pFact,
+                           GoalStack& pGoalStack,
+                           const std::map<SetOfEventsId, SetOfEvents>& pSetOfEvents,
+                           const SetOfCallbacks& pCallbacks,
+                           const Ontology& pOntology,
+                           const SetOfEntities& pEntities,
+                           const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
+                           bool pCanFactsBeRemoved)
 {
   if (pFact.isPunctual())
   {
@@ -276,11 +289,12 @@ void WorldState::_addAFact(WhatChanged& pWhatChanged,
   if (!skipThisFact)
   {
     pWhatChanged.addedFacts.insert(pFact);
-    _factsMapping.add(pFact, pCanFactsBeRemoved);
     _cache->notifyAboutANewFact(pFact);
+    _factsMapping.add(std::forward<FACT>(pFact), pCanFactsBeRemoved);
   }
 }
 
+
 template<typename FACTS>
 void WorldState::_removeFacts(WhatChanged& pWhatChanged,
                               const FACTS& pFacts)
@@ -306,7 +320,8 @@ void WorldState::_modify(WhatChanged& pWhatChanged,
                          const Ontology& pOntology,
                          const SetOfEntities& pEntities,
                          const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
-                         bool pCanFactsBeRemoved)
+                         bool pCanFactsBeRemoved,
+                         const std::map<Parameter, Entity>* pParametersToArgumentPtr)
 {
   if (pWsModifPtr == nullptr)
     return;
@@ -320,7 +335,7 @@ void WorldState::_modify(WhatChanged& pWhatChanged,
       factsToRemove.emplace_back(pFactOptional.fact);
     else
       factsToAdd.emplace_back(pFactOptional.fact);
-  }, _factsMapping);
+  }, _factsMapping, pParametersToArgumentPtr);
 
   _addFacts(pWhatChanged, factsToAdd, pGoalStack, pSetOfEvents, pCallbacks, pOntology, pEntities, pNow, pCanFactsBeRemoved);
   _removeFacts(pWhatChanged, factsToRemove);
@@ -335,10 +350,12 @@ bool WorldState::modify(const WorldStateModification* pWsModifPtr,
                         const Ontology& pOntology,
                         const SetOfEntities& pEntities,
                         const std::unique_ptr<std::chrono::steady_clock::time_point>& pNow,
-                        bool pCanFactsBeRemoved)
+                        bool pCanFactsBeRemoved,
+                        const std::map<Parameter, Entity>* pParametersToArgumentPtr)
 {
   WhatChanged whatChanged;
-  _modify(whatChanged, pWsModifPtr, pGoalStack, pSetOfEvents, pCallbacks, pOntology, pEntities, pNow, pCanFactsBeRemoved);
+  _modify(whatChanged, pWsModifPtr, pGoalStack, pSetOfEvents, pCallbacks, pOntology, pEntities, pNow, pCanFactsBeRemoved,
+          pParametersToArgumentPtr);
   bool goalChanged = false;
   _notifyWhatChanged(whatChanged, goalChanged, pGoalStack, pSetOfEvents, pCallbacks,
                      pOntology, pEntities, pNow);
@@ -520,7 +537,7 @@ bool WorldState::isOptionalFactSatisfiedInASpecificContext(const FactOptional& p
 
 bool WorldState::isGoalSatisfied(const Goal& pGoal) const
 {
-  return pGoal.objective().isTrue(*this);
+  return pGoal.isSatisfied(*this);
 }
 
 
@@ -604,10 +621,8 @@ bool WorldState::_tryToApplyEvent(std::set<EventId>& pEventsAlreadyApplied,
               if (!parametersToValuePoss.empty())
               {
                 for (const auto& currParamsPoss : parametersToValuePoss)
-                {
-                  auto factsToModify = currEvent.factsToModify->clone(&currParamsPoss);
-                  _modify(pWhatChanged, &*factsToModify, pGoalStack, pSetOfEvents, pCallbacks, pOntology, pEntities, pNow, canFactsBeRemoved);
-                }
+                  _modify(pWhatChanged, &*currEvent.factsToModify, pGoalStack, pSetOfEvents, pCallbacks, pOntology, pEntities, pNow, canFactsBeRemoved,
+                          &currParamsPoss);
               }
               else
               {
@@ -114,62 +114,47 @@ std::string WorldStateModificationNode::toStr(bool pPrintAnyFluent) const
 
 
 void WorldStateModificationNode::forAll(const std::function<void (const FactOptional&)>& pFactCallback,
-                                        const SetOfFacts& pSetOfFact) const
+                                        const SetOfFacts& pSetOfFact,
+                                        const std::map<Parameter, Entity>* pParametersToArgumentPtr) const
 {
   if (nodeType == WorldStateModificationNodeType::AND)
   {
     if (leftOperand)
-      leftOperand->forAll(pFactCallback, pSetOfFact);
+      leftOperand->forAll(pFactCallback, pSetOfFact, pParametersToArgumentPtr);
     if (rightOperand)
-      rightOperand->forAll(pFactCallback, pSetOfFact);
-  }
-  else if (nodeType == WorldStateModificationNodeType::ASSIGN && leftOperand && rightOperand)
-  {
-    auto* leftFactPtr = toWmFact(*leftOperand);
-    if (leftFactPtr != nullptr)
-    {
-      auto factToCheck = leftFactPtr->factOptional;
-      factToCheck.fact.setFluent(rightOperand->getFluent(pSetOfFact));
-      return pFactCallback(factToCheck);
-    }
+      rightOperand->forAll(pFactCallback, pSetOfFact, pParametersToArgumentPtr);
   }
   else if (nodeType == WorldStateModificationNodeType::FOR_ALL)
   {
-    _forAllInstruction(
-          [&](const WorldStateModification& pWsModification)
-    {
-      pWsModification.forAll(pFactCallback, pSetOfFact);
-    }, pSetOfFact);
-  }
-  else if (nodeType == WorldStateModificationNodeType::INCREASE && leftOperand && rightOperand)
-  {
-    auto* leftFactPtr = toWmFact(*leftOperand);
-    if (leftFactPtr != nullptr)
+    _forAllInstructionWithoutCopy(
+          [&](const WorldStateModification& pWsModification,
+              const std::map<Parameter, Entity>& pParametersToArgument)
     {
-      auto factToCheck = leftFactPtr->factOptional;
-      factToCheck.fact.setFluent(plusIntOrStr(leftOperand->getFluent(pSetOfFact), rightOperand->getFluent(pSetOfFact)));
-      return pFactCallback(factToCheck);
-    }
+      pWsModification.forAll(pFactCallback, pSetOfFact, &pParametersToArgument);
+    }, pSetOfFact, pParametersToArgumentPtr);
   }
-  else if (nodeType == WorldStateModificationNodeType::DECREASE && leftOperand && rightOperand)
+  else if (leftOperand && rightOperand)
   {
     auto* leftFactPtr = toWmFact(*leftOperand);
-    if (leftFactPtr != nullptr)
-    {
-      auto factToCheck = leftFactPtr->factOptional;
-      factToCheck.fact.setFluent(minusIntOrStr(leftOperand->getFluent(pSetOfFact), rightOperand->getFluent(pSetOfFact)));
-      return pFactCallback(factToCheck);
-    }
-  }
-  else if (nodeType == WorldStateModificationNodeType::MULTIPLY && leftOperand && rightOperand)
-  {
-    auto* leftFactPtr = toWmFact(*leftOperand);
-    if (leftFactPtr != nullptr)
-    {
-      auto factToCheck = leftFactPtr->factOptional;
-      factToCheck.fact.setFluent(multiplyNbOrStr(leftOperand->getFluent(pSetOfFact), rightOperand->getFluent(pSetOfFact)));
-      return pFactCallback(factToCheck);
-    }
+    if (leftFactPtr == nullptr)
+      return;
+    std::optional<Entity> newFluent;
+    if (nodeType == WorldStateModificationNodeType::ASSIGN)
+      newFluent = rightOperand->getFluent(pSetOfFact, pParametersToArgumentPtr);
+    else if (nodeType == WorldStateModificationNodeType::INCREASE)
+      newFluent = plusIntOrStr(leftOperand->getFluent(pSetOfFact, pParametersToArgumentPtr), rightOperand->getFluent(pSetOfFact, pParametersToArgumentPtr));
+    else if (nodeType == WorldStateModificationNodeType::DECREASE)
+      newFluent = minusIntOrStr(leftOperand->getFluent(pSetOfFact, pParametersToArgumentPtr), rightOperand->getFluent(pSetOfFact, pParametersToArgumentPtr));
+    else if (nodeType == WorldStateModificationNodeType::MULTIPLY)
+      newFluent = multiplyNbOrStr(leftOperand->getFluent(pSetOfFact, pParametersToArgumentPtr), rightOperand->getFluent(pSetOfFact, pParametersToArgumentPtr));
+    else
+      return;
+
+    auto factToCheck = leftFactPtr->factOptional;
+    if (pParametersToArgumentPtr != nullptr)
+      factToCheck.fact.replaceArguments(*pParametersToArgumentPtr);
+    factToCheck.fact.setFluent(newFluent);
+    pFactCallback(factToCheck);
   }
 }
 
@@ -623,18 +608,19 @@ bool WorldStateModificationNode::operator==(const WorldStateModification& pOther
 }
 
 
-std::optional<Entity> WorldStateModificationNode::getFluent(const SetOfFacts& pSetOfFact) const
+std::optional<Entity> WorldStateModificationNode::getFluent(const SetOfFacts& pSetOfFact,
+                                                            const std::map<Parameter, Entity>* pParametersToArgumentPtr) const
 {
   if (nodeType == WorldStateModificationNodeType::PLUS)
   {
-    auto leftValue = leftOperand->getFluent(pSetOfFact);
-    auto rightValue = rightOperand->getFluent(pSetOfFact);
+    auto leftValue = leftOperand->getFluent(pSetOfFact, pParametersToArgumentPtr);
+    auto rightValue = rightOperand->getFluent(pSetOfFact, pParametersToArgumentPtr);
     return plusIntOrStr(leftValue, rightValue);
   }
   if (nodeType == WorldStateModificationNodeType::MINUS)
   {
-    auto leftValue = leftOperand->getFluent(pSetOfFact);
-    auto rightValue = rightOperand->getFluent(pSetOfFact);
+    auto leftValue = leftOperand->getFluent(pSetOfFact, pParametersToArgumentPtr);
+    auto rightValue = rightOperand->getFluent(pSetOfFact, pParametersToArgumentPtr);
     return minusIntOrStr(leftValue, rightValue);
   }
   return {};
@@ -665,6 +651,42 @@ void WorldStateModificationNode::_forAllInstruction(const std::function<void (co
 }
 
 
+void WorldStateModificationNode::_forAllInstructionWithoutCopy(
+    const std::function<void (const WorldStateModification&, const std::map<Parameter, Entity>&)>& pCallback,
+    const SetOfFacts& pSetOfFact,
+    const std::map<Parameter, Entity>* pParametersToArgumentPtr) const
+{
+  if (leftOperand && rightOperand && parameterOpt)
+  {
+    auto* leftFactPtr = toWmFact(*leftOperand);
+    if (leftFactPtr != nullptr)
+    {
+      std::set<Entity> parameterValues;
+      if (pParametersToArgumentPtr != nullptr)
+      {
+        auto factWithArguments = leftFactPtr->factOptional.fact;
+        factWithArguments.replaceArguments(*pParametersToArgumentPtr);
+        pSetOfFact.extractPotentialArgumentsOfAFactParameter(parameterValues, factWithArguments, parameterOpt->name);
+      }
+      else
+      {
+        pSetOfFact.extractPotentialArgumentsOfAFactParameter(parameterValues, leftFactPtr->factOptional.fact, parameterOpt->name);
+      }
+
+      if (!parameterValues.empty())
+      {
+        auto parametersToArgument = pParametersToArgumentPtr != nullptr ? *pParametersToArgumentPtr : std::map<Parameter, Entity>();
+        for (const auto& paramValue : parameterValues)
+        {
+          parametersToArgument.insert_or_assign(*parameterOpt, paramValue);
+          pCallback(*rightOperand, parametersToArgument);
+        }
+      }
+    }
+  }
+}
+
+
 bool WorldStateModificationNode::hasAContradictionWith(const std::set<FactOptional>& pFactsOpt,
                                                        std::list<Parameter>* pParametersPtr) const
 {
@@ -701,9 +723,14 @@ bool WorldStateModificationFact::operator==(const WorldStateModification& pOther
       factOptional == otherFactPtr->factOptional;
 }
 
-std::optional<Entity> WorldStateModificationFact::getFluent(const SetOfFacts& pSetOfFact) const
+std::optional<Entity> WorldStateModificationFact::getFluent(const SetOfFacts& pSetOfFact,
+                                                            const std::map<Parameter, Entity>* pParametersToArgumentPtr) const
 {
-  return pSetOfFact.getFactFluent(factOptional.fact);
+  if (pParametersToArgumentPtr == nullptr)
+    return pSetOfFact.getFactFluent(factOptional.fact);
+  auto factWithArguments = factOptional.fact;
+  factWithArguments.replaceArguments(*pParametersToArgumentPtr);
+  return pSetOfFact.getFactFluent(factWithArguments);
 }
 
 bool WorldStateModificationFact::hasAContradictionWith(const std::set<FactOptional>& pFactsOpt,
@@ -81,7 +81,8 @@ struct WorldStateModificationNode : public WorldStateModification
   }
 
   void forAll(const std::function<void (const FactOptional&)>& pFactCallback,
-              const SetOfFacts& pSetOfFact) const override;
+              const SetOfFacts& pSetOfFact,
+              const std::map<Parameter, Entity>* pParametersToArgumentPtr = nullptr) const override;
 
   ContinueOrBreak forAllThatCanBeModified(const std::function<ContinueOrBreak (const FactOptional&)>& pFactCallback) const override;
 
@@ -107,7 +108,8 @@ struct WorldStateModificationNode : public WorldStateModification
 
   bool operator==(const WorldStateModification& pOther) const override;
 
-  std::optional<Entity> getFluent(const SetOfFacts& pSetOfFact) const override;
+  std::optional<Entity> getFluent(const SetOfFacts& pSetOfFact,
+                                  const std::map<Parameter, Entity>* pParametersToArgumentPtr = nullptr) const override;
 
   const FactOptional* getOptionalFact() const override
   {
@@ -129,6 +131,10 @@ struct WorldStateModificationNode : public WorldStateModification
                              std::list<Parameter>* pParametersPtr) const override;
 
 
+  /// Successions cached by the domain. It is only exposed to save and to load them with the domain.
+  const Successions& successions() const { return _successions; }
+  void setSuccessions(Successions&& pSuccessions) { _successions = std::move(pSuccessions); }
+
   WorldStateModificationNodeType nodeType;
   std::unique_ptr<WorldStateModification> leftOperand;
   std::unique_ptr<WorldStateModification> rightOperand;
@@ -139,6 +145,10 @@ private:
 
   void _forAllInstruction(const std::function<void (const WorldStateModification&)>& pCallback,
                           const SetOfFacts& pSetOfFact) const;
+  /// Same as _forAllInstruction but the value of the iterated parameter is given as an argument instead of cloning the right operand.
+  void _forAllInstructionWithoutCopy(const std::function<void (const WorldStateModification&, const std::map<Parameter, Entity>&)>& pCallback,
+                                     const SetOfFacts& pSetOfFact,
+                                     const std::map<Parameter, Entity>* pParametersToArgumentPtr) const;
 };
 
 
@@ -171,7 +181,15 @@ struct WorldStateModificationFact : public WorldStateModification
   }
 
   void forAll(const std::function<void (const FactOptional&)>& pFactCallback,
-              const SetOfFacts&) const override { pFactCallback(factOptional); }
+              const SetOfFacts&,
+              const std::map<Parameter, Entity>* pParametersToArgumentPtr = nullptr) const override
+  {
+    if (pParametersToArgumentPtr == nullptr)
+      return pFactCallback(factOptional);
+    auto factOptionalWithArguments = factOptional;
+    factOptionalWithArguments.fact.replaceArguments(*pParametersToArgumentPtr);
+    pFactCallback(factOptionalWithArguments);
+  }
 
   ContinueOrBreak forAllThatCanBeModified(const std::function<ContinueOrBreak (const FactOptional&)>& pFactCallback) const override { return pFactCallback(factOptional); }
 
@@ -228,7 +246,8 @@ struct WorldStateModificationFact : public WorldStateModification
 
   bool operator==(const WorldStateModification& pOther) const override;
 
-  std::optional<Entity> getFluent(const SetOfFacts& pSetOfFact) const override;
+  std::optional<Entity> getFluent(const SetOfFacts& pSetOfFact,
+                                  const std::map<Parameter, Entity>* pParametersToArgumentPtr = nullptr) const override;
 
   const FactOptional* getOptionalFact() const override
   {
@@ -241,12 +260,16 @@ struct WorldStateModificationFact : public WorldStateModification
     if (pParametersToArgumentPtr != nullptr)
       res->factOptional.fact.replaceArguments(*pParametersToArgumentPtr);
     res->_successions = _successions;
-    return res;    return res;
+    return res;
   }
 
   bool hasAContradictionWith(const std::set<FactOptional>& pFactsOpt,
                              std::list<Parameter>* pParametersPtr) const override;
 
+  /// Successions cached by the domain. It is only exposed to save and to load them with the domain.
+  const Successions& successions() const { return _successions; }
+  void setSuccessions(Successions&& pSuccessions) { _successions = std::move(pSuccessions); }
+
   FactOptional factOptional;
 
 private:
@@ -259,7 +282,8 @@ struct WorldStateModificationNumber : public WorldStateModification
 {
   WorldStateModificationNumber(const Number& pNb)
     : WorldStateModification(),
-      _nb(pNb)
+      _nb(pNb),
+      _nbEntity(Entity::createNumberEntity(pNb))
   {
   }
 
@@ -274,7 +298,8 @@ struct WorldStateModificationNumber : public WorldStateModification
   void replaceArgument(const Entity&,
                        const Entity&) override {}
   void forAll(const std::function<void (const FactOptional&)>&,
-              const SetOfFacts&) const override {}
+              const SetOfFacts&,
+              const std::map<Parameter, Entity>* = nullptr) const override {}
   ContinueOrBreak forAllThatCanBeModified(const std::function<ContinueOrBreak (const FactOptional&)>&) const override { return ContinueOrBreak::CONTINUE; }
   void iterateOverAllAccessibleFacts(const std::function<void (const FactOptional&)>&,
                                      const SetOfFacts&) const override {}
@@ -298,9 +323,10 @@ struct WorldStateModificationNumber : public WorldStateModification
 
   bool operator==(const WorldStateModification& pOther) const override;
 
-  std::optional<Entity> getFluent(const SetOfFacts&) const override
+  std::optional<Entity> getFluent(const SetOfFacts&,
+                                  const std::map<Parameter, Entity>* = nullptr) const override
   {
-    return Entity::createNumberEntity(toStr(true));
+    return _nbEntity;
   }
 
   const FactOptional* getOptionalFact() const override
@@ -320,6 +346,8 @@ struct WorldStateModificationNumber : public WorldStateModification
 
 private:
   Number _nb;
+  /// Entity of the number, formatted once because it is read at each application of the modification.
+  Entity _nbEntity;
 };
 
 const WorldStateModificationNode* toWmNode(const WorldStateModification& pOther);
@@ -0,0 +1,160 @@
+#include "parallelfor.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ogp
+{
+namespace
+{
+std::atomic<std::size_t> _maxNbOfThreads(0);
+
+
+/// Threads created on demand that stay alive to execute the tasks of the next calls.
+class ThreadPool
+{
+public:
+  ~ThreadPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _stopped = true;
+    }
+    _condition.notify_all();
+    for (auto& currThread : _threads)
+      currThread.join();
+  }
+
+  /// Add a task to execute several times, creating the threads missing to execute them at the same time.
+  void post(const std::function<void()>& pTask,
+            std::size_t pNbOfTimes)
+  {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      for (std::size_t i = 0; i < pNbOfTimes; ++i)
+        _tasks.push_back(pTask);
+      while (_threads.size() < pNbOfTimes)
+        _threads.emplace_back([this] { _run(); });
+    }
+    _condition.notify_all();
+  }
+
+private:
+  std::mutex _mutex;
+  std::condition_variable _condition;
+  std::deque<std::function<void()>> _tasks;
+  std::vector<std::thread> _threads;
+  bool _stopped = false;
+
+  void _run()
+  {
+    while (true)
+    {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _condition.wait(lock, [this] { return _stopped || !_tasks.empty(); });
+        if (_tasks.empty())
+          return;
+        task = std::move(_tasks.front());
+        _tasks.pop_front();
+      }
+      task();
+    }
+  }
+};
+
+
+ThreadPool& _getThreadPool()
+{
+  static ThreadPool threadPool;
+  return threadPool;
+}
+
+
+/// State of a call to parallelForInThreadPool shared with its helpers.
+struct ParallelForState
+{
+  std::atomic<std::size_t> nextIndex{0};
+  std::mutex mutex;
+  std::condition_variable condition;
+  /// Set when the current thread has no more indexes to treat. The helpers that start after it do nothing.
+  bool finished = false;
+  std::size_t nbOfRunningHelpers = 0;
+  std::exception_ptr firstException;
+};
+
+
+void _treatIndexes(ParallelForState& pState,
+                   std::size_t pSize,
+                   const std::function<void(std::size_t)>& pFunction)
+{
+  try
+  {
+    for (std::size_t i = pState.nextIndex++; i < pSize; i = pState.nextIndex++)
+      pFunction(i);
+  }
+  catch (...)
+  {
+    std::lock_guard<std::mutex> lock(pState.mutex);
+    if (!pState.firstException)
+      pState.firstException = std::current_exception();
+    pState.nextIndex = pSize;
+  }
+}
+
+}
+
+
+void setMaxNbOfThreads(std::size_t pMaxNbOfThreads)
+{
+  _maxNbOfThreads = pMaxNbOfThreads;
+}
+
+
+std::size_t getMaxNbOfThreads()
+{
+  std::size_t res = _maxNbOfThreads;
+  if (res > 0)
+    return res;
+  return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+
+void parallelForInThreadPool(std::size_t pSize,
+                             const std::function<void(std::size_t)>& pFunction,
+                             std::size_t pNbOfThreads)
+{
+  auto statePtr = std::make_shared<ParallelForState>();
+  const auto* functionPtr = &pFunction;
+  _getThreadPool().post([statePtr, functionPtr, pSize]
+  {
+    {
+      std::lock_guard<std::mutex> lock(statePtr->mutex);
+      if (statePtr->finished)
+        return;
+      ++statePtr->nbOfRunningHelpers;
+    }
+    _treatIndexes(*statePtr, pSize, *functionPtr);
+    {
+      std::lock_guard<std::mutex> lock(statePtr->mutex);
+      --statePtr->nbOfRunningHelpers;
+    }
+    statePtr->condition.notify_all();
+  }, pNbOfThreads - 1);
+
+  _treatIndexes(*statePtr, pSize, pFunction);
+  std::unique_lock<std::mutex> lock(statePtr->mutex);
+  statePtr->finished = true;
+  statePtr->condition.wait(lock, [&] { return statePtr->nbOfRunningHelpers == 0; });
+  if (statePtr->firstException)
+    std::rethrow_exception(statePtr->firstException);
+}
+
+
+} // End of namespace ogp
@@ -0,0 +1,57 @@
+#ifndef ORDEREDGOALSPLANNER_SRC_UTIL_PARALLELFOR_HPP
+#define ORDEREDGOALSPLANNER_SRC_UTIL_PARALLELFOR_HPP
+
+#include <algorithm>
+#include <functional>
+#include <orderedgoalsplanner/util/util.hpp>
+
+namespace ogp
+{
+
+/**
+ * @brief Call a function for each index between 0 and pSize (excluded), from the current thread
+ * helped by the idle threads of a pool shared by the whole process.
+ * @param[in] pSize Number of indexes.
+ * @param[in] pFunction Function to call for each index. It has to be thread safe between different indexes.
+ * @param[in] pNbOfThreads Number of threads to use, including the current thread.
+ *
+ * The threads of the pool are only created the first time they are needed, so calling this function often does not create threads.
+ * The current thread never waits for a helper that has not started, so a call from inside another call cannot block.
+ * If a call throws, the first exception is rethrown once all the helpers are finished.
+ */
+void parallelForInThreadPool(std::size_t pSize,
+                             const std::function<void(std::size_t)>& pFunction,
+                             std::size_t pNbOfThreads);
+
+
+/**
+ * @brief Call a function for each index between 0 and pSize (excluded), spread on several threads.<br/>
+ * The function is only called from the current thread if there are not enough indexes for the threads to be useful.
+ * @param[in] pSize Number of indexes.
+ * @param[in] pFunction Function to call for each index. It has to be thread safe between different indexes.
+ * @param[in] pMinNbOfIndexesPerThread Minimum number of indexes to justify the use of a thread.
+ * @param[in] pMaxNbOfThreads Maximum number of threads to use. 0 means the value of getMaxNbOfThreads().
+ *
+ * If a call throws, the first exception is rethrown once all the threads are finished.
+ */
+template<typename FUNCTION>
+void parallelFor(std::size_t pSize,
+                 const FUNCTION& pFunction,
+                 std::size_t pMinNbOfIndexesPerThread = 16,
+                 std::size_t pMaxNbOfThreads = 0)
+{
+  std::size_t nbOfThreads = std::min<std::size_t>(pMaxNbOfThreads > 0 ? pMaxNbOfThreads : getMaxNbOfThreads(),
+                                                  pSize / std::max<std::size_t>(pMinNbOfIndexesPerThread, 1));
+  if (nbOfThreads <= 1)
+  {
+    for (std::size_t i = 0; i < pSize; ++i)
+      pFunction(i);
+    return;
+  }
+  parallelForInThreadPool(pSize, pFunction, nbOfThreads);
+}
+
+} // End of namespace ogp
+
+
+#endif // ORDEREDGOALSPLANNER_SRC_UTIL_PARALLELFOR_HPP
@@ -0,0 +1,1177 @@
+#include <orderedgoalsplanner/util/serializer/binarysnapshot.hpp>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <orderedgoalsplanner/types/domain.hpp>
+#include <orderedgoalsplanner/types/problem.hpp>
+#include <orderedgoalsplanner/types/setofcallbacks.hpp>
+#include "../../types/worldstatemodificationprivate.hpp"
+#include "../uuid.hpp"
+
+namespace ogp
+{
+namespace
+{
+const char _snapshotMagic[4] = {'O', 'G', 'P', 'S'};
+
+enum class SnapshotKind : std::uint8_t
+{
+  OF_DOMAIN = 1,
+  OF_PROBLEM = 2
+};
+
+enum class ConditionTag : std::uint8_t
+{
+  NONE,
+  NODE,
+  EXISTS,
+  NOT,
+  FACT,
+  NUMBER
+};
+
+enum class WsModificationTag : std::uint8_t
+{
+  NONE,
+  NODE,
+  FACT,
+  NUMBER
+};
+
+
+/// Write the snapshot body. The strings are interned and written once in a table before the body.
+struct SnapshotWriter
+{
+  void writeByte(std::uint8_t pValue) { body.push_back(static_cast<char>(pValue)); }
+  void writeBool(bool pValue) { writeByte(pValue ? 1 : 0); }
+
+  void writeUInt(std::uint32_t pValue)
+  {
+    for (int i = 0; i < 4; ++i)
+      writeByte(static_cast<std::uint8_t>((pValue >> (8 * i)) & 0xFF));
+  }
+
+  void writeInt(int pValue) { writeUInt(static_cast<std::uint32_t>(pValue)); }
+
+  void writeSize(std::size_t pValue)
+  {
+    if (pValue > UINT32_MAX)
+      throw std::runtime_error("Too many elements to write in a snapshot");
+    writeUInt(static_cast<std::uint32_t>(pValue));
+  }
+
+  void writeStr(const std::string& pStr)
+  {
+    auto it = _strToIndex.find(pStr);
+    if (it == _strToIndex.end())
+    {
+      it = _strToIndex.emplace(pStr, static_cast<std::uint32_t>(_strs.size())).first;
+      _strs.push_back(&it->first);
+    }
+    writeUInt(it->second);
+  }
+
+  std::string finalize(SnapshotKind pKind) const
+  {
+    std::string res(_snapshotMagic, sizeof(_snapshotMagic));
+    SnapshotWriter header;
+    header.writeUInt(binarySnapshotVersion);
+    header.writeByte(static_cast<std::uint8_t>(pKind));
+    header.writeSize(_strs.size());
+    for (const auto* currStrPtr : _strs)
+    {
+      header.writeSize(currStrPtr->size());
+      header.body += *currStrPtr;
+    }
+    res += header.body;
+    res += body;
+    return res;
+  }
+
+  std::string body;
+
+private:
+  std::map<std::string, std::uint32_t> _strToIndex;
+  std::vector<const std::string*> _strs;
+};
+
+
+/// Read a snapshot from a memory buffer. The buffer is not copied, the symbols point inside it.
+struct SnapshotReader
+{
+  SnapshotReader(const char* pData,
+                 std::size_t pSize,
+                 SnapshotKind pKind)
+    : _data(pData),
+      _size(pSize),
+      _pos(0),
+      _strs(),
+      _strIndexToType(),
+      _strIndexToPredicate()
+  {
+    if (_size < sizeof(_snapshotMagic) || std::memcmp(_data, _snapshotMagic, sizeof(_snapshotMagic)) != 0)
+      throw std::runtime_error("The data is not a planner snapshot");
+    _pos = sizeof(_snapshotMagic);
+    auto version = readUInt();
+    if (version != binarySnapshotVersion)
+      throw std::runtime_error("Snapshot version " + std::to_string(version) + " is not supported, expected version " +
+                               std::to_string(binarySnapshotVersion));
+    if (readByte() != static_cast<std::uint8_t>(pKind))
+      throw std::runtime_error(pKind == SnapshotKind::OF_DOMAIN ? "The snapshot is not a domain snapshot" :
+                                                               "The snapshot is not a problem snapshot");
+    auto nbOfStrs = readCount(4);
+    _strs.reserve(nbOfStrs);
+    for (std::uint32_t i = 0; i < nbOfStrs; ++i)
+    {
+      auto strSize = readUInt();
+      _checkRemainingSize(strSize);
+      _strs.emplace_back(_data + _pos, strSize);
+      _pos += strSize;
+    }
+    _strIndexToType.resize(nbOfStrs);
+    _strIndexToPredicate.resize(nbOfStrs, nullptr);
+  }
+
+  std::uint8_t readByte()
+  {
+    _checkRemainingSize(1);
+    return static_cast<std::uint8_t>(_data[_pos++]);
+  }
+
+  bool readBool() { return readByte() != 0; }
+
+  std::uint32_t readUInt()
+  {
+    _checkRemainingSize(4);
+    std::uint32_t res = 0;
+    for (int i = 0; i < 4; ++i)
+      res |= static_cast<std::uint32_t>(static_cast<std::uint8_t>(_data[_pos++])) << (8 * i);
+    return res;
+  }
+
+  int readInt() { return static_cast<int>(readUInt()); }
+
+  /**
+   * @brief Read a number of elements.
+   * @param[in] pMinSizeOfAnElement Minimum number of bytes written for each element.
+   * @return The number of elements. An exception is raised if the remaining data cannot contain them,
+   * so the number can be used to reserve memory.
+   */
+  std::uint32_t readCount(std::size_t pMinSizeOfAnElement)
+  {
+    auto res = readUInt();
+    if (res > (_size - _pos) / pMinSizeOfAnElement)
+      throw std::runtime_error("Truncated snapshot");
+    return res;
+  }
+
+  std::string_view readStr() { return _strs[_readStrIndex()]; }
+
+  /// Read a type name. It is only searched in the set of types the first time it is read.
+  const std::shared_ptr<Type>& readTypeName(const SetOfTypes& pSetOfTypes)
+  {
+    auto index = _readStrIndex();
+    auto& typePtr = _strIndexToType[index];
+    if (!typePtr)
+      typePtr = pSetOfTypes.nameToType(std::string(_strs[index]));
+    return typePtr;
+  }
+
+  /// Read a predicate name. It is only searched in the ontology the first time it is read.
+  const Predicate& readPredicateName(const Ontology& pOntology)
+  {
+    auto index = _readStrIndex();
+    auto& predicatePtr = _strIndexToPredicate[index];
+    if (predicatePtr == nullptr)
+    {
+      std::string name(_strs[index]);
+      predicatePtr = pOntology.predicates.nameToPredicatePtr(name);
+      if (predicatePtr == nullptr)
+        predicatePtr = pOntology.derivedPredicates.nameToPredicatePtr(name);
+      if (predicatePtr == nullptr)
+        throw std::runtime_error("\"" + name + "\" is not a predicate name of the snapshot");
+    }
+    return *predicatePtr;
+  }
+
+  void checkEnd() const
+  {
+    if (_pos != _size)
+      throw std::runtime_error("Unexpected data at the end of the snapshot");
+  }
+
+private:
+  const char* _data;
+  std::size_t _size;
+  std::size_t _pos;
+  std::vector<std::string_view> _strs;
+  std::vector<std::shared_ptr<Type>> _strIndexToType;
+  std::vector<const Predicate*> _strIndexToPredicate;
+
+  std::uint32_t _readStrIndex()
+  {
+    auto index = readUInt();
+    if (index >= _strs.size())
+      throw std::runtime_error("Invalid symbol index in snapshot");
+    return index;
+  }
+
+  void _checkRemainingSize(std::size_t pSize) const
+  {
+    if (_size - _pos < pSize)
+      throw std::runtime_error("Truncated snapshot");
+  }
+};
+
+
+/// Content of a file, mapped in memory when it is possible.
+class FileContent
+{
+public:
+  FileContent(const std::string& pFilename)
+    : _data(nullptr),
+      _size(0),
+      _buffer()
+  {
+#ifndef _WIN32
+    int fd = ::open(pFilename.c_str(), O_RDONLY);
+    if (fd < 0)
+      throw std::runtime_error("Unable to open the snapshot file: " + pFilename);
+    struct stat fileStat;
+    if (::fstat(fd, &fileStat) != 0)
+    {
+      ::close(fd);
+      throw std::runtime_error("Unable to read the size of the snapshot file: " + pFilename);
+    }
+    _size = static_cast<std::size_t>(fileStat.st_size);
+    if (_size > 0)
+    {
+      void* mappedData = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mappedData == MAP_FAILED)
+      {
+        ::close(fd);
+        throw std::runtime_error("Unable to map the snapshot file: " + pFilename);
+      }
+      _data = static_cast<const char*>(mappedData);
+    }
+    ::close(fd);
+#else
+    std::ifstream file(pFilename, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+      throw std::runtime_error("Unable to open the snapshot file: " + pFilename);
+    _buffer.resize(static_cast<std::size_t>(file.tellg()));
+    file.seekg(0);
+    if (!_buffer.empty() && !file.read(&_buffer[0], static_cast<std::streamsize>(_buffer.size())))
+      throw std::runtime_error("Unable to read the snapshot file: " + pFilename);
+    _data = _buffer.data();
+    _size = _buffer.size();
+#endif
+  }
+
+  ~FileContent()
+  {
+#ifndef _WIN32
+    if (_data != nullptr)
+      ::munmap(const_cast<char*>(_data), _size);
+#endif
+  }
+
+  FileContent(const FileContent&) = delete;
+  FileContent& operator=(const FileContent&) = delete;
+
+  const char* data() const { return _data; }
+  std::size_t size() const { return _size; }
+
+private:
+  const char* _data;
+  std::size_t _size;
+  /// Content of the file when it cannot be mapped in memory.
+  std::string _buffer;
+};
+
+
+
+void _writeType(SnapshotWriter& pWriter,
+                const std::shared_ptr<Type>& pType)
+{
+  pWriter.writeBool(static_cast<bool>(pType));
+  if (pType)
+    pWriter.writeStr(pType->name);
+}
+
+std::shared_ptr<Type> _readType(SnapshotReader& pReader,
+                                const SetOfTypes& pSetOfTypes)
+{
+  if (!pReader.readBool())
+    return {};
+  return pReader.readTypeName(pSetOfTypes);
+}
+
+
+void _writeTypeAndSubTypes(SnapshotWriter& pWriter,
+                           const Type& pType)
+{
+  pWriter.writeStr(pType.name);
+  _writeType(pWriter, pType.parent);
+  for (const auto& currSubType : pType.subTypes)
+    _writeTypeAndSubTypes(pWriter, *currSubType);
+}
+
+std::size_t _nbOfTypesWithSubTypes(const Type& pType)
+{
+  std::size_t res = 1;
+  for (const auto& currSubType : pType.subTypes)
+    res += _nbOfTypesWithSubTypes(*currSubType);
+  return res;
+}
+
+void _writeTypes(SnapshotWriter& pWriter,
+                 const SetOfTypes& pSetOfTypes)
+{
+  std::size_t nbOfTypes = 0;
+  for (const auto& currType : pSetOfTypes.rootTypes())
+    nbOfTypes += _nbOfTypesWithSubTypes(*currType);
+  pWriter.writeSize(nbOfTypes);
+  // The types are written in pre-order so that the parents are always added before their children
+  for (const auto& currType : pSetOfTypes.rootTypes())
+    _writeTypeAndSubTypes(pWriter, *currType);
+}
+
+void _readTypes(SnapshotReader& pReader,
+                SetOfTypes& pSetOfTypes)
+{
+  auto nbOfTypes = pReader.readCount(5);
+  for (std::uint32_t i = 0; i < nbOfTypes; ++i)
+  {
+    std::string typeName(pReader.readStr());
+    std::string parentName;
+    if (pReader.readBool())
+      parentName = pReader.readStr();
+    pSetOfTypes.addType(typeName, parentName);
+  }
+}
+
+
+void _writeParameters(SnapshotWriter& pWriter,
+                      const std::vector<Parameter>& pParameters)
+{
+  pWriter.writeSize(pParameters.size());
+  for (const auto& currParameter : pParameters)
+  {
+    pWriter.writeStr(currParameter.name);
+    _writeType(pWriter, currParameter.type);
+  }
+}
+
+std::vector<Parameter> _readParameters(SnapshotReader& pReader,
+                                       const SetOfTypes& pSetOfTypes)
+{
+  std::vector<Parameter> res;
+  auto nbOfParameters = pReader.readCount(5);
+  res.reserve(nbOfParameters);
+  for (std::uint32_t i = 0; i < nbOfParameters; ++i)
+  {
+    std::string name(pReader.readStr());
+    res.emplace_back(name, _readType(pReader, pSetOfTypes));
+  }
+  return res;
+}
+
+
+void _writeEntity(SnapshotWriter& pWriter,
+                  const Entity& pEntity)
+{
+  pWriter.writeStr(pEntity.value);
+  _writeType(pWriter, pEntity.type);
+}
+
+Entity _readEntity(SnapshotReader& pReader,
+                   const SetOfTypes& pSetOfTypes)
+{
+  std::string value(pReader.readStr());
+  return Entity(value, _readType(pReader, pSetOfTypes));
+}
+
+
+void _writeEntities(SnapshotWriter& pWriter,
+                    const SetOfEntities& pEntities)
+{
+  const auto& entities = pEntities.allEntities();
+  pWriter.writeSize(entities.size());
+  for (const auto& currEntity : entities)
+    _writeEntity(pWriter, currEntity.second);
+}
+
+void _readEntities(SnapshotReader& pReader,
+                   SetOfEntities& pEntities,
+                   const SetOfTypes& pSetOfTypes)
+{
+  auto nbOfEntities = pReader.readCount(5);
+  for (std::uint32_t i = 0; i < nbOfEntities; ++i)
+    pEntities.add(_readEntity(pReader, pSetOfTypes));
+}
+
+
+void _writePredicate(SnapshotWriter& pWriter,
+                     const Predicate& pPredicate)
+{
+  pWriter.writeStr(pPredicate.name);
+  _writeParameters(pWriter, pPredicate.parameters);
+  _writeType(pWriter, pPredicate.fluent);
+}
+
+Predicate _readPredicate(SnapshotReader& pReader,
+                         const SetOfTypes& pSetOfTypes)
+{
+  std::string name(pReader.readStr());
+  auto parameters = _readParameters(pReader, pSetOfTypes);
+  return Predicate(name, parameters, _readType(pReader, pSetOfTypes));
+}
+
+
+void _writeIds(SnapshotWriter& pWriter,
+               const std::set<std::string>& pIds)
+{
+  pWriter.writeSize(pIds.size());
+  for (const auto& currId : pIds)
+    pWriter.writeStr(currId);
+}
+
+std::set<std::string> _readIds(SnapshotReader& pReader)
+{
+  std::set<std::string> res;
+  auto nbOfIds = pReader.readCount(4);
+  // The identifiers are written in order so each one is inserted at the end
+  for (std::uint32_t i = 0; i < nbOfIds; ++i)
+    res.emplace_hint(res.end(), pReader.readStr());
+  return res;
+}
+
+
+void _writeSuccessions(SnapshotWriter& pWriter,
+                       const Successions& pSuccessions)
+{
+  _writeIds(pWriter, pSuccessions.actions);
+  pWriter.writeSize(pSuccessions.events.size());
+  for (const auto& currSetOfEventsToEvents : pSuccessions.events)
+  {
+    pWriter.writeStr(currSetOfEventsToEvents.first);
+    _writeIds(pWriter, currSetOfEventsToEvents.second);
+  }
+}
+
+Successions _readSuccessions(SnapshotReader& pReader)
+{
+  Successions res;
+  res.actions = _readIds(pReader);
+  auto nbOfSetOfEvents = pReader.readCount(8);
+  for (std::uint32_t i = 0; i < nbOfSetOfEvents; ++i)
+  {
+    std::string setOfEventsId(pReader.readStr());
+    res.events.emplace_hint(res.events.end(), std::move(setOfEventsId), _readIds(pReader));
+  }
+  return res;
+}
+
+
+void _writeNumber(SnapshotWriter& pWriter,
+                  const Number& pNumber)
+{
+  if (std::holds_alternative<int>(pNumber))
+  {
+    pWriter.writeByte(0);
+    pWriter.writeInt(std::get<int>(pNumber));
+  }
+  else
+  {
+    pWriter.writeByte(1);
+    auto floatValue = std::get<float>(pNumber);
+    std::uint32_t bits = 0;
+    static_assert(sizeof(bits) == sizeof(floatValue), "Float numbers are expected to be on 32 bits");
+    std::memcpy(&bits, &floatValue, sizeof(bits));
+    pWriter.writeUInt(bits);
+  }
+}
+
+Number _readNumber(SnapshotReader& pReader)
+{
+  if (pReader.readByte() == 0)
+    return pReader.readInt();
+  auto bits = pReader.readUInt();
+  float res = 0;
+  std::memcpy(&res, &bits, sizeof(res));
+  return res;
+}
+
+
+/// The facts are written already resolved, with the types of their arguments and of their predicate,
+/// so they are read without searching the entities and without checking them again.
+void _writeFact(SnapshotWriter& pWriter,
+                const Fact& pFact)
+{
+  const auto& arguments = pFact.arguments();
+  if (arguments.size() != pFact.predicate.parameters.size())
+    throw std::runtime_error("The fact \"" + pFact.toStr() + "\" does not match its predicate");
+  pWriter.writeStr(pFact.predicate.name);
+  pWriter.writeSize(arguments.size());
+  for (std::size_t i = 0; i < arguments.size(); ++i)
+  {
+    _writeEntity(pWriter, arguments[i]);
+    _writeType(pWriter, pFact.predicate.parameters[i].type);
+  }
+  pWriter.writeBool(pFact.fluent().has_value());
+  if (pFact.fluent())
+    _writeEntity(pWriter, *pFact.fluent());
+  _writeType(pWriter, pFact.predicate.fluent);
+  pWriter.writeBool(pFact.isValueNegated());
+}
+
+Fact _readFact(SnapshotReader& pReader,
+               const Ontology& pOntology)
+{
+  Predicate predicate = pReader.readPredicateName(pOntology);
+  auto nbOfArguments = pReader.readCount(6);
+  if (nbOfArguments != predicate.parameters.size())
+    throw std::runtime_error("A fact of the snapshot does not match its predicate \"" + predicate.name + "\"");
+  std::vector<Entity> arguments;
+  arguments.reserve(nbOfArguments);
+  for (std::uint32_t i = 0; i < nbOfArguments; ++i)
+  {
+    arguments.emplace_back(_readEntity(pReader, pOntology.types));
+    predicate.parameters[i].type = _readType(pReader, pOntology.types);
+  }
+  std::optional<Entity> fluent;
+  if (pReader.readBool())
+    fluent.emplace(_readEntity(pReader, pOntology.types));
+  predicate.fluent = _readType(pReader, pOntology.types);
+  bool isValueNegated = pReader.readBool();
+  return Fact(predicate, std::move(arguments), std::move(fluent), isValueNegated);
+}
+
+
+void _writeFactOptional(SnapshotWriter& pWriter,
+                        const FactOptional& pFactOptional)
+{
+  pWriter.writeBool(pFactOptional.isFactNegated);
+  _writeFact(pWriter, pFactOptional.fact);
+}
+
+FactOptional _readFactOptional(SnapshotReader& pReader,
+                               const Ontology& pOntology)
+{
+  bool isFactNegated = pReader.readBool();
+  return FactOptional(_readFact(pReader, pOntology), isFactNegated);
+}
+
+
+void _writeCondition(SnapshotWriter& pWriter,
+                     const Condition* pConditionPtr)
+{
+  if (pConditionPtr == nullptr)
+  {
+    pWriter.writeByte(static_cast<std::uint8_t>(ConditionTag::NONE));
+    return;
+  }
+
+  if (const auto* nodePtr = pConditionPtr->fcNodePtr())
+  {
+    pWriter.writeByte(static_cast<std::uint8_t>(ConditionTag::NODE));
+    pWriter.writeByte(static_cast<std::uint8_t>(nodePtr->nodeType));
+    _writeCondition(pWriter, nodePtr->leftOperand.get());
+    _writeCondition(pWriter, nodePtr->rightOperand.get());
+  }
+  else if (const auto* existsPtr = pConditionPtr->fcExistsPtr())
+  {
+    pWriter.writeByte(static_cast<std::uint8_t>(ConditionTag::EXISTS));
+    _writeParameters(pWriter, {existsPtr->parameter});
+    _writeCondition(pWriter, existsPtr->condition.get());
+  }
+  else if (const auto* notPtr = pConditionPtr->fcNotPtr())
+  {
+    pWriter.writeByte(static_cast<std::uint8_t>(ConditionTag::NOT));
+    _writeCondition(pWriter, notPtr->condition.get());
+  }
+  else if (const auto* factPtr = pConditionPtr->fcFactPtr())
+  {
+    pWriter.writeByte(static_cast<std::uint8_t>(ConditionTag::FACT));
+    _writeFactOptional(pWriter, factPtr->factOptional);
+  }
+  else if (const auto* nbPtr = pConditionPtr->fcNbPtr())
+  {
+    pWriter.writeByte(static_cast<std::uint8_t>(ConditionTag::NUMBER));
+    _writeNumber(pWriter, nbPtr->nb);
+  }
+  else
+  {
+    throw std::runtime_error("Unknown condition type to write in a snapshot");
+  }
+}
+
+std::unique_ptr<Condition> _readCondition(SnapshotReader& pReader,
+                                          const Ontology& pOntology)
+{
+  auto tag = static_cast<ConditionTag>(pReader.readByte());
+  switch (tag)
+  {
+  case ConditionTag::NONE:
+    return {};
+  case ConditionTag::NODE:
+  {
+    auto nodeTypeValue = pReader.readByte();
+    if (nodeTypeValue > static_cast<std::uint8_t>(ConditionNodeType::MINUS))
+      throw std::runtime_error("Unknown condition node type in snapshot");
+    auto nodeType = static_cast<ConditionNodeType>(nodeTypeValue);
+    auto leftOperand = _readCondition(pReader, pOntology);
+    auto rightOperand = _readCondition(pReader, pOntology);
+    return std::make_unique<ConditionNode>(nodeType, std::move(leftOperand), std::move(rightOperand));
+  }
+  case ConditionTag::EXISTS:
+  {
+    auto existsParameters = _readParameters(pReader, pOntology.types);
+    if (existsParameters.size() != 1)
+      throw std::runtime_error("An exists condition of a snapshot should have exactly one parameter");
+    return std::make_unique<ConditionExists>(existsParameters.front(), _readCondition(pReader, pOntology));
+  }
+  case ConditionTag::NOT:
+    return std::make_unique<ConditionNot>(_readCondition(pReader, pOntology));
+  case ConditionTag::FACT:
+    return std::make_unique<ConditionFact>(_readFactOptional(pReader, pOntology));
+  case ConditionTag::NUMBER:
+    return std::make_unique<ConditionNumber>(_readNumber(pReader));
+  }
+  throw std::runtime_error("Unknown condition type in snapshot");
+}
+
+
+void _writeWsModification(SnapshotWriter& pWriter,
+                          const WorldStateModification* pWsModificationPtr)
+{
+  if (pWsModificationPtr == nullptr)
+  {
+    pWriter.writeByte(static_cast<std::uint8_t>(WsModificationTag::NONE));
+    return;
+  }
+
+  if (const auto* nodePtr = toWmNode(*pWsModificationPtr))
+  {
+    pWriter.writeByte(static_cast<std::uint8_t>(WsModificationTag::NODE));
+    pWriter.writeByte(static_cast<std::uint8_t>(nodePtr->nodeType));
+    pWriter.writeBool(nodePtr->parameterOpt.has_value());
+    if (nodePtr->parameterOpt)
+      _writeParameters(pWriter, {*nodePtr->parameterOpt});
+    _writeWsModification(pWriter, nodePtr->leftOperand.get());
+    _writeWsModification(pWriter, nodePtr->rightOperand.get());
+    _writeSuccessions(pWriter, nodePtr->successions());
+  }
+  else if (const auto* factPtr = toWmFact(*pWsModificationPtr))
+  {
+    pWriter.writeByte(static_cast<std::uint8_t>(WsModificationTag::FACT));
+    _writeFactOptional(pWriter, factPtr->factOptional);
+    _writeSuccessions(pWriter, factPtr->successions());
+  }
+  else if (const auto* nbPtr = toWmNumber(*pWsModificationPtr))
+  {
+    pWriter.writeByte(static_cast<std::uint8_t>(WsModificationTag::NUMBER));
+    _writeNumber(pWriter, nbPtr->getNb());
+  }
+  else
+  {
+    throw std::runtime_error("Unknown world state modification type to write in a snapshot");
+  }
+}
+
+std::unique_ptr<WorldStateModification> _readWsModification(SnapshotReader& pReader,
+                                                            const Ontology& pOntology)
+{
+  auto tag = static_cast<WsModificationTag>(pReader.readByte());
+  switch (tag)
+  {
+  case WsModificationTag::NONE:
+    return {};
+  case WsModificationTag::NODE:
+  {
+    auto nodeTypeValue = pReader.readByte();
+    if (nodeTypeValue > static_cast<std::uint8_t>(WorldStateModificationNodeType::MINUS))
+      throw std::runtime_error("Unknown world state modification node type in snapshot");
+    auto nodeType = static_cast<WorldStateModificationNodeType>(nodeTypeValue);
+    std::optional<Parameter> parameterOpt;
+    if (pReader.readBool())
+    {
+      auto nodeParameters = _readParameters(pReader, pOntology.types);
+      if (nodeParameters.size() != 1)
+        throw std::runtime_error("A world state modification node of a snapshot should have at most one parameter");
+      parameterOpt.emplace(nodeParameters.front());
+    }
+    auto leftOperand = _readWsModification(pReader, pOntology);
+    auto rightOperand = _readWsModification(pReader, pOntology);
+    auto res = std::make_unique<WorldStateModificationNode>(nodeType, std::move(leftOperand), std::move(rightOperand),
+                                                            parameterOpt);
+    res->setSuccessions(_readSuccessions(pReader));
+    return res;
+  }
+  case WsModificationTag::FACT:
+  {
+    auto res = std::make_unique<WorldStateModificationFact>(_readFactOptional(pReader, pOntology));
+    res->setSuccessions(_readSuccessions(pReader));
+    return res;
+  }
+  case WsModificationTag::NUMBER:
+    return std::make_unique<WorldStateModificationNumber>(_readNumber(pReader));
+  }
+  throw std::runtime_error("Unknown world state modification type in snapshot");
+}
+
+
+void _writeGoal(SnapshotWriter& pWriter,
+                const Goal& pGoal)
+{
+  _writeCondition(pWriter, &pGoal.objective());
+  pWriter.writeBool(pGoal.isPersistent());
+  pWriter.writeBool(pGoal.isOneStepTowards());
+  pWriter.writeInt(pGoal.getMaxTimeToKeepInactive());
+  pWriter.writeStr(pGoal.getGoalGroupId());
+}
+
+Goal _readGoal(SnapshotReader& pReader,
+               const Ontology& pOntology)
+{
+  auto objective = _readCondition(pReader, pOntology);
+  if (!objective)
+    throw std::runtime_error("A goal of the snapshot has no objective");
+  bool isPersistentIfSkipped = pReader.readBool();
+  bool oneStepTowards = pReader.readBool();
+  int maxTimeToKeepInactive = pReader.readInt();
+  std::string goalGroupId(pReader.readStr());
+  return Goal(std::move(objective), isPersistentIfSkipped, oneStepTowards, maxTimeToKeepInactive, goalGroupId);
+}
+
+
+void _writeGoals(SnapshotWriter& pWriter,
+                 const std::vector<Goal>& pGoals)
+{
+  pWriter.writeSize(pGoals.size());
+  for (const auto& currGoal : pGoals)
+    _writeGoal(pWriter, currGoal);
+}
+
+std::vector<Goal> _readGoals(SnapshotReader& pReader,
+                             const Ontology& pOntology)
+{
+  std::vector<Goal> res;
+  auto nbOfGoals = pReader.readCount(11);
+  res.reserve(nbOfGoals);
+  for (std::uint32_t i = 0; i < nbOfGoals; ++i)
+    res.emplace_back(_readGoal(pReader, pOntology));
+  return res;
+}
+
+
+void _writeGoalsWithPriority(SnapshotWriter& pWriter,
+                             const std::map<int, std::vector<Goal>>& pGoals)
+{
+  pWriter.writeSize(pGoals.size());
+  for (const auto& currPriorityToGoals : pGoals)
+  {
+    pWriter.writeInt(currPriorityToGoals.first);
+    _writeGoals(pWriter, currPriorityToGoals.second);
+  }
+}
+
+std::map<int, std::vector<Goal>> _readGoalsWithPriority(SnapshotReader& pReader,
+                                                        const Ontology& pOntology)
+{
+  std::map<int, std::vector<Goal>> res;
+  auto nbOfPriorities = pReader.readCount(8);
+  for (std::uint32_t i = 0; i < nbOfPriorities; ++i)
+  {
+    int priority = pReader.readInt();
+    res.emplace(priority, _readGoals(pReader, pOntology));
+  }
+  return res;
+}
+
+
+void _writeAction(SnapshotWriter& pWriter,
+                  const Action& pAction)
+{
+  _writeParameters(pWriter, pAction.parameters);
+  _writeCondition(pWriter, pAction.precondition.get());
+  _writeCondition(pWriter, pAction.overAllCondition.get());
+  _writeCondition(pWriter, pAction.preferInContext.get());
+  const auto& effect = pAction.effect;
+  _writeWsModification(pWriter, effect.worldStateModification.get());
+  _writeWsModification(pWriter, effect.potentialWorldStateModification.get());
+  _writeWsModification(pWriter, effect.worldStateModificationAtStart.get());
+  _writeGoalsWithPriority(pWriter, effect.goalsToAdd);
+  _writeGoals(pWriter, effect.goalsToAddInCurrentPriority);
+  pWriter.writeBool(pAction.highImportanceOfNotRepeatingIt);
+  pWriter.writeBool(pAction.canThisActionBeUsedByThePlanner);
+  _writeIds(pWriter, pAction.actionsSuccessionsWithoutInterestCache);
+  _writeIds(pWriter, pAction.actionsPredecessorsCache);
+  _writeIds(pWriter, pAction.eventsPredecessorsCache);
+}
+
+/// Read an action directly in a map of actions, because an action is copied and not moved.
+void _readAction(SnapshotReader& pReader,
+                 const Ontology& pOntology,
+                 std::map<ActionId, Action>& pActions,
+                 ActionId&& pActionId)
+{
+  auto parameters = _readParameters(pReader, pOntology.types);
+  auto precondition = _readCondition(pReader, pOntology);
+  auto overAllCondition = _readCondition(pReader, pOntology);
+  auto preferInContext = _readCondition(pReader, pOntology);
+  auto& action = pActions.emplace_hint(pActions.end(), std::piecewise_construct,
+                                       std::forward_as_tuple(std::move(pActionId)),
+                                       std::forward_as_tuple(std::move(precondition), ProblemModification(),
+                                                             std::move(preferInContext)))->second;
+  action.parameters = std::move(parameters);
+  action.overAllCondition = std::move(overAllCondition);
+  auto& effect = action.effect;
+  effect.worldStateModification = _readWsModification(pReader, pOntology);
+  effect.potentialWorldStateModification = _readWsModification(pReader, pOntology);
+  effect.worldStateModificationAtStart = _readWsModification(pReader, pOntology);
+  effect.goalsToAdd = _readGoalsWithPriority(pReader, pOntology);
+  effect.goalsToAddInCurrentPriority = _readGoals(pReader, pOntology);
+  action.highImportanceOfNotRepeatingIt = pReader.readBool();
+  action.canThisActionBeUsedByThePlanner = pReader.readBool();
+  action.actionsSuccessionsWithoutInterestCache = _readIds(pReader);
+  action.actionsPredecessorsCache = _readIds(pReader);
+  action.eventsPredecessorsCache = _readIds(pReader);
+}
+
+
+void _writeEvent(SnapshotWriter& pWriter,
+                 const Event& pEvent)
+{
+  _writeParameters(pWriter, pEvent.parameters);
+  _writeCondition(pWriter, pEvent.precondition.get());
+  _writeWsModification(pWriter, pEvent.factsToModify.get());
+  _writeGoalsWithPriority(pWriter, pEvent.goalsToAdd);
+  _writeIds(pWriter, pEvent.actionsPredecessorsCache);
+  _writeIds(pWriter, pEvent.eventsPredecessorsCache);
+}
+
+Event _readEvent(SnapshotReader& pReader,
+                 const Ontology& pOntology)
+{
+  auto parameters = _readParameters(pReader, pOntology.types);
+  auto precondition = _readCondition(pReader, pOntology);
+  auto factsToModify = _readWsModification(pReader, pOntology);
+  auto goalsToAdd = _readGoalsWithPriority(pReader, pOntology);
+  Event res(std::move(precondition), std::move(factsToModify), parameters, goalsToAdd);
+  res.actionsPredecessorsCache = _readIds(pReader);
+  res.eventsPredecessorsCache = _readIds(pReader);
+  return res;
+}
+
+
+/// Write the facts of the preconditions of the actions linked to the actions, as Domain indexes them.
+void _writeConditionsToActions(SnapshotWriter& pWriter,
+                               const std::map<ActionId, Action>& pActions)
+{
+  std::vector<const ActionId*> actionIdsWithoutFact;
+  std::size_t nbOfEntries = 0;
+  for (const auto& currAction : pActions)
+  {
+    const Action& action = currAction.second;
+    if (!action.canThisActionBeUsedByThePlanner)
+      continue;
+    bool hasAFact = false;
+    if (action.precondition)
+    {
+      action.precondition->forAll([&](const FactOptional& pFactOptional, bool)
+      {
+        ++nbOfEntries;
+        if (!pFactOptional.isFactNegated)
+          hasAFact = true;
+        return ContinueOrBreak::CONTINUE;
+      });
+    }
+    if (!hasAFact)
+      actionIdsWithoutFact.push_back(&currAction.first);
+  }
+
+  pWriter.writeSize(actionIdsWithoutFact.size());
+  for (const auto* currActionIdPtr : actionIdsWithoutFact)
+    pWriter.writeStr(*currActionIdPtr);
+  pWriter.writeSize(nbOfEntries);
+  for (const auto& currAction : pActions)
+  {
+    const Action& action = currAction.second;
+    if (!action.canThisActionBeUsedByThePlanner || !action.precondition)
+      continue;
+    action.precondition->forAll([&](const FactOptional& pFactOptional, bool pIgnoreFluent)
+    {
+      pWriter.writeStr(currAction.first);
+      pWriter.writeBool(pIgnoreFluent);
+      _writeFactOptional(pWriter, pFactOptional);
+      return ContinueOrBreak::CONTINUE;
+    });
+  }
+}
+
+
+void _writeFacts(SnapshotWriter& pWriter,
+                 const std::map<Fact, bool>& pFacts,
+                 bool pOnlyRemovableFacts)
+{
+  std::size_t nbOfFacts = 0;
+  for (const auto& currFact : pFacts)
+    if (!pOnlyRemovableFacts || currFact.second)
+      ++nbOfFacts;
+  pWriter.writeSize(nbOfFacts);
+  for (const auto& currFact : pFacts)
+    if (!pOnlyRemovableFacts || currFact.second)
+      _writeFact(pWriter, currFact.first);
+}
+
+std::vector<Fact> _readFacts(SnapshotReader& pReader,
+                             const Ontology& pOntology)
+{
+  std::vector<Fact> res;
+  auto nbOfFacts = pReader.readCount(11);
+  res.reserve(nbOfFacts);
+  for (std::uint32_t i = 0; i < nbOfFacts; ++i)
+    res.emplace_back(_readFact(pReader, pOntology));
+  return res;
+}
+
+
+void _writeFile(const std::string& pContent,
+                const std::string& pFilename)
+{
+  std::ofstream file(pFilename, std::ios::binary | std::ios::trunc);
+  if (!file.is_open())
+    throw std::runtime_error("Unable to open the snapshot file: " + pFilename);
+  file.write(pContent.data(), static_cast<std::streamsize>(pContent.size()));
+  if (!file)
+    throw std::runtime_error("Failed to write the snapshot file: " + pFilename);
+}
+
+}
+
+
+struct DomainSnapshotLoader
+{
+  static Domain load(const char* pData,
+                     std::size_t pSize)
+  {
+    SnapshotReader reader(pData, pSize, SnapshotKind::OF_DOMAIN);
+    Domain res;
+    res._uuid = generateUuid();
+    res._name = reader.readStr();
+    auto nbOfRequirements = reader.readCount(4);
+    for (std::uint32_t i = 0; i < nbOfRequirements; ++i)
+      res._requirements.emplace_hint(res._requirements.end(), reader.readStr());
+
+    Ontology& ontology = res._ontology;
+    _readTypes(reader, ontology.types);
+    auto nbOfPredicates = reader.readCount(9);
+    for (std::uint32_t i = 0; i < nbOfPredicates; ++i)
+      ontology.predicates.addPredicate(_readPredicate(reader, ontology.types));
+    _readEntities(reader, ontology.constants, ontology.types);
+    auto nbOfDerivedPredicates = reader.readCount(10);
+    for (std::uint32_t i = 0; i < nbOfDerivedPredicates; ++i)
+    {
+      auto predicate = _readPredicate(reader, ontology.types);
+      auto condition = _readCondition(reader, ontology);
+      ontology.derivedPredicates.addDerivedPredicate(DerivedPredicate(predicate, std::move(condition)));
+    }
+
+    auto nbOfTimelessFacts = reader.readCount(11);
+    for (std::uint32_t i = 0; i < nbOfTimelessFacts; ++i)
+      res._timelessFacts.add(_readFact(reader, ontology));
+
+    // The actions are read already cloned for the domain, with their caches
+    auto nbOfActions = reader.readCount(4);
+    for (std::uint32_t i = 0; i < nbOfActions; ++i)
+    {
+      ActionId actionId(reader.readStr());
+      _readAction(reader, ontology, res._actions, std::move(actionId));
+    }
+    auto nbOfActionsWithoutFact = reader.readCount(4);
+    for (std::uint32_t i = 0; i < nbOfActionsWithoutFact; ++i)
+      res._actionsWithoutFactToAddInPrecondition.addValueWithoutFact(std::string(reader.readStr()));
+    auto nbOfConditionEntries = reader.readCount(4);
+    for (std::uint32_t i = 0; i < nbOfConditionEntries; ++i)
+    {
+      ActionId actionId(reader.readStr());
+      bool ignoreFluent = reader.readBool();
+      res._conditionsToActions.addFact(_readFactOptional(reader, ontology), actionId, ignoreFluent);
+    }
+
+    auto nbOfSetOfEvents = reader.readCount(8);
+    for (std::uint32_t i = 0; i < nbOfSetOfEvents; ++i)
+    {
+      auto& setOfEvents = res._setOfEvents[std::string(reader.readStr())];
+      auto nbOfEvents = reader.readCount(4);
+      for (std::uint32_t j = 0; j < nbOfEvents; ++j)
+      {
+        EventId eventId(reader.readStr());
+        setOfEvents.add(_readEvent(reader, ontology), eventId);
+      }
+    }
+    reader.checkEnd();
+
+    res._updateIndexesInDomainCache();
+    return res;
+  }
+};
+
+
+
+std::string domainToSnapshot(const Domain& pDomain)
+{
+  SnapshotWriter writer;
+  writer.writeStr(pDomain.getName());
+  const auto& requirements = pDomain.requirements();
+  writer.writeSize(requirements.size());
+  for (const auto& currRequirement : requirements)
+    writer.writeStr(currRequirement);
+
+  const auto& ontology = pDomain.getOntology();
+  _writeTypes(writer, ontology.types);
+  const auto& predicates = ontology.predicates.allPredicates();
+  writer.writeSize(predicates.size());
+  for (const auto& currPredicate : predicates)
+    _writePredicate(writer, currPredicate.second);
+  _writeEntities(writer, ontology.constants);
+  const auto& derivedPredicates = ontology.derivedPredicates.allDerivedPredicates();
+  writer.writeSize(derivedPredicates.size());
+  for (const auto& currDerivedPredicate : derivedPredicates)
+  {
+    _writePredicate(writer, currDerivedPredicate.second.predicate);
+    _writeCondition(writer, currDerivedPredicate.second.condition.get());
+  }
+
+  _writeFacts(writer, pDomain.getTimelessFacts().setOfFacts().facts(), false);
+
+  const auto& actions = pDomain.actions();
+  writer.writeSize(actions.size());
+  for (const auto& currAction : actions)
+  {
+    writer.writeStr(currAction.first);
+    _writeAction(writer, currAction.second);
+  }
+  _writeConditionsToActions(writer, actions);
+
+  const auto& setOfEvents = pDomain.getSetOfEvents();
+  writer.writeSize(setOfEvents.size());
+  for (const auto& currSetOfEvents : setOfEvents)
+  {
+    writer.writeStr(currSetOfEvents.first);
+    const auto& events = currSetOfEvents.second.events();
+    writer.writeSize(events.size());
+    for (const auto& currEvent : events)
+    {
+      writer.writeStr(currEvent.first);
+      _writeEvent(writer, currEvent.second);
+    }
+  }
+  return writer.finalize(SnapshotKind::OF_DOMAIN);
+}
+
+
+Domain snapshotToDomain(const char* pData,
+                        std::size_t pSize)
+{
+  return DomainSnapshotLoader::load(pData, pSize);
+}
+
+
+Domain snapshotToDomain(const std::string& pSnapshot)
+{
+  return snapshotToDomain(pSnapshot.data(), pSnapshot.size());
+}
+
+
+void saveDomainSnapshot(const Domain& pDomain,
+                        const std::string& pFilename)
+{
+  _writeFile(domainToSnapshot(pDomain), pFilename);
+}
+
+
+Domain loadDomainSnapshot(const std::string& pFilename)
+{
+  FileContent fileContent(pFilename);
+  return snapshotToDomain(fileContent.data(), fileContent.size());
+}
+
+
+
+std::string problemToSnapshot(const Problem& pProblem,
+                              const Domain& pDomain)
+{
+  SnapshotWriter writer;
+  writer.writeStr(pDomain.getName());
+  writer.writeStr(pProblem.name);
+  _writeEntities(writer, pProblem.entities);
+  _writeFacts(writer, pProblem.worldState.facts(), true);
+  _writeGoalsWithPriority(writer, pProblem.goalStack.goals());
+  return writer.finalize(SnapshotKind::OF_PROBLEM);
+}
+
+
+std::unique_ptr<Problem> snapshotToProblem(const char* pData,
+                                           std::size_t pSize,
+                                           const Domain& pDomain)
+{
+  SnapshotReader reader(pData, pSize, SnapshotKind::OF_PROBLEM);
+  auto domainName = reader.readStr();
+  if (domainName != pDomain.getName())
+    throw std::runtime_error("The problem snapshot is for the domain \"" + std::string(domainName) + "\" and not for the domain \"" +
+                             pDomain.getName() + "\"");
+
+  const auto& ontology = pDomain.getOntology();
+  auto res = std::make_unique<Problem>(&pDomain.getTimelessFacts().setOfFacts());
+  res->name = reader.readStr();
+  _readEntities(reader, res->entities, ontology.types);
+  auto facts = _readFacts(reader, ontology);
+  auto goals = _readGoalsWithPriority(reader, ontology);
+  reader.checkEnd();
+
+  const SetOfCallbacks callbacks;
+  res->worldState.addFacts(facts, res->goalStack, pDomain.getSetOfEvents(), callbacks,
+                           ontology, res->entities, {});
+  res->goalStack.setGoals(goals, res->worldState, {});
+  return res;
+}
+
+
+std::unique_ptr<Problem> snapshotToProblem(const std::string& pSnapshot,
+                                           const Domain& pDomain)
+{
+  return snapshotToProblem(pSnapshot.data(), pSnapshot.size(), pDomain);
+}
+
+
+void saveProblemSnapshot(const Problem& pProblem,
+                         const Domain& pDomain,
+                         const std::string& pFilename)
+{
+  _writeFile(problemToSnapshot(pProblem, pDomain), pFilename);
+}
+
+
+std::unique_ptr<Problem> loadProblemSnapshot(const std::string& pFilename,
+                                             const Domain& pDomain)
+{
+  FileContent fileContent(pFilename);
+  return snapshotToProblem(fileContent.data(), fileContent.size(), pDomain);
+}
+
+
+} // !ogp
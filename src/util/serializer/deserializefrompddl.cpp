@@ -1,11 +1,15 @@
 #include <orderedgoalsplanner/util/serializer/deserializefrompddl.hpp>
+#include <functional>
+#include <istream>
 #include <memory>
+#include <streambuf>
 #include <orderedgoalsplanner/types/axiom.hpp>
 #include <orderedgoalsplanner/types/domain.hpp>
 #include <orderedgoalsplanner/types/problem.hpp>
 #include <orderedgoalsplanner/types/setofcallbacks.hpp>
 #include "../../types/expressionParsed.hpp"
 #include "../../types/worldstatemodificationprivate.hpp"
+#include "../parallelfor.hpp"
 
 namespace ogp
 {
@@ -35,6 +39,9 @@ const char* _andWsFunctionName = "and";
 const char* _whenWsFunctionName = "when";
 const char* _notWsFunctionName = "not";
 
+/// Number of facts of the init section read before to parse them in parallel.
+const std::size_t _nbOfInitFactsPerChunk = 8192;
+
 
 std::vector<Parameter> _pddlArgumentsToParameters(
     const std::list<ExpressionParsed>& pArguments,
@@ -867,6 +874,356 @@ Action _durativeActionPddlToAction(const std::string& pStr,
   return res;
 }
 
+
+/// Stream buffer to read an existing memory area without copying it.
+struct MemoryStreamBuffer : public std::streambuf
+{
+  MemoryStreamBuffer(const char* pData,
+                     std::size_t pSize)
+  {
+    char* data = const_cast<char*>(pData);
+    setg(data, data, data + pSize);
+  }
+};
+
+
+/// Read a PDDL content from a stream without keeping in memory more than the part being parsed.
+struct PddlStreamReader
+{
+  PddlStreamReader(std::istream& pInput)
+    : _bufferPtr(pInput.rdbuf())
+  {
+    if (_bufferPtr == nullptr)
+      throw std::runtime_error("The PDDL stream has no buffer");
+  }
+
+  bool isAtEnd() const { return _bufferPtr->sgetc() == std::char_traits<char>::eof(); }
+  char current() const { return std::char_traits<char>::to_char_type(_bufferPtr->sgetc()); }
+  void next() { _bufferPtr->sbumpc(); }
+
+  /// Move after the first occurrence of a text that does not contain its first character elsewhere. Returns false if the text is not found.
+  bool moveAfter(const std::string& pText)
+  {
+    std::size_t nbOfMatchingChars = 0;
+    while (nbOfMatchingChars < pText.size() && !isAtEnd())
+    {
+      char currChar = current();
+      next();
+      if (currChar == pText[nbOfMatchingChars])
+        ++nbOfMatchingChars;
+      else
+        nbOfMatchingChars = currChar == pText[0] ? 1 : 0;
+    }
+    return nbOfMatchingChars == pText.size();
+  }
+
+  void moveUntilEndOfLine()
+  {
+    while (!isAtEnd() && current() != '\n')
+      next();
+  }
+
+  void skipSpaces()
+  {
+    while (!isAtEnd())
+    {
+      char currChar = current();
+      if (currChar == ';')
+        moveUntilEndOfLine();
+      else if (currChar != ' ' && currChar != '\n' && currChar != '\t')
+        break;
+      next();
+    }
+  }
+
+  std::string parseToken()
+  {
+    skipSpaces();
+    std::string res;
+    while (!isAtEnd())
+    {
+      char currChar = current();
+      if (currChar == ';')
+      {
+        moveUntilEndOfLine();
+        next();
+        break;
+      }
+      if (ExpressionParsed::isEndOfTokenSeparator(currChar))
+        break;
+      res += currChar;
+      next();
+    }
+    if (res.empty())
+      throw std::runtime_error("Empty token in PDDL stream");
+    return res;
+  }
+
+  /// Append the content until the closing parenthesis of the current level, without consuming it. The comments are kept because they can contain tags.
+  void appendUntilClosingParenthesis(std::string& pRes)
+  {
+    std::size_t depth = 0;
+    while (!isAtEnd())
+    {
+      char currChar = current();
+      if (currChar == ';')
+      {
+        _appendUntilEndOfLine(pRes);
+        continue;
+      }
+      if (currChar == '(')
+        ++depth;
+      else if (currChar == ')' && depth-- == 0)
+        return;
+      pRes += currChar;
+      next();
+    }
+  }
+
+  /// Append the next token or the next expression between parenthesis.
+  void appendElement(std::string& pRes)
+  {
+    if (isAtEnd() || current() != '(')
+    {
+      pRes += parseToken();
+      return;
+    }
+    std::size_t depth = 0;
+    while (!isAtEnd())
+    {
+      char currChar = current();
+      if (currChar == ';')
+      {
+        _appendUntilEndOfLine(pRes);
+        continue;
+      }
+      pRes += currChar;
+      next();
+      if (currChar == '(')
+        ++depth;
+      else if (currChar == ')' && --depth == 0)
+        return;
+    }
+  }
+
+private:
+  std::streambuf* _bufferPtr;
+
+  void _appendUntilEndOfLine(std::string& pRes)
+  {
+    while (!isAtEnd() && current() != '\n')
+    {
+      pRes += current();
+      next();
+    }
+  }
+};
+
+
+/// Facts of the init section read by chunks and parsed in parallel, because they do not depend on each other.
+struct InitFactsChunk
+{
+  /// Read the next facts of the section and parse them. Returns false if there is no more fact.
+  bool readAndParse(PddlStreamReader& pReader,
+                    const Ontology& pOntology,
+                    const SetOfEntities& pEntities)
+  {
+    nbOfFacts = 0;
+    nextFactIndex = 0;
+    while (nbOfFacts < _nbOfInitFactsPerChunk)
+    {
+      pReader.skipSpaces();
+      if (pReader.isAtEnd() || pReader.current() == ')')
+        break;
+      if (nbOfFacts == factStrs.size())
+        factStrs.emplace_back();
+      factStrs[nbOfFacts].clear();
+      pReader.appendElement(factStrs[nbOfFacts]);
+      ++nbOfFacts;
+    }
+    if (nbOfFacts == 0)
+      return false;
+
+    facts.resize(nbOfFacts);
+    areFactsNegated.assign(nbOfFacts, false);
+    errors.assign(nbOfFacts, nullptr);
+    parallelFor(nbOfFacts, [&](std::size_t pIndex)
+    {
+      try
+      {
+        bool isFactNegated = false;
+        facts[pIndex].emplace(factStrs[pIndex], true, pOntology, pEntities, std::vector<Parameter>(), &isFactNegated);
+        areFactsNegated[pIndex] = isFactNegated;
+      }
+      catch (...)
+      {
+        errors[pIndex] = std::current_exception();
+      }
+    });
+    // Raise the error of the first invalid fact, as if the facts were parsed one by one
+    for (const auto& currError : errors)
+      if (currError)
+        std::rethrow_exception(currError);
+    return true;
+  }
+
+  std::vector<std::string> factStrs;
+  std::size_t nbOfFacts = 0;
+  std::size_t nextFactIndex = 0;
+  std::vector<std::optional<Fact>> facts;
+  /// Stored as char and not as bool because they are written from several threads.
+  std::vector<char> areFactsNegated;
+  std::vector<std::exception_ptr> errors;
+};
+
+
+void _setDomainOfProblem(DomainAndProblemPtrs& pRes,
+                         const std::string& pDomainName,
+                         const std::map<std::string, Domain>& pLoadedDomains)
+{
+  auto itDomain = pLoadedDomains.find(pDomainName);
+  if (itDomain == pLoadedDomains.end())
+    throw std::runtime_error("Domain \"" + pDomainName + "\" is unknown!");
+  pRes.domainPtr = std::make_unique<Domain>(itDomain->second);
+  pRes.problemPtr = std::make_unique<Problem>(&pRes.domainPtr->getTimelessFacts().setOfFacts());
+}
+
+
+/// Domain of a problem being read and the problem to fill.
+struct DomainAndProblemToFill
+{
+  const Domain* domainPtr = nullptr;
+  Problem* problemPtr = nullptr;
+};
+
+
+void _addPddlGoals(Problem& pProblem,
+                   const Domain& pDomain,
+                   const std::string& pStr)
+{
+  const auto& ontology = pDomain.getOntology();
+  std::vector<Goal> goals;
+  const auto& worldState = pProblem.worldState;
+  const auto& entities = pProblem.entities;
+
+  std::size_t pos = 0;
+  auto expressionParsed = ExpressionParsed::fromPddl(pStr, pos, false);
+  if (expressionParsed.name == "and" && expressionParsed.tags.count("__ORDERED") > 0)
+  {
+    for (auto& currGoalExpParsed : expressionParsed.arguments)
+    {
+      auto goalPtr = _expressionParsedToGoal(currGoalExpParsed, ontology, entities, -1, "");
+      if (!goalPtr)
+        throw std::runtime_error("Failed to parse a pddl goal");
+      goals.emplace_back(std::move(*goalPtr));
+    }
+  }
+  else
+  {
+    auto goalPtr = _expressionParsedToGoal(expressionParsed, ontology, entities, -1, "");
+    if (!goalPtr)
+      throw std::runtime_error("Failed to parse a pddl goal");
+    goals.emplace_back(std::move(*goalPtr));
+  }
+
+  pProblem.goalStack.addGoals(goals, worldState, {});
+}
+
+
+/// Read a problem from a PDDL stream. pGetDomainAndProblem gives the domain and the problem to fill from the name of the domain.
+void _pddlToProblem(std::istream& pInput,
+                    const std::function<DomainAndProblemToFill(const std::string&)>& pGetDomainAndProblem)
+{
+  DomainAndProblemToFill res;
+  std::string problemName;
+  PddlStreamReader reader(pInput);
+
+  if (!reader.moveAfter("(define"))
+    throw std::runtime_error("No '(define' found in domain file");
+
+  while (!reader.isAtEnd())
+  {
+    if (reader.current() == ';')
+    {
+      reader.moveUntilEndOfLine();
+      reader.next();
+      continue;
+    }
+
+    if (reader.current() == '(')
+    {
+      reader.next();
+      auto token = reader.parseToken();
+
+      if (token == "problem")
+      {
+        problemName = reader.parseToken();
+      }
+      else if (token == ":domain")
+      {
+        reader.skipSpaces();
+        while (!reader.isAtEnd() && reader.current() != ')')
+        {
+          res = pGetDomainAndProblem(reader.parseToken());
+          reader.skipSpaces();
+        }
+      }
+      else if (token == ":objects")
+      {
+        if (!res.domainPtr)
+          throw std::runtime_error("problem objects are defined before the domain.");
+        const auto& ontology = res.domainPtr->getOntology();
+        std::string entitiesStr;
+        reader.appendUntilClosingParenthesis(entitiesStr);
+        res.problemPtr->entities.addAllFromPddl(entitiesStr, ontology.types);
+      }
+      else if (token == ":init")
+      {
+        if (!res.domainPtr)
+          throw std::runtime_error("problem init are defined before the domain.");
+        const auto& ontology = res.domainPtr->getOntology();
+        auto& setOfEventsMap = res.domainPtr->getSetOfEvents();
+        const SetOfCallbacks callbacks;
+        const auto& entities = res.problemPtr->entities;
+        // The facts are read by chunks to never have the full :init section in memory
+        InitFactsChunk chunk;
+        res.problemPtr->worldState.modifyFacts([&](bool& pIsFactNegated) -> std::optional<Fact>
+        {
+          if (chunk.nextFactIndex == chunk.nbOfFacts &&
+              !chunk.readAndParse(reader, ontology, entities))
+            return {};
+          pIsFactNegated = chunk.areFactsNegated[chunk.nextFactIndex] != 0;
+          return std::move(chunk.facts[chunk.nextFactIndex++]);
+        }, res.problemPtr->goalStack, setOfEventsMap, callbacks, ontology, entities, {});
+      }
+      else if (token == ":goal")
+      {
+        if (!res.domainPtr)
+          throw std::runtime_error("problem objects are defined before the domain.");
+        if (!res.problemPtr)
+          throw std::runtime_error("problem not initialized before to set the goals.");
+        std::string goalStr;
+        reader.appendUntilClosingParenthesis(goalStr);
+        _addPddlGoals(*res.problemPtr, *res.domainPtr, goalStr);
+      }
+      else if (token == ":constraints")
+      {
+        break;
+      }
+      else
+      {
+        throw std::runtime_error("Unknown domain PDDL token: \"" + token + "\"");
+      }
+    }
+
+    reader.next();
+  }
+
+  if (!res.problemPtr)
+    throw std::runtime_error("problem not initialized");
+  res.problemPtr->name = problemName;
+}
+
 }
 
 Domain pddlToDomain(const std::string& pStr,
@@ -997,120 +1354,35 @@ Domain pddlToDomain(const std::string& pStr,
 DomainAndProblemPtrs pddlToProblem(const std::string& pStr,
                                    const std::map<std::string, Domain>& pLoadedDomains)
 {
-  DomainAndProblemPtrs res;
-  std::string problemName;
-
-  const std::string defineToken = "(define";
-  std::size_t found = pStr.find(defineToken);
-  if (found != std::string::npos)
-  {
-    auto strSize = pStr.size();
-    std::size_t pos = found + defineToken.size();
-
-    while (pos < strSize)
-    {
-      if (pStr[pos] == ';')
-      {
-        ExpressionParsed::moveUntilEndOfLine(pStr, pos);
-        ++pos;
-        continue;
-      }
-
-      if (pStr[pos] == '(')
-      {
-        ++pos;
-        auto token = ExpressionParsed::parseToken(pStr, pos);
-
-        if (token == "problem")
-        {
-          problemName = ExpressionParsed::parseToken(pStr, pos);
-        }
-        else if (token == ":domain")
-        {
-          while (pos < strSize && pStr[pos] != ')')
-          {
-            auto domainToExtend = ExpressionParsed::parseToken(pStr, pos);
-            auto itDomain = pLoadedDomains.find(domainToExtend);
-            if (itDomain == pLoadedDomains.end())
-              throw std::runtime_error("Domain \"" + domainToExtend + "\" is unknown!");
-            res.domainPtr = std::make_unique<Domain>(itDomain->second);
-            res.problemPtr = std::make_unique<Problem>(&res.domainPtr->getTimelessFacts().setOfFacts());
-          }
-        }
-        else if (token == ":objects")
-        {
-          if (!res.domainPtr)
-            throw std::runtime_error("problem objects are defined before the domain.");
-          const auto& ontology = res.domainPtr->getOntology();
-          std::size_t beginPos = pos;
-          ExpressionParsed::moveUntilClosingParenthesis(pStr, pos);
-          std::string entitiesStr = pStr.substr(beginPos, pos - beginPos);
-          res.problemPtr->entities.addAllFromPddl(entitiesStr, ontology.types);
-        }
-        else if (token == ":init")
-        {
-          if (!res.domainPtr)
-            throw std::runtime_error("problem init are defined before the domain.");
-          const auto& ontology = res.domainPtr->getOntology();
-          auto& setOfEventsMap = res.domainPtr->getSetOfEvents();
-          const SetOfCallbacks callbacks;
-          res.problemPtr->worldState.modifyFactsFromPddl(pStr, pos, res.problemPtr->goalStack,
-                                                         setOfEventsMap, callbacks,
-                                                         ontology, res.problemPtr->entities, {});
-        }
-        else if (token == ":goal")
-        {
-          if (!res.domainPtr)
-            throw std::runtime_error("problem objects are defined before the domain.");
-          if (!res.problemPtr)
-            throw std::runtime_error("problem not initialized before to set the goals.");
-          const auto& ontology = res.domainPtr->getOntology();
-          std::vector<Goal> goals;
-          const auto& worldState = res.problemPtr->worldState;
-          const auto& entities = res.problemPtr->entities;
-
-          auto expressionParsed = ExpressionParsed::fromPddl(pStr, pos, false);
-          if (expressionParsed.name == "and" && expressionParsed.tags.count("__ORDERED") > 0)
-          {
-            for (auto& currGoalExpParsed : expressionParsed.arguments)
-            {
-              auto goalPtr = _expressionParsedToGoal(currGoalExpParsed, ontology, entities, -1, "");
-              if (!goalPtr)
-                throw std::runtime_error("Failed to parse a pddl goal");
-              goals.emplace_back(std::move(*goalPtr));
-            }
-          }
-          else
-          {
-            auto goalPtr = _expressionParsedToGoal(expressionParsed, ontology, entities, -1, "");
-            if (!goalPtr)
-              throw std::runtime_error("Failed to parse a pddl goal");
-            goals.emplace_back(std::move(*goalPtr));
-          }
+  MemoryStreamBuffer streamBuffer(pStr.data(), pStr.size());
+  std::istream input(&streamBuffer);
+  return pddlToProblem(input, pLoadedDomains);
+}
 
-          res.problemPtr->goalStack.addGoals(goals, worldState, {});
-        }
-        else if (token == ":constraints")
-        {
-          break;
-        }
-        else
-        {
-          throw std::runtime_error("Unknown domain PDDL token: \"" + token + "\"");
-        }
-      }
 
-      ++pos;
-    }
+DomainAndProblemPtrs pddlToProblem(std::istream& pInput,
+                                   const std::map<std::string, Domain>& pLoadedDomains)
+{
+  DomainAndProblemPtrs res;
+  _pddlToProblem(pInput, [&](const std::string& pDomainName)
+  {
+    _setDomainOfProblem(res, pDomainName, pLoadedDomains);
+    return DomainAndProblemToFill{res.domainPtr.get(), res.problemPtr.get()};
+  });
+  return res;
+}
 
-  } else {
-    throw std::runtime_error("No '(define' found in domain file");
-  }
 
-  if (!res.problemPtr)
-    throw std::runtime_error("problem not initialized");
-  res.problemPtr->name = problemName;
-  return res;
+void pddlToProblem(Problem& pProblem,
+                   std::istream& pInput,
+                   const Domain& pDomain)
+{
+  _pddlToProblem(pInput, [&](const std::string& pDomainName)
+  {
+    if (pDomainName != pDomain.getName())
+      throw std::runtime_error("Domain \"" + pDomainName + "\" is unknown!");
+    return DomainAndProblemToFill{&pDomain, &pProblem};
+  });
 }
 
 
@@ -1,4 +1,6 @@
 #include <orderedgoalsplanner/util/serializer/serializeinpddl.hpp>
+#include <ostream>
+#include <sstream>
 #include <orderedgoalsplanner/types/domain.hpp>
 #include <orderedgoalsplanner/types/problem.hpp>
 #include "../../types/worldstatemodificationprivate.hpp"
@@ -253,64 +255,66 @@ std::string _effectsToPddl(
 }
 
 
-std::string domainToPddl(const Domain& pDomain)
+void domainToPddl(std::ostream& pOutput,
+                  const Domain& pDomain)
 {
-  std::string res = "(define\n";
+  pOutput << "(define\n";
 
   std::size_t identation = _identationOffset;
+  const std::string identationStr(identation, ' ');
 
 
-  res += std::string(identation, ' ') + "(domain " + pDomain.getName() + ")\n";
+  pOutput << identationStr << "(domain " << pDomain.getName() << ")\n";
 
   const auto& requirements = pDomain.requirements();
   if (!requirements.empty())
   {
-    res += std::string(identation, ' ') + "(:requirements";
+    pOutput << identationStr << "(:requirements";
     for (const auto& currRequirement : requirements)
-      res += " " + currRequirement;
-    res += ")\n";
+      pOutput << " " << currRequirement;
+    pOutput << ")\n";
   }
-  res += "\n";
+  pOutput << "\n";
 
   const auto& ontology = pDomain.getOntology();
 
   if (!ontology.types.empty())
   {
-    res += std::string(identation, ' ') + "(:types\n";
-    res += ontology.types.toStr(_identationOffset + identation);
-    res += "\n" + std::string(identation, ' ') + ")\n\n";
+    pOutput << identationStr << "(:types\n";
+    pOutput << ontology.types.toStr(_identationOffset + identation);
+    pOutput << "\n" << identationStr << ")\n\n";
   }
 
   if (!ontology.constants.empty())
   {
-    res += std::string(identation, ' ') + "(:constants\n";
-    res += ontology.constants.toStr(_identationOffset + identation);
-    res += "\n" + std::string(identation, ' ') + ")\n\n";
+    pOutput << identationStr << "(:constants\n";
+    pOutput << ontology.constants.toStr(_identationOffset + identation);
+    pOutput << "\n" << identationStr << ")\n\n";
   }
 
   if (ontology.predicates.hasPredicateOfPddlType(PredicatePddlType::PDDL_PREDICATE))
   {
-    res += std::string(identation, ' ') + "(:predicates\n";
-    res += ontology.predicates.toPddl(PredicatePddlType::PDDL_PREDICATE, _identationOffset + identation);
-    res += "\n" + std::string(identation, ' ') + ")\n\n";
+    pOutput << identationStr << "(:predicates\n";
+    pOutput << ontology.predicates.toPddl(PredicatePddlType::PDDL_PREDICATE, _identationOffset + identation);
+    pOutput << "\n" << identationStr << ")\n\n";
   }
 
   if (ontology.predicates.hasPredicateOfPddlType(PredicatePddlType::PDDL_FUNCTION))
   {
-    res += std::string(identation, ' ') + "(:functions\n";
-    res += ontology.predicates.toPddl(PredicatePddlType::PDDL_FUNCTION, _identationOffset + identation);
-    res += "\n" + std::string(identation, ' ') + ")\n\n";
+    pOutput << identationStr << "(:functions\n";
+    pOutput << ontology.predicates.toPddl(PredicatePddlType::PDDL_FUNCTION, _identationOffset + identation);
+    pOutput << "\n" << identationStr << ")\n\n";
   }
 
   const auto& timelessFacts = pDomain.getTimelessFacts().setOfFacts();
   if (!timelessFacts.empty())
   {
-    res += std::string(identation, ' ') + "(:timeless\n";
-    res += timelessFacts.toPddl(_identationOffset + identation, true);
-    res += "\n" + std::string(identation, ' ') + ")\n\n";
+    pOutput << identationStr << "(:timeless\n";
+    timelessFacts.toPddl(pOutput, _identationOffset + identation, true);
+    pOutput << "\n" << identationStr << ")\n\n";
   }
 
-  auto setOfEvents = pDomain.getSetOfEvents();
+  const auto& setOfEvents = pDomain.getSetOfEvents();
   if (!setOfEvents.empty())
   {
     for (const auto& currSetOfEvent : setOfEvents)
@@ -318,83 +322,80 @@ std::string domainToPddl(const Domain& pDomain)
       for (const auto& currEventIdToEvent : currSetOfEvent.second.events())
       {
         const Event& currEvent = currEventIdToEvent.second;
-        res += std::string(identation, ' ') + "(:event ";
+        pOutput << identationStr << "(:event ";
         if (setOfEvents.size() == 1)
-          res += currEventIdToEvent.first + "\n";
+          pOutput << currEventIdToEvent.first << "\n";
         else
-          res += currSetOfEvent.first + "-" + currEventIdToEvent.first + "\n";
-        res += "\n";
+          pOutput << currSetOfEvent.first << "-" << currEventIdToEvent.first << "\n";
+        pOutput << "\n";
         std::size_t subIdentation = identation + _identationOffset;
         std::size_t subSubIdentation = subIdentation + _identationOffset;
+        const std::string subIdentationStr(subIdentation, ' ');
+        const std::string subSubIdentationStr(subSubIdentation, ' ');
 
-        std::string eventContent;
+        bool isEventContentEmpty = true;
         if (!currEvent.parameters.empty())
         {
-          eventContent += std::string(subIdentation, ' ') + ":parameters\n";
-          eventContent += std::string(subSubIdentation, ' ') + _parametersToPddl(currEvent.parameters) + "\n";
+          pOutput << subIdentationStr << ":parameters\n";
+          pOutput << subSubIdentationStr << _parametersToPddl(currEvent.parameters) << "\n";
+          isEventContentEmpty = false;
         }
 
         if (currEvent.precondition)
         {
-          if (!eventContent.empty())
-            eventContent += "\n";
-          eventContent += std::string(subIdentation, ' ') + ":precondition\n";
-          eventContent += std::string(subSubIdentation, ' ') +
-              conditionToPddl(*currEvent.precondition, subSubIdentation) + "\n";
+          if (!isEventContentEmpty)
+            pOutput << "\n";
+          pOutput << subIdentationStr << ":precondition\n";
+          pOutput << subSubIdentationStr << conditionToPddl(*currEvent.precondition, subSubIdentation) << "\n";
+          isEventContentEmpty = false;
         }
 
         if (currEvent.factsToModify)
         {
-          if (!eventContent.empty())
-            eventContent += "\n";
-          eventContent += std::string(subIdentation, ' ') + ":effect\n";
-          eventContent += std::string(subSubIdentation, ' ') +
-              _effectToPddl(*currEvent.factsToModify, subSubIdentation);
+          if (!isEventContentEmpty)
+            pOutput << "\n";
+          pOutput << subIdentationStr << ":effect\n";
+          pOutput << subSubIdentationStr << _effectToPddl(*currEvent.factsToModify, subSubIdentation);
         }
 
-        res += eventContent;
-        res += "\n" + std::string(identation, ' ') + ")\n\n";
+        pOutput << "\n" << identationStr << ")\n\n";
       }
     }
   }
 
   for (const auto& currActionNameToAction : pDomain.actions())
   {
-    res += std::string(identation, ' ') + "(:durative-action " +
-        currActionNameToAction.first + "\n";
+    pOutput << identationStr << "(:durative-action " << currActionNameToAction.first << "\n";
     std::size_t subIdentation = identation + _identationOffset;
     std::size_t subSubIdentation = subIdentation + _identationOffset;
+    const std::string subIdentationStr(subIdentation, ' ');
+    const std::string subSubIdentationStr(subSubIdentation, ' ');
 
-    std::string actionContent;
     const Action& currAction = currActionNameToAction.second;
     if (!currAction.parameters.empty())
     {
-      actionContent += std::string(subIdentation, ' ') + ":parameters\n";
-      actionContent += std::string(subSubIdentation, ' ') + _parametersToPddl(currAction.parameters) + "\n";
+      pOutput << subIdentationStr << ":parameters\n";
+      pOutput << subSubIdentationStr << _parametersToPddl(currAction.parameters) << "\n";
+      pOutput << "\n";
     }
 
-    {
-      if (!actionContent.empty())
-        actionContent += "\n";
-      actionContent += std::string(subIdentation, ' ') + ":duration (= ?duration 1)\n";
-    }
+    pOutput << subIdentationStr << ":duration (= ?duration 1)\n";
 
     if (currAction.precondition || currAction.overAllCondition)
     {
-      actionContent += "\n";
-      actionContent += std::string(subIdentation, ' ') + ":condition\n";
+      pOutput << "\n";
+      pOutput << subIdentationStr << ":condition\n";
       std::list<ConditionWithPartInfo> conditionWithPartInfos;
       if (currAction.precondition)
         conditionWithPartInfos.emplace_back(*currAction.precondition, ConditionPart::AT_START);
       if (currAction.overAllCondition)
         conditionWithPartInfos.emplace_back(*currAction.overAllCondition, ConditionPart::OVER_ALL);
-      actionContent += std::string(subSubIdentation, ' ') +
-          _conditionsToPddl(conditionWithPartInfos, subSubIdentation) + "\n";
+      pOutput << subSubIdentationStr << _conditionsToPddl(conditionWithPartInfos, subSubIdentation) << "\n";
     }
 
     {
-      actionContent += "\n";
-      actionContent += std::string(subIdentation, ' ') + ":effect\n";
+      pOutput << "\n";
+      pOutput << subIdentationStr << ":effect\n";
       std::list<WorldStateModificationWithPartInfo> worldStateModificationWithPartInfos;
       if (currAction.effect.worldStateModificationAtStart)
         worldStateModificationWithPartInfos.emplace_back(*currAction.effect.worldStateModificationAtStart, WsModificationPart::AT_START);
@@ -402,82 +403,91 @@ std::string domainToPddl(const Domain& pDomain)
         worldStateModificationWithPartInfos.emplace_back(*currAction.effect.worldStateModification, WsModificationPart::AT_END);
       if (currAction.effect.potentialWorldStateModification)
         worldStateModificationWithPartInfos.emplace_back(*currAction.effect.potentialWorldStateModification, WsModificationPart::POTENTIALLY_AT_END);
-      actionContent += std::string(subSubIdentation, ' ') +
-          _effectsToPddl(worldStateModificationWithPartInfos, subSubIdentation);
+      pOutput << subSubIdentationStr << _effectsToPddl(worldStateModificationWithPartInfos, subSubIdentation);
     }
 
-
-    res += actionContent;
-    res += "\n" + std::string(identation, ' ') + ")\n\n";
+    pOutput << "\n" << identationStr << ")\n\n";
   }
 
-  return res + ")";
+  pOutput << ")";
 }
 
 
-std::string problemToPddl(const Problem& pProblem,
-                          const Domain& pDomain)
+std::string domainToPddl(const Domain& pDomain)
 {
-  std::string res = "(define\n";
+  std::ostringstream res;
+  domainToPddl(res, pDomain);
+  return res.str();
+}
+
+
+void problemToPddl(std::ostream& pOutput,
+                   const Problem& pProblem,
+                   const Domain& pDomain)
+{
+  pOutput << "(define\n";
   std::size_t identation = _identationOffset;
+  const std::string identationStr(identation, ' ');
 
-  res += std::string(identation, ' ') + "(problem " + pProblem.name + ")\n";
-  res += std::string(identation, ' ') + "(:domain " + pDomain.getName() + ")\n\n";
+  pOutput << identationStr << "(problem " << pProblem.name << ")\n";
+  pOutput << identationStr << "(:domain " << pDomain.getName() << ")\n\n";
 
   if (!pProblem.entities.empty())
   {
-    res += std::string(identation, ' ') + "(:objects\n";
-    res += pProblem.entities.toStr(_identationOffset + identation);
-    res += "\n" + std::string(identation, ' ') + ")\n\n";
+    pOutput << identationStr << "(:objects\n";
+    pOutput << pProblem.entities.toStr(_identationOffset + identation);
+    pOutput << "\n" << identationStr << ")\n\n";
   }
 
   const SetOfFacts& facts = pProblem.worldState.factsMapping();
   if (!facts.empty())
   {
-    res += std::string(identation, ' ') + "(:init\n";
-    res += facts.toPddl(_identationOffset + identation, false);
-    res += "\n" + std::string(identation, ' ') + ")\n\n";
+    pOutput << identationStr << "(:init\n";
+    facts.toPddl(pOutput, _identationOffset + identation, false);
+    pOutput << "\n" << identationStr << ")\n\n";
   }
 
 
   std::list<std::string> pddlGoals;
   std::size_t subIdentation = identation + _identationOffset;
   std::size_t subSubIdentation = subIdentation + _identationOffset;
+  const std::string subIdentationStr(subIdentation, ' ');
+  const std::string subSubIdentationStr(subSubIdentation, ' ');
 
   const auto& goals = pProblem.goalStack.goals();
   if (!goals.empty())
   {
-    res += std::string(identation, ' ') + "(:goal\n";
+    pOutput << identationStr << "(:goal\n";
     if (goals.size() == 1 && goals.begin()->second.size() == 1)
     {
       const auto& currGoal = goals.begin()->second.front();
       auto pddlGoal = currGoal.toPddl(subSubIdentation);
-      res += std::string(subSubIdentation, ' ') + pddlGoal + "\n";
+      pOutput << subSubIdentationStr << pddlGoal << "\n";
       pddlGoals.emplace_back(pddlGoal);
     }
     else
     {
-      res += std::string(subIdentation, ' ') + "(and ;; __ORDERED\n";
+      pOutput << subIdentationStr << "(and ;; __ORDERED\n";
       for (auto itGoalsGroup = goals.end(); itGoalsGroup != goals.begin(); )
       {
         --itGoalsGroup;
         for (const Goal& currGoal : itGoalsGroup->second)
         {
           auto pddlGoal = currGoal.toPddl(subSubIdentation);
-          res += std::string(subSubIdentation, ' ') + pddlGoal + "\n";
+          pOutput << subSubIdentationStr << pddlGoal << "\n";
           pddlGoals.emplace_back(pddlGoal);
         }
       }
-      res += std::string(subIdentation, ' ') + ")\n";
+      pOutput << subIdentationStr << ")\n";
     }
-    res += std::string(identation, ' ') + ")\n\n";
+    pOutput << identationStr << ")\n\n";
   }
 
   if (pddlGoals.size() > 1)
   {
-    std::size_t subSubSubIdentation = subSubIdentation + _identationOffset;
-    res += std::string(identation, ' ') + "(:constraints\n";
-    res += std::string(subIdentation, ' ') + "(and ; These contraints are to specify the goals order\n";
+    const std::string subSubSubIdentationStr(subSubIdentation + _identationOffset, ' ');
+    pOutput << identationStr << "(:constraints\n";
+    pOutput << subIdentationStr << "(and ; These contraints are to specify the goals order\n";
 
     std::size_t preferenceIndex = 0;
     std::string previousGoal;
@@ -485,20 +495,28 @@ std::string problemToPddl(const Problem& pProblem,
     {
       if (previousGoal != "")
       {
-        res += std::string(subSubIdentation, ' ') + "(preference p" + std::to_string(preferenceIndex) + "\n";
+        pOutput << subSubIdentationStr << "(preference p" << preferenceIndex << "\n";
         ++preferenceIndex;
-        res += std::string(subSubSubIdentation, ' ') + "(sometime-after " +
-            previousGoal + " " + currPddlGoal + ")\n";
-        res += std::string(subSubIdentation, ' ') + ")\n";
+        pOutput << subSubSubIdentationStr << "(sometime-after " << previousGoal << " " << currPddlGoal << ")\n";
+        pOutput << subSubIdentationStr << ")\n";
       }
       previousGoal = currPddlGoal;
     }
 
-    res += std::string(subIdentation, ' ') + ")\n";
-    res += std::string(identation, ' ') + ")\n\n";
+    pOutput << subIdentationStr << ")\n";
+    pOutput << identationStr << ")\n\n";
   }
 
-  return res + ")";
+  pOutput << ")";
+}
+
+
+std::string problemToPddl(const Problem& pProblem,
+                          const Domain& pDomain)
+{
+  std::ostringstream res;
+  problemToPddl(res, pProblem, pDomain);
+  return res.str();
 }
 
 
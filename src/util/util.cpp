@@ -1,6 +1,9 @@
 #include <orderedgoalsplanner/util/util.hpp>
 #include <cctype> // For isdigit()
+#include <charconv>
+#include <locale>
 #include <sstream>
+#include <type_traits>
 #include <orderedgoalsplanner/types/entity.hpp>
 #include <orderedgoalsplanner/types/parameter.hpp>
 
@@ -64,7 +67,25 @@ void _unfoldMapWithSet(std::list<std::map<Parameter, Entity>>& pOutMap,
 
 // Function to convert a string to either an int or a float and store it in a variant
 Number stringToNumber(const std::string& str) {
+    // Fast path for the plain decimal numbers, that are the numbers written by numberToString.
+    // std::from_chars does not depend on the locale, so a decimal point is always expected.
+    if (isNumber(str)) {
+        const char* begin = str.data();
+        const char* end = begin + str.size();
+        if (*begin == '+')
+            ++begin;
+        int intValue = 0;
+        auto intRes = std::from_chars(begin, end, intValue);
+        if (intRes.ec == std::errc() && intRes.ptr == end)
+            return intValue;
+        float floatValue = 0;
+        auto floatRes = std::from_chars(begin, end, floatValue);
+        if (floatRes.ec == std::errc() && floatRes.ptr == end)
+            return floatValue;
+    }
+
     std::istringstream iss(str);
+    iss.imbue(std::locale::classic());
 
     // Try to parse as an int first
     int intValue;
@@ -115,9 +136,16 @@ bool operator==(const Number& lhs, const Number& rhs) {
 
 // Function to convert a Number to a std::string
 std::string numberToString(const Number& num) {
-    return std::visit([](auto&& value) -> std::string {
-        return std::to_string(value);
+    // std::to_chars does not depend on the locale and does not allocate, contrary to std::to_string.
+    // The floats keep the format of std::to_string: fixed with 6 decimals.
+    char buffer[64];
+    auto res = std::visit([&](auto&& value) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(value)>, float>)
+            return std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, 6);
+        else
+            return std::to_chars(buffer, buffer + sizeof(buffer), value);
     }, num);
+    return std::string(buffer, res.ptr);
 }
 
 
@@ -171,6 +199,8 @@ std::optional<Entity> plusIntOrStr(const std::optional<Entity>& pNb1,
 {
   if (!pNb1 || !pNb2 || pNb1->type != pNb2->type)
     return {};
+  if (pNb1->number && pNb2->number)
+    return Entity::createNumberEntity(*pNb1->number + *pNb2->number);
   try
   {
     auto nb1 = stringToNumber(pNb1->value);
@@ -186,6 +216,8 @@ std::optional<Entity> minusIntOrStr(const std::optional<Entity>& pNb1,
 {
   if (!pNb1 || !pNb2 || pNb1->type != pNb2->type)
     return {};
+  if (pNb1->number && pNb2->number)
+    return Entity::createNumberEntity(*pNb1->number - *pNb2->number);
   try
   {
     auto nb1 = stringToNumber(pNb1->value);
@@ -201,6 +233,8 @@ std::optional<Entity> multiplyNbOrStr(const std::optional<Entity>& pNb1,
 {
   if (!pNb1 || !pNb2 || pNb1->type != pNb2->type)
     return {};
+  if (pNb1->number && pNb2->number)
+    return Entity::createNumberEntity(*pNb1->number * *pNb2->number);
   try
   {
     auto nb1 = stringToNumber(pNb1->value);
@@ -230,6 +264,21 @@ bool compIntNb(
   return false;
 }
 
+bool compIntNb(
+    const Entity& pNb1,
+    const Number& pNb2,
+    bool pBoolSuperiorOrInferior,
+    bool pCanBeEqual)
+{
+  if (!pNb1.number)
+    return compIntNb(pNb1.value, pNb2, pBoolSuperiorOrInferior, pCanBeEqual);
+  if (*pNb1.number == pNb2)
+    return pCanBeEqual;
+  if (pBoolSuperiorOrInferior)
+    return *pNb1.number > pNb2;
+  return *pNb1.number < pNb2;
+}
+
 std::string incrementLastNumberUntilAConditionIsSatisfied(
     const std::string& pStr,
     const std::function<bool(const std::string&)>& pCondition)
@@ -110,6 +110,15 @@ TEST(Tool, test_goalsCache)
               "actions: action2", problem.goalStack.printGoalsCache());
     EXPECT_EQ("action2, action3", _actionIdsToStr(problem.goalStack.getActionsPredecessors()));
     EXPECT_EQ("", _actionIdsToStr(problem.goalStack.getEventsPredecessors()));
+
+    const auto& goal = problem.goalStack.goals().begin()->second.front();
+    const auto& domainActions = domain.actions();
+    EXPECT_FALSE(goal.isActionPredecessor(domainActions.at(action1).indexInDomainCache));
+    EXPECT_TRUE(goal.isActionPredecessor(domainActions.at(action2).indexInDomainCache));
+    EXPECT_TRUE(goal.isActionPredecessor(domainActions.at(action3).indexInDomainCache));
+    EXPECT_FALSE(goal.isActionPredecessor(domainActions.at(action4).indexInDomainCache));
+    for (const auto& currEvent : domain.getSetOfEvents().begin()->second.events())
+      EXPECT_FALSE(goal.isEventPredecessor(currEvent.second.indexInDomainCache));
   }
 
   {
@@ -120,6 +129,12 @@ TEST(Tool, test_goalsCache)
               "events: soe_from_constructor|event", problem.goalStack.printGoalsCache());
     EXPECT_EQ("action2, action3, action4", _actionIdsToStr(problem.goalStack.getActionsPredecessors()));
     EXPECT_EQ("soe_from_constructor|event, soe_from_constructor|event_2", _actionIdsToStr(problem.goalStack.getEventsPredecessors()));
+
+    const auto& goal = problem.goalStack.goals().begin()->second.front();
+    EXPECT_FALSE(goal.isActionPredecessor(domain.actions().at(action1).indexInDomainCache));
+    EXPECT_TRUE(goal.isActionPredecessor(domain.actions().at(action4).indexInDomainCache));
+    for (const auto& currEvent : domain.getSetOfEvents().begin()->second.events())
+      EXPECT_TRUE(goal.isEventPredecessor(currEvent.second.indexInDomainCache));
   }
 
   {
@@ -53,6 +53,36 @@ void _test_setOfTypes_fromStr()
 }
 
 
+void _test_typeIsA()
+{
+  auto setOfTypes = ogp::SetOfTypes::fromPddl("voiture maison - object\n"
+                                              "citroen ferrari - voiture\n"
+                                              "c3 - citroen\n"
+                                              "location");
+  auto c3 = setOfTypes.nameToType("c3");
+  EXPECT_TRUE(c3->isA(*c3));
+  EXPECT_TRUE(c3->isA(*setOfTypes.nameToType("citroen")));
+  EXPECT_TRUE(c3->isA(*setOfTypes.nameToType("voiture")));
+  EXPECT_TRUE(c3->isA(*setOfTypes.nameToType("object")));
+  EXPECT_FALSE(c3->isA(*setOfTypes.nameToType("ferrari")));
+  EXPECT_FALSE(c3->isA(*setOfTypes.nameToType("maison")));
+  EXPECT_FALSE(c3->isA(*setOfTypes.nameToType("location")));
+  EXPECT_FALSE(setOfTypes.nameToType("voiture")->isA(*c3));
+  EXPECT_FALSE(setOfTypes.nameToType("location")->isA(*setOfTypes.nameToType("object")));
+
+  // A type added later is numbered too
+  setOfTypes.addType("ds3", "citroen");
+  EXPECT_TRUE(setOfTypes.nameToType("ds3")->isA(*setOfTypes.nameToType("voiture")));
+  EXPECT_FALSE(setOfTypes.nameToType("ds3")->isA(*c3));
+  EXPECT_TRUE(c3->isA(*setOfTypes.nameToType("object")));
+
+  // Types of another set of types are compared by names
+  auto otherSetOfTypes = ogp::SetOfTypes::fromPddl("voiture - object");
+  EXPECT_TRUE(c3->isA(*otherSetOfTypes.nameToType("voiture")));
+  EXPECT_FALSE(otherSetOfTypes.nameToType("voiture")->isA(*c3));
+}
+
+
 void _test_predicateToStr()
 {
   auto setOfTypes = ogp::SetOfTypes::fromPddl("my_type my_type2 return_type");
@@ -96,6 +126,110 @@ void _test_setOfEntities_fromStr()
   EXPECT_EQ("my_type2", setOfEntities.valueToEntity("titi")->type->name);
 }
 
+
+std::string _entitiesToStr(const std::vector<ogp::Entity>* pEntitiesPtr)
+{
+  if (pEntitiesPtr == nullptr)
+    return "null";
+  std::string res;
+  for (const auto& currEntity : *pEntitiesPtr)
+  {
+    if (!res.empty())
+      res += " ";
+    res += currEntity.value;
+  }
+  return res;
+}
+
+void _test_setOfEntities_withSubTypes()
+{
+  auto setOfTypes = ogp::SetOfTypes::fromPddl("voiture maison - object\n"
+                                              "citroen ferrari - voiture\n"
+                                              "location");
+  auto setOfEntities = ogp::SetOfEntities::fromPddl("v2 v1 - voiture\n"
+                                                   "c1 - citroen\n"
+                                                   "f1 - ferrari\n"
+                                                   "m1 - maison", setOfTypes);
+  EXPECT_EQ("c1 f1 m1 v1 v2", _entitiesToStr(setOfEntities.typeNameToEntitiesWithSubTypes("object")));
+  EXPECT_EQ("c1 f1 v1 v2", _entitiesToStr(setOfEntities.typeNameToEntitiesWithSubTypes("voiture")));
+  EXPECT_EQ("c1", _entitiesToStr(setOfEntities.typeNameToEntitiesWithSubTypes("citroen")));
+  EXPECT_EQ("null", _entitiesToStr(setOfEntities.typeNameToEntitiesWithSubTypes("location")));
+  EXPECT_EQ(2u, setOfEntities.typeNameToEntities("voiture")->size());
+
+  // Redeclaring an entity with another type moves it in the tables
+  setOfEntities.add(ogp::Entity("v1", setOfTypes.nameToType("maison")));
+  EXPECT_EQ("c1 f1 v2", _entitiesToStr(setOfEntities.typeNameToEntitiesWithSubTypes("voiture")));
+  EXPECT_EQ("m1 v1", _entitiesToStr(setOfEntities.typeNameToEntitiesWithSubTypes("maison")));
+  EXPECT_EQ("c1 f1 m1 v1 v2", _entitiesToStr(setOfEntities.typeNameToEntitiesWithSubTypes("object")));
+  EXPECT_EQ(1u, setOfEntities.typeNameToEntities("voiture")->size());
+}
+
+std::set<ogp::FactSignatureId> _signatureIdsForAllUpperTypes(const ogp::Fact& pFact)
+{
+  std::vector<ogp::FactSignatureId> signatureIds;
+  pFact.signatureIdsForAllUpperTypes(signatureIds);
+  return std::set<ogp::FactSignatureId>(signatureIds.begin(), signatureIds.end());
+}
+
+std::set<ogp::FactSignatureId> _signatureIdsForSubAndUpperTypes(const ogp::Fact& pFact)
+{
+  std::vector<ogp::FactSignatureId> signatureIds;
+  pFact.signatureIdsForSubAndUpperTypes(signatureIds);
+  EXPECT_EQ(std::set<ogp::FactSignatureId>(signatureIds.begin(), signatureIds.end()).size(), signatureIds.size());
+  return std::set<ogp::FactSignatureId>(signatureIds.begin(), signatureIds.end());
+}
+
+void _test_factSignatureIds()
+{
+  ogp::Ontology ontology;
+  ontology.types = ogp::SetOfTypes::fromPddl("voiture maison - object\n"
+                                             "citroen ferrari - voiture");
+  ontology.constants = ogp::SetOfEntities::fromPddl("v1 - voiture\n"
+                                                    "c1 - citroen\n"
+                                                    "f1 - ferrari\n"
+                                                    "m1 - maison", ontology.types);
+  ontology.predicates = ogp::SetOfPredicates::fromStr("pred_a(?v - voiture)\n"
+                                                      "pred_b(?o - object, ?m - maison)", ontology.types);
+  const std::vector<ogp::Parameter> parameters{ogp::Parameter::fromStr("?v - voiture", ontology.types)};
+
+  const ogp::Fact factWithCitroen("pred_a(c1)", false, ontology, {}, {});
+  const ogp::Fact factWithFerrari("pred_a(f1)", false, ontology, {}, {});
+  const ogp::Fact factWithVoiture("pred_a(v1)", false, ontology, {}, {});
+  const ogp::Fact factWithParameter("pred_a(?v)", false, ontology, {}, parameters);
+  EXPECT_NE(0u, factWithCitroen.signatureId().id);
+  EXPECT_EQ(factWithVoiture.signatureId(), factWithParameter.signatureId());
+  EXPECT_NE(factWithCitroen.signatureId(), factWithFerrari.signatureId());
+
+  // The upper types of citroen are voiture and object
+  auto upperTypes = _signatureIdsForAllUpperTypes(factWithCitroen);
+  EXPECT_EQ(3u, upperTypes.size());
+  EXPECT_EQ(1u, upperTypes.count(factWithVoiture.signatureId()));
+  EXPECT_EQ(0u, upperTypes.count(factWithFerrari.signatureId()));
+
+  // A parameter matches the facts of its sub types
+  auto subAndUpperTypes = _signatureIdsForSubAndUpperTypes(factWithParameter);
+  EXPECT_EQ(4u, subAndUpperTypes.size());
+  EXPECT_EQ(1u, subAndUpperTypes.count(factWithCitroen.signatureId()));
+  EXPECT_EQ(1u, subAndUpperTypes.count(factWithFerrari.signatureId()));
+  // A constant only matches the facts of its upper types
+  EXPECT_EQ(2u, _signatureIdsForSubAndUpperTypes(ogp::Fact("pred_a(v1)", false, ontology, {}, {})).size());
+
+  // The combinations of sub types of several parameters are identified once
+  const std::vector<ogp::Parameter> parameters2{ogp::Parameter::fromStr("?o - object", ontology.types),
+                                                ogp::Parameter::fromStr("?m - maison", ontology.types)};
+  const ogp::Fact factWithTwoParameters("pred_b(?o, ?m)", false, ontology, {}, parameters2);
+  EXPECT_EQ(6u, _signatureIdsForSubAndUpperTypes(factWithTwoParameters).size());
+  EXPECT_EQ(1u, _signatureIdsForSubAndUpperTypes(factWithTwoParameters).count(ogp::Fact("pred_b(c1, m1)", false, ontology, {}, {}).signatureId()));
+
+  // A type added after the predicates is identified by its signature string
+  ontology.types.addType("ds3", "citroen");
+  ontology.constants.add(ogp::Entity("d1", ontology.types.nameToType("ds3")));
+  const ogp::Fact factWithDs3("pred_a(d1)", false, ontology, {}, {});
+  EXPECT_EQ(0u, factWithDs3.signatureId().id);
+  EXPECT_EQ("pred_a(ds3)", factWithDs3.signatureId().signature);
+  EXPECT_EQ(4u, _signatureIdsForAllUpperTypes(factWithDs3).size());
+}
+
 void _test_fact_initialization()
 {
   ogp::Ontology ontology;
@@ -171,6 +305,35 @@ void _test_fact_initialization()
   catch(const std::exception& e) {
     EXPECT_EQ("\"unknown_val\" is not an entity value. The exception was thrown while parsing fact: \"pred_name2(toto, titi)=unknown_val\"", std::string(e.what()));
   }
+
+  // Pddl format
+  EXPECT_EQ(ogp::Fact("pred_name(toto)", false, ontology, {}, {}),
+            ogp::Fact("( pred_name  toto )", true, ontology, {}, {}));
+  EXPECT_EQ(ogp::Fact("pred_name2(toto, titi)=res", false, ontology, {}, {}),
+            ogp::Fact("(= (pred_name2 toto titi) res)", true, ontology, {}, {}));
+  {
+    bool isFactNegated = false;
+    std::size_t resPos = 0;
+    const std::string factStr = "(not (pred_name toto)) ; comment\n (pred_name sub_toto)";
+    ogp::Fact fact(factStr, true, ontology, {}, {}, &isFactNegated, 0, &resPos);
+    EXPECT_EQ("pred_name(toto)", fact.toStr());
+    EXPECT_TRUE(isFactNegated);
+    EXPECT_EQ("(pred_name sub_toto)", factStr.substr(resPos));
+  }
+  {
+    bool isFactNegated = false;
+    ogp::Fact fact("(= (pred_name2 toto titi) undefined)", true, ontology, {}, {}, &isFactNegated);
+    EXPECT_TRUE(isFactNegated);
+    EXPECT_EQ("pred_name2(toto, titi)=*", fact.toStr());
+  }
+  try
+  {
+    ogp::Fact("(pred_name titi)", true, ontology, {}, {});
+    EXPECT_TRUE(false);
+  }
+  catch(const std::exception& e) {
+    EXPECT_EQ("\"titi - my_type2\" is not a \"my_type\" for predicate: \"pred_name(?v - my_type)\". The exception was thrown while parsing fact: \"(pred_name titi)\"", std::string(e.what()));
+  }
 }
 
 
@@ -286,9 +449,12 @@ TEST(Tool, test_ontology)
 {
   _test_setOfTypes();
   _test_setOfTypes_fromStr();
+  _test_typeIsA();
   _test_predicateToStr();
   _test_setOfPredicates_fromStr();
   _test_setOfEntities_fromStr();
+  _test_setOfEntities_withSubTypes();
+  _test_factSignatureIds();
   _test_fact_initialization();
   _test_action_initialization();
   _test_checkConditionWithOntology();
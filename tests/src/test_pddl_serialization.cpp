@@ -1,3 +1,6 @@
+#include <cstdio>
+#include <list>
+#include <sstream>
 #include <gtest/gtest.h>
 #include <orderedgoalsplanner/types/domain.hpp>
 #include <orderedgoalsplanner/types/problem.hpp>
@@ -6,8 +9,10 @@
 #include <orderedgoalsplanner/types/setofentities.hpp>
 #include <orderedgoalsplanner/types/setofpredicates.hpp>
 #include <orderedgoalsplanner/types/worldstatemodification.hpp>
+#include <orderedgoalsplanner/util/serializer/binarysnapshot.hpp>
 #include <orderedgoalsplanner/util/serializer/deserializefrompddl.hpp>
 #include <orderedgoalsplanner/util/serializer/serializeinpddl.hpp>
+#include <orderedgoalsplanner/util/util.hpp>
 
 namespace
 {
@@ -93,6 +98,142 @@ void _test_pddlSerializationParts()
 }
 
 
+void _test_binarySnapshot(const ogp::Domain& pDomain,
+                          const ogp::Problem& pProblem,
+                          const std::string& pExpectedDomainPddl,
+                          const std::string& pExpectedProblemPddl)
+{
+  auto domainSnapshot = ogp::domainToSnapshot(pDomain);
+  auto domain = ogp::snapshotToDomain(domainSnapshot);
+  EXPECT_EQ(pExpectedDomainPddl, ogp::domainToPddl(domain));
+  EXPECT_EQ(pDomain.printSuccessionCache(), domain.printSuccessionCache());
+
+  // The caches and the indexes are loaded as they were saved
+  // (the facts are looked up in the domain they belong to because their signatures depend on the types of the domain)
+  auto actionsOfPreconditions = [](const ogp::Domain& pDomainToCheck, const ogp::Action& pAction) {
+    std::list<std::string> res;
+    if (pAction.precondition)
+      pAction.precondition->forAll([&](const ogp::FactOptional& pFactOptional, bool pIgnoreFluent) {
+        res.emplace_back(pDomainToCheck.preconditionToActions().find(pFactOptional.fact, pIgnoreFluent).toStr());
+        return ogp::ContinueOrBreak::CONTINUE;
+      });
+    return res;
+  };
+  const auto& actions = domain.actions();
+  ASSERT_EQ(pDomain.actions().size(), actions.size());
+  for (const auto& currAction : pDomain.actions())
+  {
+    const auto& action = actions.at(currAction.first);
+    EXPECT_EQ(currAction.second.actionsPredecessorsCache, action.actionsPredecessorsCache);
+    EXPECT_EQ(currAction.second.eventsPredecessorsCache, action.eventsPredecessorsCache);
+    EXPECT_EQ(currAction.second.actionsSuccessionsWithoutInterestCache, action.actionsSuccessionsWithoutInterestCache);
+    EXPECT_EQ(actionsOfPreconditions(pDomain, currAction.second), actionsOfPreconditions(domain, action));
+  }
+  EXPECT_EQ(pDomain.actionsWithoutFactToAddInPrecondition().valuesWithoutFact().toStr(),
+            domain.actionsWithoutFactToAddInPrecondition().valuesWithoutFact().toStr());
+
+  auto problemSnapshot = ogp::problemToSnapshot(pProblem, pDomain);
+  auto problemPtr = ogp::snapshotToProblem(problemSnapshot, domain);
+  EXPECT_EQ(pExpectedProblemPddl, ogp::problemToPddl(*problemPtr, domain));
+
+  // Files
+  const std::string domainFilename = ::testing::TempDir() + "ogp_domain_snapshot.bin";
+  const std::string problemFilename = ::testing::TempDir() + "ogp_problem_snapshot.bin";
+  ogp::saveDomainSnapshot(pDomain, domainFilename);
+  ogp::saveProblemSnapshot(pProblem, pDomain, problemFilename);
+  auto domainFromFile = ogp::loadDomainSnapshot(domainFilename);
+  EXPECT_EQ(pExpectedDomainPddl, ogp::domainToPddl(domainFromFile));
+  EXPECT_EQ(pExpectedProblemPddl, ogp::problemToPddl(*ogp::loadProblemSnapshot(problemFilename, domainFromFile), domainFromFile));
+  std::remove(domainFilename.c_str());
+  std::remove(problemFilename.c_str());
+
+  // Invalid snapshots
+  EXPECT_ANY_THROW(ogp::snapshotToProblem(domainSnapshot, domain));
+  EXPECT_ANY_THROW(ogp::snapshotToDomain(domainSnapshot.substr(0, domainSnapshot.size() - 1)));
+  auto snapshotOfAnotherVersion = domainSnapshot;
+  snapshotOfAnotherVersion[4] = static_cast<char>(ogp::binarySnapshotVersion + 1);
+  EXPECT_ANY_THROW(ogp::snapshotToDomain(snapshotOfAnotherVersion));
+  // A number of symbols bigger than the data is refused before reserving the memory
+  auto snapshotWithTooManySymbols = domainSnapshot.substr(0, 9) + std::string(4, static_cast<char>(0xFF));
+  EXPECT_THROW(ogp::snapshotToDomain(snapshotWithTooManySymbols), std::runtime_error);
+}
+
+
+void _test_problemFromStream(const std::string& pProblemPddl,
+                             const std::map<std::string, ogp::Domain>& pLoadedDomains,
+                             const std::string& pExpectedProblemPddl)
+{
+  std::istringstream problemStream(pProblemPddl);
+  auto domainAndProblemPtrs = ogp::pddlToProblem(problemStream, pLoadedDomains);
+  EXPECT_EQ(pExpectedProblemPddl, ogp::problemToPddl(*domainAndProblemPtrs.problemPtr,
+                                                     *domainAndProblemPtrs.domainPtr));
+
+  // A fact negated in the init section removes the fact added before
+  std::istringstream problemWithANegatedFactStream(R"((define (problem p) (:domain construction)
+    (:objects
+      s1 - site
+      b - bricks
+    ) ; objects
+    (:init (on-site b s1) ; (ignored (fact))
+           (= (position) s1) (not (on-site b s1)))))");
+  auto domainAndProblemPtrs2 = ogp::pddlToProblem(problemWithANegatedFactStream, pLoadedDomains);
+  const auto& facts = domainAndProblemPtrs2.problemPtr->worldState.facts();
+  std::set<std::string> factStrs;
+  for (const auto& currFact : facts)
+    factStrs.insert(currFact.first.toStr());
+  EXPECT_EQ(std::set<std::string>({"foundations-set(mainsite)", "position=s1"}), factStrs);
+}
+
+
+void _test_problemWithManyInitFacts(const std::map<std::string, ogp::Domain>& pLoadedDomains)
+{
+  // 4 threads, even on a machine with less cores, to really parse the facts in parallel
+  ogp::setMaxNbOfThreads(4);
+  auto problemPddl = [](std::size_t pNbOfFacts, const std::set<std::size_t>& pInvalidFactIndexes)
+  {
+    std::string res = "(define (problem p) (:domain construction)\n(:objects\ns1 - site\n";
+    for (std::size_t i = 0; i < pNbOfFacts; ++i)
+      res += "b" + std::to_string(i) + " ";
+    res += "- bricks)\n(:init\n";
+    for (std::size_t i = 0; i < pNbOfFacts; ++i)
+    {
+      if (pInvalidFactIndexes.count(i) > 0)
+        res += "(unknown-predicate-" + std::to_string(i) + " s1)\n";
+      else
+        res += "(on-site b" + std::to_string(i) + " s1)\n";
+    }
+    return res + "))";
+  };
+
+  // More facts than the number of facts parsed at once
+  const std::size_t nbOfFacts = 9000;
+  std::istringstream problemStream(problemPddl(nbOfFacts, {}));
+  auto domainAndProblemPtrs = ogp::pddlToProblem(problemStream, pLoadedDomains);
+  const auto& facts = domainAndProblemPtrs.problemPtr->worldState.facts();
+  std::set<std::string> onSiteFactStrs;
+  for (const auto& currFact : facts)
+    if (currFact.first.name() == "on-site")
+      onSiteFactStrs.insert(currFact.first.toStr());
+  EXPECT_EQ(nbOfFacts, onSiteFactStrs.size());
+  EXPECT_EQ(1u, onSiteFactStrs.count("on-site(b" + std::to_string(nbOfFacts - 1) + ", s1)"));
+
+  // The error is about the first invalid fact of the file, as if the facts were parsed one by one
+  std::istringstream invalidProblemStream(problemPddl(64, {10, 30, 50}));
+  std::string error;
+  try
+  {
+    ogp::pddlToProblem(invalidProblemStream, pLoadedDomains);
+  }
+  catch (const std::exception& e)
+  {
+    error = e.what();
+  }
+  EXPECT_NE(std::string::npos, error.find("unknown-predicate-10")) << error;
+  EXPECT_EQ(std::string::npos, error.find("unknown-predicate-30")) << error;
+  ogp::setMaxNbOfThreads(0);
+}
+
+
 void _test_loadPddlDomain()
 {
   std::map<std::string, ogp::Domain> loadedDomains;
@@ -495,6 +636,18 @@ void _test_loadPddlDomain()
     std::cout << outProblemPddl2 << std::endl;
     ASSERT_TRUE(false);
   }
+
+  _test_binarySnapshot(*outDomainAndProblemPtrs2.domainPtr, *outDomainAndProblemPtrs2.problemPtr,
+                       expectedDomain, expectedProblem);
+  _test_problemFromStream(outProblemPddl1, loadedDomains2, expectedProblem);
+  _test_problemWithManyInitFacts(loadedDomains2);
+
+  std::ostringstream domainStream;
+  ogp::domainToPddl(domainStream, domain2);
+  EXPECT_EQ(expectedDomain, domainStream.str());
+  std::ostringstream problemStream;
+  ogp::problemToPddl(problemStream, *outDomainAndProblemPtrs2.problemPtr, *outDomainAndProblemPtrs2.domainPtr);
+  EXPECT_EQ(expectedProblem, problemStream.str());
 }
 
 }
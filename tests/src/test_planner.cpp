@@ -1,5 +1,7 @@
+#include <thread>
 #include <gtest/gtest.h>
 #include <orderedgoalsplanner/orderedgoalsplanner.hpp>
+#include <orderedgoalsplanner/plannersession.hpp>
 #include <orderedgoalsplanner/types/predicate.hpp>
 #include <orderedgoalsplanner/types/setofcallbacks.hpp>
 #include <orderedgoalsplanner/types/setofconstfacts.hpp>
@@ -669,6 +671,489 @@ void _disjunctivePrecondition()
 }
 
 
+
+void _planBatch()
+{
+  ogp::Ontology ontology;
+  ontology.types = ogp::SetOfTypes::fromPddl("location");
+  ontology.constants = ogp::SetOfEntities::fromPddl("kitchen bedroom garden - location", ontology.types);
+  ontology.predicates = ogp::SetOfPredicates::fromStr("at(?l - location)", ontology.types);
+
+  std::map<std::string, ogp::Action> actions;
+  std::vector<ogp::Parameter> actionParameters{ogp::Parameter::fromStr("?from - location", ontology.types),
+                                               ogp::Parameter::fromStr("?to - location", ontology.types)};
+  ogp::Action moveObj(ogp::strToCondition("at(?from)", ontology, {}, actionParameters),
+                      ogp::strToWsModification("!at(?from) & at(?to)", ontology, {}, actionParameters));
+  moveObj.parameters = std::move(actionParameters);
+  actions.emplace("move", moveObj);
+  const ogp::Domain domain(std::move(actions), ontology);
+  auto& setOfEventsMap = domain.getSetOfEvents();
+
+  const std::vector<std::pair<std::string, std::string>> fromAndToLocations{
+    {"kitchen", "bedroom"}, {"bedroom", "garden"}, {"garden", "kitchen"}, {"kitchen", "garden"}, {"garden", "garden"}};
+  std::vector<ogp::Problem> problems;
+  for (const auto& currFromAndTo : fromAndToLocations)
+  {
+    ogp::Problem problem;
+    auto& entities = problem.entities;
+    problem.worldState.addFact(ogp::Fact("at(" + currFromAndTo.first + ")", false, ontology, entities, {}), problem.goalStack, setOfEventsMap,
+                               _emptyCallbacks, ontology, entities, _now);
+    _setGoalsForAPriority(problem, {ogp::Goal::fromStr("at(" + currFromAndTo.second + ")", ontology, entities)});
+    problems.emplace_back(std::move(problem));
+  }
+
+  ogp::PlanBatchOptions options;
+  options.maxNbOfThreads = 3;
+  auto batchResult = ogp::planBatch(domain, problems, options);
+  ASSERT_EQ(fromAndToLocations.size(), batchResult.problemResults.size());
+  for (std::size_t i = 0; i < fromAndToLocations.size(); ++i)
+  {
+    const auto& problemResult = batchResult.problemResults[i];
+    EXPECT_EQ("", problemResult.errorMessage);
+    const auto& currFromAndTo = fromAndToLocations[i];
+    if (currFromAndTo.first == currFromAndTo.second)
+      EXPECT_EQ("", ogp::planToStr(problemResult.plan));
+    else
+      EXPECT_EQ("move(?from -> " + currFromAndTo.first + ", ?to -> " + currFromAndTo.second + ")", ogp::planToStr(problemResult.plan));
+    EXPECT_TRUE(problemResult.duration <= batchResult.duration);
+  }
+  EXPECT_LT(0, batchResult.throughput());
+}
+
+
+void _planWithASubTypeEntity()
+{
+  std::map<std::string, ogp::Domain> loadedDomains;
+  const auto domain = ogp::pddlToDomain(R"((define
+    (domain charging)
+    (:requirements :strips :typing)
+    (:types
+        charger - object
+        fast_charger - charger
+    )
+    (:predicates
+        (plugged ?c - charger)
+        (free ?c - charger)
+    )
+
+    (:action plug
+        :parameters (?c - charger)
+        :precondition (free ?c)
+        :effect (and (not (free ?c)) (plugged ?c))
+    )
+))", loadedDomains);
+  loadedDomains.emplace(domain.getName(), domain);
+
+  // The only free charger is of a sub type of the parameter type
+  auto domainAndProblem = ogp::pddlToProblem(R"((define
+    (problem charge)
+    (:domain charging)
+    (:objects
+        c1 - charger
+        fc1 - fast_charger
+    )
+    (:init
+        (free fc1)
+    )
+    (:goal (exists (?c - charger) (plugged ?c)))
+))", loadedDomains);
+  auto& problem = *domainAndProblem.problemPtr;
+  EXPECT_EQ("plug(?c -> fc1)", ogp::planToStr(ogp::planForEveryGoals(problem, domain, _now)));
+}
+
+
+void _planConcurrentlyWithTheSameDomain()
+{
+  std::map<std::string, ogp::Domain> loadedDomains;
+  const auto domain = ogp::pddlToDomain(R"((define
+    (domain delivery)
+    (:requirements :strips :typing)
+    (:types
+        location robot - object
+        box - object
+    )
+    (:predicates
+        (at ?r - robot ?l - location)
+        (box_at ?b - box ?l - location)
+        (holding ?r - robot ?b - box)
+    )
+
+    (:action move
+        :parameters (?r - robot ?from - location ?to - location)
+        :precondition (at ?r ?from)
+        :effect (and (not (at ?r ?from)) (at ?r ?to))
+    )
+
+    (:action pick
+        :parameters (?r - robot ?b - box ?l - location)
+        :precondition (and (at ?r ?l) (box_at ?b ?l))
+        :effect (and (not (box_at ?b ?l)) (holding ?r ?b))
+    )
+
+    (:action drop
+        :parameters (?r - robot ?b - box ?l - location)
+        :precondition (and (at ?r ?l) (holding ?r ?b))
+        :effect (and (not (holding ?r ?b)) (box_at ?b ?l))
+    )
+))", loadedDomains);
+  loadedDomains.emplace(domain.getName(), domain);
+
+  auto domainAndProblem = ogp::pddlToProblem(R"((define
+    (problem deliver)
+    (:domain delivery)
+    (:objects
+        r1 - robot
+        b1 b2 - box
+        l1 l2 l3 - location
+    )
+    (:init
+        (at r1 l1)
+        (box_at b1 l2)
+        (box_at b2 l3)
+    )
+    (:goal (and (holding r1 b1) (at r1 l3)))
+))", loadedDomains);
+  const auto& problem = *domainAndProblem.problemPtr;
+
+  auto referenceProblem = problem;
+  const auto referencePlan = ogp::planToStr(ogp::planForEveryGoals(referenceProblem, domain, {}));
+  EXPECT_EQ("move(?from -> l1, ?r -> r1, ?to -> l2), pick(?b -> b1, ?l -> l2, ?r -> r1), move(?from -> l2, ?r -> r1, ?to -> l3)", referencePlan);
+
+  // Each thread plans its own copies of the problem with the same const domain
+  const std::size_t nbOfThreads = 4;
+  std::vector<std::string> plans(nbOfThreads * 10);
+  std::vector<std::thread> threads;
+  for (std::size_t threadIndex = 0; threadIndex < nbOfThreads; ++threadIndex)
+    threads.emplace_back([&, threadIndex]()
+    {
+      for (std::size_t i = threadIndex; i < plans.size(); i += nbOfThreads)
+      {
+        auto problemCopy = problem;
+        plans[i] = ogp::planToStr(ogp::planForEveryGoals(problemCopy, domain, {}));
+      }
+    });
+  for (auto& currThread : threads)
+    currThread.join();
+  for (const auto& currPlan : plans)
+    EXPECT_EQ(referencePlan, currPlan);
+}
+
+
+void _historicalSnapshot()
+{
+  ogp::Historical historical;
+  historical.setMutex(std::make_shared<std::mutex>());
+  historical.notifyActionDone("action1");
+  auto snapshot = historical.snapshot();
+  auto historicalCopy = historical;
+  historical.notifyActionDone("action1");
+  historical.notifyActionDone("action2");
+  EXPECT_EQ(2, historical.getNbOfTimeAnActionHasAlreadyBeenDone("action1"));
+  EXPECT_TRUE(historical.hasActionAlreadyBeenDone("action2"));
+  EXPECT_EQ(1, snapshot.getNbOfTimeAnActionHasAlreadyBeenDone("action1"));
+  EXPECT_FALSE(snapshot.hasActionAlreadyBeenDone("action2"));
+  historicalCopy.notifyActionDone("action3");
+  EXPECT_EQ(1, historicalCopy.getNbOfTimeAnActionHasAlreadyBeenDone("action1"));
+  EXPECT_FALSE(historical.hasActionAlreadyBeenDone("action3"));
+
+  // Notify from several threads while the snapshots are read
+  const std::size_t nbOfThreads = 4;
+  const std::size_t nbOfNotificationsPerThread = 100;
+  std::vector<std::thread> threads;
+  for (std::size_t threadIndex = 0; threadIndex < nbOfThreads; ++threadIndex)
+    threads.emplace_back([&]()
+    {
+      for (std::size_t i = 0; i < nbOfNotificationsPerThread; ++i)
+      {
+        auto currSnapshot = historical.snapshot();
+        auto nbOfTimes = currSnapshot.getNbOfTimeAnActionHasAlreadyBeenDone("action4");
+        historical.notifyActionDone("action4");
+        EXPECT_EQ(nbOfTimes, currSnapshot.getNbOfTimeAnActionHasAlreadyBeenDone("action4"));
+      }
+    });
+  for (auto& currThread : threads)
+    currThread.join();
+  EXPECT_EQ(nbOfThreads * nbOfNotificationsPerThread, historical.getNbOfTimeAnActionHasAlreadyBeenDone("action4"));
+}
+
+
+void _planAsync()
+{
+  const std::string action1 = "action1";
+  const std::string action2 = "action2";
+  ogp::Ontology ontology;
+  ontology.predicates = ogp::SetOfPredicates::fromStr("fact_a\n"
+                                                      "fact_b", ontology.types);
+
+  std::map<std::string, ogp::Action> actions;
+  actions.emplace(action1, ogp::Action({}, ogp::strToWsModification("fact_a", ontology, {}, {})));
+  actions.emplace(action2, ogp::Action(ogp::strToCondition("fact_a", ontology, {}, {}),
+                                       ogp::strToWsModification("fact_b", ontology, {}, {})));
+  const ogp::Domain domain(std::move(actions), ontology);
+
+  ogp::Problem problem;
+  auto& entities = problem.entities;
+  _setGoalsForAPriority(problem, {ogp::Goal::fromStr("fact_b", ontology, entities)});
+
+  EXPECT_EQ(action1 + ", " + action2, ogp::planToStr(ogp::planForEveryGoalsAsync(problem, domain, _now).get()));
+
+  // The tasks are run later by the executor, the problem is copied at the submission
+  std::vector<std::function<void()>> tasks;
+  auto executor = [&](std::function<void()> pTask) { tasks.emplace_back(std::move(pTask)); };
+  auto everyGoalsFuture = ogp::planForEveryGoalsAsync(problem, domain, _now, executor);
+  auto moreImportantGoalFuture = ogp::planForMoreImportantGoalPossibleAsync(problem, domain, true, _now, executor);
+  _setGoalsForAPriority(problem, {ogp::Goal::fromStr("fact_a", ontology, entities)});
+  EXPECT_EQ(2u, tasks.size());
+  EXPECT_EQ(std::future_status::timeout, everyGoalsFuture.wait_for(std::chrono::seconds(0)));
+  for (auto& currTask : tasks)
+    currTask();
+  EXPECT_EQ(action1 + ", " + action2, ogp::planToStr(everyGoalsFuture.get()));
+  EXPECT_EQ(action1 + ", " + action2, ogp::planToStr(moreImportantGoalFuture.get()));
+  EXPECT_EQ(action1, ogp::planToStr(ogp::planForEveryGoals(problem, domain, _now)));
+
+  // A stopped planification ends without result
+  _setGoalsForAPriority(problem, {ogp::Goal::fromStr("fact_b", ontology, entities)});
+  auto stopRequested = std::make_shared<std::atomic<bool>>(false);
+  tasks.clear();
+  auto stoppedFuture = ogp::planForEveryGoalsAsync(problem, domain, _now, executor, nullptr, stopRequested);
+  *stopRequested = true;
+  for (auto& currTask : tasks)
+    currTask();
+  EXPECT_THROW(stoppedFuture.get(), std::runtime_error);
+  EXPECT_THROW(ogp::planForMoreImportantGoalPossibleAsync(problem, domain, true, _now, {}, nullptr, stopRequested).get(), std::runtime_error);
+  *stopRequested = false;
+  EXPECT_EQ(action2, ogp::planToStr(ogp::planForEveryGoalsAsync(problem, domain, _now, {}, nullptr, stopRequested).get()));
+}
+
+
+void _planStepByStep()
+{
+  const std::string action1 = "action1";
+  const std::string action2 = "action2";
+  const std::string action3 = "action3";
+  ogp::Ontology ontology;
+  ontology.predicates = ogp::SetOfPredicates::fromStr("fact_a\n"
+                                                      "fact_b\n"
+                                                      "fact_c", ontology.types);
+
+  std::map<std::string, ogp::Action> actions;
+  actions.emplace(action1, ogp::Action({}, ogp::strToWsModification("fact_a", ontology, {}, {})));
+  actions.emplace(action2, ogp::Action(ogp::strToCondition("fact_a", ontology, {}, {}),
+                                       ogp::strToWsModification("fact_b", ontology, {}, {})));
+  actions.emplace(action3, ogp::Action({}, ogp::strToWsModification("fact_c", ontology, {}, {})));
+  const ogp::Domain domain(std::move(actions), ontology);
+
+  ogp::Problem problem;
+  auto& entities = problem.entities;
+  _setGoalsForAPriority(problem, {ogp::Goal::fromStr("fact_b", ontology, entities),
+                                  ogp::Goal::fromStr("fact_c", ontology, entities)});
+  const auto initialProblem = problem;
+  auto problemForFullPlan = problem;
+
+  ogp::PlanStepGenerator planStepGenerator(problem, domain, _now);
+  auto firstStep = planStepGenerator.next();
+  ASSERT_TRUE(firstStep);
+  EXPECT_EQ(action1, firstStep->actionInvocation.toStr());
+  // The problem is updated as soon as a step is returned
+  EXPECT_TRUE(problem.worldState.hasFact(ogp::Fact("fact_a", false, ontology, entities, {})));
+  EXPECT_FALSE(problem.worldState.hasFact(ogp::Fact("fact_c", false, ontology, entities, {})));
+
+  std::list<ogp::ActionInvocationWithGoal> plan{*firstStep};
+  while (auto step = planStepGenerator.next())
+    plan.emplace_back(std::move(*step));
+  EXPECT_FALSE(planStepGenerator.next());
+  EXPECT_EQ(ogp::planToStr(ogp::planForEveryGoals(problemForFullPlan, domain, _now)), ogp::planToStr(plan));
+  EXPECT_EQ(action1 + ", " + action2 + ", " + action3, ogp::planToStr(plan));
+
+  // Speculative planification of the next goal
+  {
+    auto problemWithSpeculation = initialProblem;
+    ogp::PlanStepGenerator planStepGeneratorWithSpeculation(problemWithSpeculation, domain, _now, nullptr, true);
+    std::list<ogp::ActionInvocationWithGoal> planWithSpeculation;
+    while (auto step = planStepGeneratorWithSpeculation.next())
+      planWithSpeculation.emplace_back(std::move(*step));
+    EXPECT_EQ(ogp::planToStr(plan), ogp::planToStr(planWithSpeculation));
+    EXPECT_EQ(1u, planStepGeneratorWithSpeculation.getNbOfSpeculationsUsed());
+  }
+  {
+    // The world changes after the first step, so the state predicted for the speculation is wrong
+    auto problemWithSpeculation = initialProblem;
+    ogp::PlanStepGenerator planStepGeneratorWithSpeculation(problemWithSpeculation, domain, _now, nullptr, true);
+    EXPECT_EQ(action1, planStepGeneratorWithSpeculation.next()->actionInvocation.toStr());
+    problemWithSpeculation.worldState.addFact(ogp::Fact("fact_c", false, ontology, entities, {}), problemWithSpeculation.goalStack,
+                                              _emptySetOfEvents, _emptyCallbacks, ontology, entities, _now);
+    EXPECT_EQ(action2, planStepGeneratorWithSpeculation.next()->actionInvocation.toStr());
+    EXPECT_FALSE(planStepGeneratorWithSpeculation.next());
+    EXPECT_EQ(0u, planStepGeneratorWithSpeculation.getNbOfSpeculationsUsed());
+  }
+}
+
+
+void _plannerSession()
+{
+  const std::string action1 = "action1";
+  const std::string action2 = "action2";
+  ogp::Ontology ontology;
+  ontology.predicates = ogp::SetOfPredicates::fromStr("fact_a\n"
+                                                      "fact_b\n"
+                                                      "fact_c\n"
+                                                      "fact_perceived", ontology.types);
+
+  std::map<std::string, ogp::Action> actions;
+  actions.emplace(action1, ogp::Action({}, ogp::strToWsModification("fact_a", ontology, {}, {})));
+  actions.emplace(action2, ogp::Action(ogp::strToCondition("fact_a", ontology, {}, {}),
+                                       ogp::strToWsModification("fact_b", ontology, {}, {})));
+  const ogp::Domain domain(std::move(actions), ontology);
+
+  ogp::Problem problem;
+  auto& entities = problem.entities;
+  _setGoalsForAPriority(problem, {ogp::Goal::fromStr("fact_b", ontology, entities)});
+
+  ogp::PlannerSession plannerSession(domain);
+  EXPECT_EQ(action1 + ", " + action2, ogp::planToStr(plannerSession.planForMoreImportantGoalPossible(problem, true, _now)));
+  EXPECT_FALSE(plannerSession.wasLastPlanReused());
+  EXPECT_EQ(std::vector<std::string>({"fact_b", "fact_a"}), plannerSession.relevantFactNames());
+
+  // A fact that the plan does not depend on
+  problem.worldState.addFact(ogp::Fact("fact_perceived", false, ontology, entities, {}), problem.goalStack,
+                             _emptySetOfEvents, _emptyCallbacks, ontology, entities, _now);
+  EXPECT_EQ(action1 + ", " + action2, ogp::planToStr(plannerSession.planForMoreImportantGoalPossible(problem, true, _now)));
+  EXPECT_TRUE(plannerSession.wasLastPlanReused());
+
+  // A fact that the plan depends on
+  problem.worldState.addFact(ogp::Fact("fact_a", false, ontology, entities, {}), problem.goalStack,
+                             _emptySetOfEvents, _emptyCallbacks, ontology, entities, _now);
+  EXPECT_EQ(action2, ogp::planToStr(plannerSession.planForMoreImportantGoalPossible(problem, true, _now)));
+  EXPECT_FALSE(plannerSession.wasLastPlanReused());
+  EXPECT_EQ(action2, ogp::planToStr(plannerSession.planForMoreImportantGoalPossible(problem, true, _now)));
+  EXPECT_TRUE(plannerSession.wasLastPlanReused());
+
+  // A change of the goals
+  _setGoalsForAPriority(problem, {ogp::Goal::fromStr("fact_c", ontology, entities)});
+  EXPECT_EQ("", ogp::planToStr(plannerSession.planForMoreImportantGoalPossible(problem, true, _now)));
+  EXPECT_FALSE(plannerSession.wasLastPlanReused());
+
+  plannerSession.reset();
+  EXPECT_EQ("", ogp::planToStr(plannerSession.planForMoreImportantGoalPossible(problem, true, _now)));
+  EXPECT_FALSE(plannerSession.wasLastPlanReused());
+
+  // A goal that expires because it is inactive for too long
+  auto now = std::make_unique<std::chrono::steady_clock::time_point>(std::chrono::steady_clock::now());
+  ogp::Problem problemWithExpiringGoal;
+  problemWithExpiringGoal.goalStack.pushBackGoal(ogp::Goal::fromStr("fact_b", ontology, entities), problemWithExpiringGoal.worldState, now, 10);
+  problemWithExpiringGoal.goalStack.pushBackGoal(ogp::Goal::fromStr("fact_c", ontology, entities, 5), problemWithExpiringGoal.worldState, now, 9);
+  EXPECT_EQ(action1 + ", " + action2, ogp::planToStr(plannerSession.planForMoreImportantGoalPossible(problemWithExpiringGoal, true, now)));
+  EXPECT_FALSE(plannerSession.wasLastPlanReused());
+  auto later = std::make_unique<std::chrono::steady_clock::time_point>(*now + std::chrono::seconds(3));
+  plannerSession.planForMoreImportantGoalPossible(problemWithExpiringGoal, true, later);
+  EXPECT_TRUE(plannerSession.wasLastPlanReused());
+  *later = *now + std::chrono::seconds(6);
+  EXPECT_EQ(action1 + ", " + action2, ogp::planToStr(plannerSession.planForMoreImportantGoalPossible(problemWithExpiringGoal, true, later)));
+  EXPECT_FALSE(plannerSession.wasLastPlanReused());
+  plannerSession.planForMoreImportantGoalPossible(problemWithExpiringGoal, true, later);
+  EXPECT_TRUE(plannerSession.wasLastPlanReused());
+}
+
+
+void _repairPlan()
+{
+  std::map<std::string, ogp::Domain> loadedDomains;
+  const auto domain = ogp::pddlToDomain(R"((define
+    (domain delivery)
+    (:requirements :strips :typing)
+    (:types
+        location robot - object
+        box - object
+    )
+    (:predicates
+        (at ?r - robot ?l - location)
+        (box_at ?b - box ?l - location)
+        (holding ?r - robot ?b - box)
+    )
+
+    (:action move
+        :parameters (?r - robot ?from - location ?to - location)
+        :precondition (at ?r ?from)
+        :effect (and (not (at ?r ?from)) (at ?r ?to))
+    )
+
+    (:action pick
+        :parameters (?r - robot ?b - box ?l - location)
+        :precondition (and (at ?r ?l) (box_at ?b ?l))
+        :effect (and (not (box_at ?b ?l)) (holding ?r ?b))
+    )
+))", loadedDomains);
+  loadedDomains.emplace(domain.getName(), domain);
+
+  auto domainAndProblem = ogp::pddlToProblem(R"((define
+    (problem deliver)
+    (:domain delivery)
+    (:objects
+        r1 - robot
+        b1 - box
+        l1 l2 l3 - location
+    )
+    (:init
+        (at r1 l1)
+        (box_at b1 l2)
+    )
+    (:goal (and (holding r1 b1) (at r1 l3)))
+))", loadedDomains);
+  const auto& problem = *domainAndProblem.problemPtr;
+  const auto& ontology = domain.getOntology();
+  auto modifyFacts = [&](ogp::Problem& pProblem, const std::string& pFacts) {
+    std::size_t pos = 0;
+    pProblem.worldState.modifyFactsFromPddl(pFacts, pos, pProblem.goalStack, domain.getSetOfEvents(),
+                                            _emptyCallbacks, ontology, pProblem.entities, _now);
+  };
+
+  auto problemForPreviousPlan = problem;
+  const auto previousPlan = ogp::planForEveryGoals(problemForPreviousPlan, domain, _now);
+  const std::string moveL1ToL2 = "move(?from -> l1, ?r -> r1, ?to -> l2)";
+  const std::string pickB1InL2 = "pick(?b -> b1, ?l -> l2, ?r -> r1)";
+  const std::string moveL2ToL3 = "move(?from -> l2, ?r -> r1, ?to -> l3)";
+  EXPECT_EQ(moveL1ToL2 + ", " + pickB1InL2 + ", " + moveL2ToL3, ogp::planToStr(previousPlan));
+
+  // Without change the previous plan is kept
+  {
+    auto problemToRepair = problem;
+    std::list<ogp::Goal> goalsDone;
+    EXPECT_EQ(ogp::planToStr(previousPlan), ogp::planToStr(ogp::repairPlan(problemToRepair, domain, previousPlan, _now, nullptr, &goalsDone)));
+    EXPECT_TRUE(problemToRepair.goalStack.goals().empty());
+    EXPECT_EQ(1u, goalsDone.size());
+  }
+
+  // The robot is already moved, the steps before the first still valid step are skipped
+  {
+    auto problemToRepair = problem;
+    modifyFacts(problemToRepair, "(not (at r1 l1)) (at r1 l2)");
+    EXPECT_EQ(pickB1InL2 + ", " + moveL2ToL3, ogp::planToStr(ogp::repairPlan(problemToRepair, domain, previousPlan, _now)));
+    EXPECT_TRUE(problemToRepair.goalStack.goals().empty());
+  }
+
+  // The robot is moved back after its first move, a bridge is planned to the next step
+  {
+    auto problemToRepair = problem;
+    auto remainingPlan = previousPlan;
+    remainingPlan.pop_front();
+    modifyFacts(problemToRepair, "(not (at r1 l1)) (at r1 l3)");
+    EXPECT_EQ("move(?from -> l3, ?r -> r1, ?to -> l2), " + pickB1InL2 + ", " + moveL2ToL3,
+              ogp::planToStr(ogp::repairPlan(problemToRepair, domain, remainingPlan, _now)));
+    EXPECT_TRUE(problemToRepair.goalStack.goals().empty());
+  }
+
+  // No bridge can be kept, so the plan is computed again from scratch
+  {
+    auto problemToRepair = problem;
+    modifyFacts(problemToRepair, "(not (box_at b1 l2)) (box_at b1 l3)");
+    auto problemForPlanFromScratch = problemToRepair;
+    const auto planFromScratch = ogp::planToStr(ogp::planForEveryGoals(problemForPlanFromScratch, domain, _now));
+    EXPECT_EQ("move(?from -> l1, ?r -> r1, ?to -> l3), pick(?b -> b1, ?l -> l3, ?r -> r1)", planFromScratch);
+    EXPECT_EQ(planFromScratch, ogp::planToStr(ogp::repairPlan(problemToRepair, domain, previousPlan, _now)));
+    EXPECT_TRUE(problemToRepair.goalStack.goals().empty());
+  }
+}
+
 }
 
 
@@ -693,4 +1178,12 @@ TEST(Planner, test_planner)
   _planToMove();
   _disjunctiveGoal();
   _disjunctivePrecondition();
+  _planBatch();
+  _planWithASubTypeEntity();
+  _planConcurrentlyWithTheSameDomain();
+  _historicalSnapshot();
+  _planAsync();
+  _planStepByStep();
+  _plannerSession();
+  _repairPlan();
 }
@@ -1,3 +1,4 @@
+#include <utility>
 #include <gtest/gtest.h>
 #include <orderedgoalsplanner/orderedgoalsplanner.hpp>
 #include <orderedgoalsplanner/types/axiom.hpp>
@@ -358,6 +359,34 @@ void _test_goalToStr()
   EXPECT_EQ("oneStepTowards(goal_name)", _goal("oneStepTowards(goal_name)", ontology).toStr());
 }
 
+void _test_goalCopiesShareTheirObjective()
+{
+  ogp::Ontology ontology;
+  ontology.predicates = ogp::SetOfPredicates::fromStr("a\n"
+                                                      "b", ontology.types);
+  auto goal = _goal("persist(a & b)", ontology);
+  ogp::Goal goalCopy(goal);
+  EXPECT_EQ(&std::as_const(goal).objective(), &std::as_const(goalCopy).objective());
+  EXPECT_EQ(&std::as_const(goal).objective(), &std::as_const(*goal.clone()).objective());
+  EXPECT_EQ(goal, goalCopy);
+
+  auto otherGoal = _goal("a", ontology);
+  otherGoal = goal;
+  EXPECT_EQ(&std::as_const(goal).objective(), &std::as_const(otherGoal).objective());
+
+  // Modifying the objective of a goal does not modify the copies of the goal
+  auto factGoal = _goal("a", ontology);
+  ogp::Goal factGoalCopy(factGoal);
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+  factGoalCopy.objective().fcFactPtr()->factOptional.isFactNegated = true;
+#pragma GCC diagnostic pop
+  EXPECT_NE(&std::as_const(factGoal).objective(), &std::as_const(factGoalCopy).objective());
+  EXPECT_FALSE(std::as_const(factGoal).objective().fcFactPtr()->factOptional.isFactNegated);
+  EXPECT_TRUE(std::as_const(factGoalCopy).objective().fcFactPtr()->factOptional.isFactNegated);
+  EXPECT_NE(factGoal, factGoalCopy);
+}
+
 void _test_factToStr()
 {
   ogp::Ontology ontology;
@@ -554,6 +583,74 @@ void _maxTimeToKeepInactiveEqualTo0UnderAnAlreadySatisfiedGoal()
   EXPECT_EQ(2u, goalStack.goals().size());
 }
 
+
+void _removeGoalsInactiveForTooLongFromTheirExpiry()
+{
+  ogp::Ontology ontology;
+  ontology.predicates = ogp::SetOfPredicates::fromStr(_fact_a + "\n" +
+                                                      _fact_b + "\n" +
+                                                      _fact_c, ontology.types);
+  ogp::GoalStack goalStack;
+  ogp::WorldState worldState;
+  auto now = std::make_unique<std::chrono::steady_clock::time_point>(std::chrono::steady_clock::now());
+  goalStack.pushBackGoal(_goal(_fact_a, ontology), worldState, now, 10);
+  EXPECT_FALSE(goalStack.nextExpiry());
+  goalStack.pushBackGoal(_goal(_fact_b, ontology, 5), worldState, now, 9);
+  goalStack.pushBackGoal(_goal(_fact_c, ontology, 10), worldState, now, 9);
+  ASSERT_TRUE(goalStack.nextExpiry());
+  EXPECT_EQ(*now + std::chrono::seconds(6), *goalStack.nextExpiry());
+
+  auto later = std::make_unique<std::chrono::steady_clock::time_point>(*now + std::chrono::seconds(5));
+  EXPECT_FALSE(goalStack.removeGoalsInactiveForTooLong(worldState, later));
+  EXPECT_EQ(2u, goalStack.goals().find(9)->second.size());
+
+  *later = *now + std::chrono::seconds(6);
+  EXPECT_TRUE(goalStack.removeGoalsInactiveForTooLong(worldState, later));
+  ASSERT_EQ(1u, goalStack.goals().find(9)->second.size());
+  EXPECT_EQ(_fact_c, goalStack.goals().find(9)->second.front().toStr());
+  EXPECT_EQ(*now + std::chrono::seconds(11), *goalStack.nextExpiry());
+
+  // The active goal is never removed because of inactivity
+  *later = *now + std::chrono::seconds(100);
+  EXPECT_TRUE(goalStack.removeGoalsInactiveForTooLong(worldState, later));
+  EXPECT_EQ(1u, goalStack.goals().size());
+  EXPECT_EQ(1u, goalStack.goals().count(10));
+  EXPECT_FALSE(goalStack.nextExpiry());
+}
+
+void _removeGoalsInactiveForTooLongAfterAChangeOfTheWorld()
+{
+  ogp::Ontology ontology;
+  ontology.predicates = ogp::SetOfPredicates::fromStr(_fact_a + "\n" +
+                                                      _fact_b + "\n" +
+                                                      _fact_c + "\n" +
+                                                      _fact_d, ontology.types);
+  ogp::GoalStack goalStack;
+  ogp::WorldState worldState;
+  auto now = std::make_unique<std::chrono::steady_clock::time_point>(std::chrono::steady_clock::now());
+  goalStack.pushBackGoal(_goal(_fact_a, ontology), worldState, now, 10);
+  goalStack.pushBackGoal(_goal(_fact_b, ontology, 5), worldState, now, 9);
+  goalStack.pushBackGoal(_goal(_fact_c, ontology, 10), worldState, now, 9);
+
+  // The world changes without notifying this goal stack, so the goal of fact_b becomes the active goal
+  ogp::GoalStack otherGoalStack;
+  std::map<ogp::SetOfEventsId, ogp::SetOfEvents> setOfEvents;
+  worldState.addFact(_fact(_fact_a, ontology), otherGoalStack, setOfEvents, _emptyCallbacks, ontology, {}, now);
+  auto later = std::make_unique<std::chrono::steady_clock::time_point>(*now + std::chrono::seconds(6));
+  EXPECT_FALSE(goalStack.removeGoalsInactiveForTooLong(worldState, later));
+  EXPECT_EQ(2u, goalStack.goals().find(9)->second.size());
+  EXPECT_EQ(*now + std::chrono::seconds(11), *goalStack.nextExpiry());
+
+  // A goal added in front of the expired goals does not change which goals are removed
+  goalStack.pushFrontGoal(_goal(_fact_d, ontology), worldState, {}, 9);
+  EXPECT_EQ(3u, goalStack.goals().find(9)->second.size());
+  *later = *now + std::chrono::seconds(11);
+  EXPECT_TRUE(goalStack.removeGoalsInactiveForTooLong(worldState, later));
+  ASSERT_EQ(1u, goalStack.goals().find(9)->second.size());
+  EXPECT_EQ(_fact_d, goalStack.goals().find(9)->second.front().toStr());
+  EXPECT_FALSE(goalStack.nextExpiry());
+}
+
 void _noPreconditionGoalImmediatlyReached()
 {
   ogp::Ontology ontology;
@@ -4031,6 +4128,7 @@ TEST(Planner, test_planWithSingleType)
 {
   _test_createEmptyGoal();
   _test_goalToStr();
+  _test_goalCopiesShareTheirObjective();
   _test_factToStr();
   _test_conditionParameters();
   _test_wsModificationToStr();
@@ -4038,6 +4136,8 @@ TEST(Planner, test_planWithSingleType)
   _test_checkCondition();
   _automaticallyRemoveGoalsWithAMaxTimeToKeepInactiveEqualTo0();
   _maxTimeToKeepInactiveEqualTo0UnderAnAlreadySatisfiedGoal();
+  _removeGoalsInactiveForTooLongFromTheirExpiry();
+  _removeGoalsInactiveForTooLongAfterAChangeOfTheWorld();
   _noPreconditionGoalImmediatlyReached();
   _removeGoalWhenItIsSatisfiedByAnAction();
   _removeAnAction();
@@ -0,0 +1,100 @@
+#include <sstream>
+#include <gtest/gtest.h>
+#include <orderedgoalsplanner/types/domain.hpp>
+#include <orderedgoalsplanner/util/serializer/deserializefrompddl.hpp>
+#include <plannerserver.hpp>
+
+namespace
+{
+
+std::string _frame(const std::string& pName,
+                   const std::string& pPayload = "")
+{
+  return pName + " " + std::to_string(pPayload.size()) + "\n" + pPayload;
+}
+
+}
+
+
+TEST(Tool, test_plannerServer)
+{
+  std::map<std::string, ogp::Domain> loadedDomains;
+  auto domain = ogp::pddlToDomain(R"((define
+    (domain moving)
+    (:requirements :strips :typing)
+    (:types location)
+    (:predicates (at ?l - location))
+
+    (:action move
+        :parameters (?from - location ?to - location)
+        :precondition (at ?from)
+        :effect (and (not (at ?from)) (at ?to))
+    )
+))", loadedDomains);
+  loadedDomains.emplace(domain.getName(), domain);
+
+  std::stringstream input;
+  input << _frame("plan")
+        << _frame("problem", R"((define
+    (problem p)
+    (:domain moving)
+    (:objects
+        kitchen bedroom - location
+    )
+    (:init
+        (at kitchen)
+    )
+    (:goal (at bedroom))
+))")
+        << _frame("plan")
+        << _frame("plan")
+        << _frame("init", "(not (at kitchen)) (at bedroom)")
+        << _frame("goal", "(at kitchen)")
+        << _frame("plan")
+        << _frame("unknown_request")
+        << _frame("quit")
+        << _frame("plan");
+
+  std::ostringstream output;
+  ogp::servePlanner(input, output, loadedDomains);
+  EXPECT_EQ(_frame("error", "No problem loaded, a \"problem\" request is expected first") +
+            _frame("ok") +
+            _frame("ok", "00: (move kitchen bedroom) [1]\n") +
+            _frame("ok", "00: (move kitchen bedroom) [1]\n") + // The problem is not modified by the planification
+            _frame("ok") +
+            _frame("ok") +
+            _frame("ok", "00: (move bedroom kitchen) [1]\n") +
+            _frame("error", "Unknown request: \"unknown_request\"") +
+            _frame("ok"), output.str());
+
+  std::stringstream invalidInitInput;
+  invalidInitInput << _frame("problem", R"((define
+    (problem p)
+    (:domain moving)
+    (:objects
+        kitchen bedroom - location
+    )
+    (:init
+        (at kitchen)
+    )
+    (:goal (at bedroom))
+))")
+                   << _frame("init", "(not (at kitchen)) (at garage)")
+                   << _frame("init", "(not (at kitchen)) )")
+                   << _frame("plan");
+  std::ostringstream invalidInitOutput;
+  ogp::servePlanner(invalidInitInput, invalidInitOutput, loadedDomains);
+  // The facts are not applied if one of them is invalid, so the kitchen is still the start of the plan
+  const std::string invalidInitOutputStr = invalidInitOutput.str();
+  const std::string expectedEnd = _frame("error", "Unexpected content after the facts: \")\"") +
+      _frame("ok", "00: (move kitchen bedroom) [1]\n");
+  EXPECT_EQ(0u, invalidInitOutputStr.find(_frame("ok") + "error "));
+  ASSERT_LE(expectedEnd.size(), invalidInitOutputStr.size());
+  EXPECT_EQ(expectedEnd, invalidInitOutputStr.substr(invalidInitOutputStr.size() - expectedEnd.size()));
+
+  std::stringstream truncatedInput;
+  truncatedInput << "plan 10\nabc";
+  std::ostringstream truncatedOutput;
+  ogp::servePlanner(truncatedInput, truncatedOutput, loadedDomains);
+  EXPECT_EQ(_frame("error", "The payload of the frame \"plan\" is truncated"), truncatedOutput.str());
+}
@@ -1,3 +1,4 @@
+#include <memory>
 #include <gtest/gtest.h>
 #include <orderedgoalsplanner/types/fact.hpp>
 #include <orderedgoalsplanner/types/setoffacts.hpp>
@@ -88,3 +89,43 @@ TEST(Tool, test_setOfFacts)
     EXPECT_EQ("[]", factToFacts.find(factWithParam, true).toStr());
   }
 }
+
+
+TEST(Tool, test_setOfFactsEraseFromAPattern)
+{
+  ogp::Ontology ontology;
+  ontology.types = ogp::SetOfTypes::fromPddl("my_type my_type2");
+  ontology.constants = ogp::SetOfEntities::fromPddl("toto toto2 - my_type\n"
+                                                  "titi titi2 - my_type2", ontology.types);
+  ontology.predicates = ogp::SetOfPredicates::fromStr("pred_name(?p1 - my_type) - my_type2", ontology.types);
+
+  SetOfFacts factToFacts;
+  factToFacts.add(ogp::Fact::fromStr("pred_name(toto)=titi", ontology, {}, {}));
+  factToFacts.add(ogp::Fact::fromStr("pred_name(toto2)=titi2", ontology, {}, {}));
+
+  {
+    // A copy finds its own facts, even when the original set is modified and destroyed
+    auto setOfFactsCopiedPtr = std::make_unique<SetOfFacts>(factToFacts);
+    SetOfFacts setOfFactsCopied = *setOfFactsCopiedPtr;
+    setOfFactsCopiedPtr->erase(ogp::Fact::fromStr("pred_name(toto)=titi", ontology, {}, {}));
+    setOfFactsCopiedPtr.reset();
+    EXPECT_EQ("[pred_name(toto)=titi, pred_name(toto2)=titi2]",
+              setOfFactsCopied.find(ogp::Fact::fromStr("pred_name(?p1)=*", ontology, {},
+                                                       {ogp::Parameter::fromStr("?p1 - my_type", ontology.types)})).toStr());
+    setOfFactsCopied = factToFacts;
+    setOfFactsCopied.add(ogp::Fact::fromStr("pred_name(toto)=titi", ontology, {}, {}));
+    EXPECT_TRUE(setOfFactsCopied.erase(ogp::Fact::fromStr("pred_name(toto)=titi", ontology, {}, {})));
+    EXPECT_EQ("[pred_name(toto2)=titi2]",
+              setOfFactsCopied.find(ogp::Fact::fromStr("pred_name(?p1)=*", ontology, {},
+                                                       {ogp::Parameter::fromStr("?p1 - my_type", ontology.types)})).toStr());
+  }
+
+  // The fact to erase is only known from the result of a search in the set
+  EXPECT_TRUE(factToFacts.erase(ogp::Fact::fromStr("pred_name(toto)=*", ontology, {}, {})));
+  auto factWithAnyValue = ogp::Fact::fromStr("pred_name(toto)=*", ontology, {}, {});
+  EXPECT_EQ("[]", factToFacts.find(factWithAnyValue).toStr());
+  EXPECT_EQ("[pred_name(toto2)=titi2]", factToFacts.find(ogp::Fact::fromStr("pred_name(toto2)=*", ontology, {}, {})).toStr());
+
+  EXPECT_TRUE(factToFacts.erase(ogp::Fact::fromStr("pred_name(toto2)=*", ontology, {}, {})));
+  EXPECT_TRUE(factToFacts.facts().empty());
+}
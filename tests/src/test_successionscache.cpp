@@ -2,8 +2,10 @@
 #include <orderedgoalsplanner/types/action.hpp>
 #include <orderedgoalsplanner/types/domain.hpp>
 #include <orderedgoalsplanner/types/ontology.hpp>
+#include <orderedgoalsplanner/types/setofevents.hpp>
 #include <orderedgoalsplanner/types/setoffacts.hpp>
 #include <orderedgoalsplanner/util/serializer/deserializefrompddl.hpp>
+#include <orderedgoalsplanner/util/util.hpp>
 
 
 using namespace ogp;
@@ -11,6 +13,29 @@ using namespace ogp;
 namespace
 {
 
+void _expectSameSuccessionsAndPredecessors(const Domain& pExpectedDomain,
+                                           const Domain& pDomain)
+{
+  EXPECT_EQ(pExpectedDomain.printSuccessionCache(), pDomain.printSuccessionCache());
+  for (const auto& currAction : pExpectedDomain.actions())
+  {
+    const auto& action = pDomain.actions().at(currAction.first);
+    EXPECT_EQ(currAction.second.actionsPredecessorsCache, action.actionsPredecessorsCache);
+    EXPECT_EQ(currAction.second.eventsPredecessorsCache, action.eventsPredecessorsCache);
+    EXPECT_EQ(currAction.second.indexInDomainCache, action.indexInDomainCache);
+  }
+  for (const auto& currSetOfEvents : pExpectedDomain.getSetOfEvents())
+  {
+    for (const auto& currEvent : currSetOfEvents.second.events())
+    {
+      const auto& event = pDomain.getSetOfEvents().at(currSetOfEvents.first).events().at(currEvent.first);
+      EXPECT_EQ(currEvent.second.actionsPredecessorsCache, event.actionsPredecessorsCache);
+      EXPECT_EQ(currEvent.second.eventsPredecessorsCache, event.eventsPredecessorsCache);
+    }
+  }
+}
+
+
 void _test_actionSuccessions()
 {
   const std::string action1 = "action1";
@@ -109,6 +134,27 @@ void _test_actionSuccessions()
             "\n"
             "not action: action3\n"
             "not action: action5\n", domain.printSuccessionCache());
+
+  // Removing actions gives the same caches as a domain built without them
+  auto actionsWithoutAction2And5 = actions;
+  actionsWithoutAction2And5.erase(action2);
+  actionsWithoutAction2And5.erase(action5);
+  Domain domainWithoutAction2And5(actionsWithoutAction2And5, ontology);
+  domain.removeActions({action2, action5, "unknown_action"});
+  EXPECT_EQ(domainWithoutAction2And5.printSuccessionCache(), domain.printSuccessionCache());
+  for (const auto& currAction : domainWithoutAction2And5.actions())
+  {
+    const auto& action = domain.actions().at(currAction.first);
+    EXPECT_EQ(currAction.second.actionsPredecessorsCache, action.actionsPredecessorsCache);
+    EXPECT_EQ(currAction.second.indexInDomainCache, action.indexInDomainCache);
+  }
+
+  // Adding them back gives the initial caches
+  domain.addActions({{action2, actions.at(action2)}, {action5, actions.at(action5)}});
+  _expectSameSuccessionsAndPredecessors(Domain(actions, ontology), domain);
+  domain.removeAction(action1);
+  domain.addAction(action1, actions.at(action1));
+  _expectSameSuccessionsAndPredecessors(Domain(actions, ontology), domain);
 }
 
 
@@ -270,6 +316,67 @@ void _test_implySuccessions()
 }
 
 
+
+
+void _test_parallelSuccessions()
+{
+  const std::size_t nbOfFacts = 64;
+  ogp::Ontology ontology;
+  ontology.types = ogp::SetOfTypes::fromPddl("entity");
+  std::string predicatesStr;
+  for (std::size_t i = 0; i < nbOfFacts; ++i)
+    predicatesStr += "fact_" + std::to_string(i) + "(?e - entity)\n";
+  ontology.predicates = ogp::SetOfPredicates::fromStr(predicatesStr, ontology.types);
+  auto factStr = [&](std::size_t pIndex) { return "fact_" + std::to_string(pIndex % nbOfFacts) + "(?e)"; };
+
+  std::map<std::string, ogp::Action> actions;
+  for (std::size_t i = 0; i < nbOfFacts; ++i)
+  {
+    std::vector<ogp::Parameter> parameters(1, ogp::Parameter::fromStr("?e - entity", ontology.types));
+    ogp::Action action(ogp::strToCondition(factStr(i) + " & not(" + factStr(i + 7) + ")", ontology, {}, parameters),
+                       ogp::strToWsModification(factStr(i + 1) + " & not(" + factStr(3 * i) + ")", ontology, {}, parameters));
+    action.parameters = std::move(parameters);
+    actions.emplace("action" + std::to_string(i), std::move(action));
+  }
+
+  ogp::SetOfEvents setOfEvents;
+  for (std::size_t i = 0; i < nbOfFacts; i += 2)
+  {
+    std::vector<ogp::Parameter> parameters(1, ogp::Parameter::fromStr("?e - entity", ontology.types));
+    ogp::Event event(ogp::strToCondition(factStr(i + 5), ontology, {}, parameters),
+                     ogp::strToWsModification(factStr(i + 11), ontology, {}, parameters),
+                     parameters);
+    setOfEvents.add(event, "event" + std::to_string(i));
+  }
+
+  std::vector<ogp::Parameter> newActionParameters(1, ogp::Parameter::fromStr("?e - entity", ontology.types));
+  ogp::Action newAction(ogp::strToCondition(factStr(2), ontology, {}, newActionParameters),
+                        ogp::strToWsModification(factStr(40), ontology, {}, newActionParameters));
+  newAction.parameters = std::move(newActionParameters);
+
+  auto getSuccessionCaches = [&](std::size_t pMaxNbOfThreads)
+  {
+    ogp::setMaxNbOfThreads(pMaxNbOfThreads);
+    Domain domain(actions, ontology, setOfEvents);
+    auto res = domain.printSuccessionCache();
+    domain.addAction("newAction", newAction);
+    res += "\n\n" + domain.printSuccessionCache();
+    // Adding an action updates the caches as if the domain was built with it
+    auto allActions = actions;
+    allActions.emplace("newAction", newAction);
+    _expectSameSuccessionsAndPredecessors(Domain(allActions, ontology, setOfEvents), domain);
+    ogp::setMaxNbOfThreads(0);
+    return res;
+  };
+
+  const auto sequentialRes = getSuccessionCaches(1);
+  EXPECT_NE(std::string::npos, sequentialRes.find("action: newAction"));
+  EXPECT_NE(std::string::npos, sequentialRes.find("event: soe_from_constructor|event"));
+  // 4 threads, even on a machine with less cores, to really execute the parallel computation
+  EXPECT_EQ(sequentialRes, getSuccessionCaches(4));
+}
+
+
 }
 
 
@@ -279,4 +386,5 @@ TEST(Tool, test_successionsCache)
   _test_notActionSuccessions();
   _test_impossibleSuccessions();
   _test_implySuccessions();
+  _test_parallelSuccessions();
 }
@@ -1,4 +1,6 @@
 #include <gtest/gtest.h>
+#include <unordered_set>
+#include <orderedgoalsplanner/types/actioninvocation.hpp>
 #include <orderedgoalsplanner/types/entity.hpp>
 #include <orderedgoalsplanner/types/parameter.hpp>
 #include <orderedgoalsplanner/util/util.hpp>
@@ -83,9 +85,66 @@ void test_autoIncrementOfVersion()
   EXPECT_EQ("didi", incrementAddIdAndReturnValue("didi"));
 }
 
+void test_actionInvocationHash()
+{
+  ogp::ActionInvocation actionInvocation1("action", {{_parameter("?a"), _entity("b")}});
+  ogp::ActionInvocation actionInvocation2("action", {{_parameter("?a"), _entity("b")}});
+  ogp::ActionInvocation actionInvocation3("action", {{_parameter("?a"), _entity("c")}});
+  ogp::ActionInvocation actionInvocation4("otherAction", {{_parameter("?a"), _entity("b")}});
+  EXPECT_EQ(actionInvocation1, actionInvocation2);
+  EXPECT_EQ(actionInvocation1.hash(), actionInvocation2.hash());
+  EXPECT_NE(actionInvocation1, actionInvocation3);
+  EXPECT_NE(actionInvocation1, actionInvocation4);
+
+  std::unordered_set<ogp::ActionInvocation> actionInvocations;
+  EXPECT_TRUE(actionInvocations.insert(actionInvocation1).second);
+  EXPECT_FALSE(actionInvocations.insert(actionInvocation2).second);
+  EXPECT_TRUE(actionInvocations.insert(actionInvocation3).second);
+  EXPECT_TRUE(actionInvocations.insert(actionInvocation4).second);
+  EXPECT_EQ(3u, actionInvocations.size());
+}
+
+void test_numberEntities()
+{
+  auto nb1 = ogp::Entity::createNumberEntity("3");
+  auto nb2 = ogp::Entity::createNumberEntity("2.5");
+  ASSERT_TRUE(nb1.number);
+  ASSERT_TRUE(nb2.number);
+  EXPECT_EQ(ogp::Number(3), *nb1.number);
+  EXPECT_EQ(ogp::Number(2.5f), *nb2.number);
+  EXPECT_FALSE(_entity("3").number);
+
+  auto sum = ogp::plusIntOrStr(nb1, nb1);
+  ASSERT_TRUE(sum && sum->number);
+  EXPECT_EQ("6", sum->value);
+  EXPECT_EQ(ogp::Number(6), *sum->number);
+  EXPECT_EQ(sum->value, ogp::Entity::createNumberEntity(*sum->number).value);
+  EXPECT_EQ("0.500000", ogp::minusIntOrStr(nb1, nb2)->value);
+  EXPECT_EQ("7.500000", ogp::multiplyNbOrStr(nb1, nb2)->value);
+
+  EXPECT_TRUE(ogp::compIntNb(nb1, 2, true, false));
+  EXPECT_FALSE(ogp::compIntNb(nb1, 3, true, false));
+  EXPECT_TRUE(ogp::compIntNb(nb1, 3, true, true));
+  EXPECT_TRUE(ogp::compIntNb(nb1, 4, false, false));
+
+  // The numbers are parsed and written without depending on the locale
+  EXPECT_TRUE(std::holds_alternative<int>(ogp::stringToNumber("-12")));
+  EXPECT_EQ(ogp::Number(-12), ogp::stringToNumber("-12"));
+  EXPECT_EQ(ogp::Number(4), ogp::stringToNumber("+4"));
+  EXPECT_TRUE(std::holds_alternative<float>(ogp::stringToNumber("-2.25")));
+  EXPECT_EQ(ogp::Number(-2.25f), ogp::stringToNumber("-2.25"));
+  EXPECT_TRUE(std::holds_alternative<float>(ogp::stringToNumber("3000000000")));
+  EXPECT_THROW(ogp::stringToNumber("2,5"), std::invalid_argument);
+  EXPECT_EQ("-12", ogp::numberToString(-12));
+  EXPECT_EQ("-2.250000", ogp::numberToString(-2.25f));
+  EXPECT_EQ("0.100000", ogp::numberToString(0.1f));
+}
+
 
 TEST(Tool, test_util)
 {
   test_unfoldMapWithSet();
   test_autoIncrementOfVersion();
+  test_actionInvocationHash();
+  test_numberEntities();
 }
@@ -1,10 +1,12 @@
 #include <gtest/gtest.h>
+#include <orderedgoalsplanner/types/goal.hpp>
 #include <orderedgoalsplanner/types/goalstack.hpp>
 #include <orderedgoalsplanner/types/ontology.hpp>
 #include <orderedgoalsplanner/types/setofcallbacks.hpp>
 #include <orderedgoalsplanner/types/setofevents.hpp>
 #include <orderedgoalsplanner/types/setofpredicates.hpp>
 #include <orderedgoalsplanner/types/worldstate.hpp>
+#include <orderedgoalsplanner/util/serializer/deserializefrompddl.hpp>
 
 using namespace ogp;
 
@@ -60,4 +62,50 @@ TEST(Tool, test_wordstate)
   EXPECT_EQ("(pred_a ent_a)\n(pred_b)", worldstate.factsMapping().toPddl(0, true));
   _modifyFactsFromPddl(worldstate, "(= (pred_e ent_b) undefined)", ontology, entities);
   EXPECT_EQ("(pred_a ent_a)\n(pred_b)", worldstate.factsMapping().toPddl(0, true));
+
+  // Goal satisfaction is only evaluated again when a watched fact changed
+  auto goal = ogp::Goal::fromStr("pred_a(toto)", ontology, entities);
+  auto predAVersion = worldstate.factsMapping().getFactNameVersion("pred_a");
+  EXPECT_NE(0u, predAVersion);
+  EXPECT_EQ(0u, worldstate.factsMapping().getFactNameVersion("pred_c"));
+  EXPECT_FALSE(worldstate.isGoalSatisfied(goal));
+  _modifyFactsFromPddl(worldstate, "(pred_b)", ontology, entities);
+  EXPECT_EQ(predAVersion, worldstate.factsMapping().getFactNameVersion("pred_a"));
+  EXPECT_FALSE(worldstate.isGoalSatisfied(goal));
+  _modifyFactsFromPddl(worldstate, "(pred_a toto)", ontology, entities);
+  EXPECT_NE(predAVersion, worldstate.factsMapping().getFactNameVersion("pred_a"));
+  EXPECT_TRUE(worldstate.isGoalSatisfied(goal));
+
+  // The cache stays valid for a copy of the goal and for another world state
+  auto goalCopy = goal;
+  ogp::WorldState otherWorldstate;
+  EXPECT_TRUE(worldstate.isGoalSatisfied(goalCopy));
+  EXPECT_FALSE(otherWorldstate.isGoalSatisfied(goalCopy));
+  _modifyFactsFromPddl(worldstate, "(not (pred_a toto))", ontology, entities);
+  EXPECT_FALSE(worldstate.isGoalSatisfied(goal));
+
+  // A copy of the world state gives other versions to its modifications
+  auto worldstateCopy = worldstate;
+  _modifyFactsFromPddl(worldstate, "(pred_a titi)", ontology, entities);
+  _modifyFactsFromPddl(worldstateCopy, "(pred_a toto)", ontology, entities);
+  EXPECT_NE(worldstate.factsMapping().getFactNameVersion("pred_a"), worldstateCopy.factsMapping().getFactNameVersion("pred_a"));
+  EXPECT_FALSE(worldstate.isGoalSatisfied(goal));
+  EXPECT_TRUE(worldstateCopy.isGoalSatisfied(goal));
+  EXPECT_FALSE(worldstate.isGoalSatisfied(goal));
+  _modifyFactsFromPddl(worldstate, "(not (pred_a titi))", ontology, entities);
+
+  // An effect with parameters is applied without being copied
+  std::vector<ogp::Parameter> effectParameters{ogp::Parameter::fromStr("?x - entity", ontology.types),
+                                               ogp::Parameter::fromStr("?y - type1", ontology.types)};
+  auto effect = ogp::strToWsModification("pred_a(?x) & assign(pred_e(?x), ?y) & forall(?t - type1, pred_c(?t), !pred_a(?t))",
+                                         ontology, entities, effectParameters);
+  const auto effectStr = effect->toStr();
+  _modifyFactsFromPddl(worldstate, "(pred_c toto)\n(pred_a toto)", ontology, entities);
+  bool goalChanged = false;
+  GoalStack goalStack;
+  worldstate.applyEffect({{effectParameters[0], ogp::Entity("ent_b", ontology.types.nameToType("entity"))},
+                          {effectParameters[1], ogp::Entity("toto", ontology.types.nameToType("type1"))}},
+                         effect, goalChanged, goalStack, {}, {}, ontology, entities, {});
+  EXPECT_EQ("(pred_a ent_a)\n(pred_a ent_b)\n(pred_b)\n(pred_c toto)\n(= (pred_e ent_b) toto)", worldstate.factsMapping().toPddl(0, true));
+  EXPECT_EQ(effectStr, effect->toStr());
 }